@@ -1,17 +1,17 @@
 #include "../inc/AVLTree.hpp"
 #include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include <thread>
 
-template <typename T>
-class BinaryTree;
-
-template <typename T>
-int AVLTree<T>::getHeight(TreeNode<T> *node) const
+template <typename T, typename Allocator>
+int AVLTree<T, Allocator>::getHeight(TreeNode<T> *node) const
 {
     return node ? node->getHeight() : -1;
 }
 
-template <typename T>
-int AVLTree<T>::getBalance(TreeNode<T> *node) const
+template <typename T, typename Allocator>
+int AVLTree<T, Allocator>::getBalance(TreeNode<T> *node) const
 {
     if (!node)
     {
@@ -20,188 +20,722 @@ int AVLTree<T>::getBalance(TreeNode<T> *node) const
     return getHeight(node->getLeft()) - getHeight(node->getRight());
 }
 
-template <typename T>
-TreeNode<T> *AVLTree<T>::rotateLeft(TreeNode<T> *x)
+template <typename T, typename Allocator>
+TreeNode<T> *AVLTree<T, Allocator>::rotateLeftRight(TreeNode<T> *node)
+{
+    if (!node || !node->getLeft())
+        return node;
+    node->linkLeft(rotateLeft(node->getLeft()));
+    return rotateRight(node);
+}
+
+template <typename T, typename Allocator>
+TreeNode<T> *AVLTree<T, Allocator>::rotateRightLeft(TreeNode<T> *node)
+{
+    if (!node || !node->getRight())
+        return node;
+    node->linkRight(rotateRight(node->getRight()));
+    return rotateLeft(node);
+}
+
+template <typename T, typename Allocator>
+TreeNode<T> *AVLTree<T, Allocator>::rebalance(TreeNode<T> *node)
+{
+    int balance = getBalance(node);
+    if (balance > 1)
+    {
+        return getBalance(node->getLeft()) < 0 ? rotateLeftRight(node) : rotateRight(node);
+    }
+    if (balance < -1)
+    {
+        return getBalance(node->getRight()) > 0 ? rotateRightLeft(node) : rotateLeft(node);
+    }
+    return node;
+}
+
+template <typename T, typename Allocator>
+void AVLTree<T, Allocator>::retrace(std::vector<TreeNode<T> *> &path, bool grew)
 {
-    TreeNode<T> *y = x->getRight();
-    TreeNode<T> *T2 = y->getLeft();
+    bool heightsChanging = true;
+    for (size_t i = path.size(); i-- > 0;)
+    {
+        TreeNode<T> *node = path[i];
+        if (!heightsChanging)
+        {
+            node->setSize(grew ? node->getSize() + 1 : node->getSize() - 1);
+            continue;
+        }
+
+        int oldHeight = node->getHeight();
+        node->update();
+        TreeNode<T> *top = rebalance(node);
+        if (top != node)
+        {
+            replaceChild(i > 0 ? path[i - 1] : nullptr, node, top);
+        }
+        heightsChanging = top->getHeight() != oldHeight;
+    }
+}
 
-    y->setLeft(x);
-    x->setRight(T2);
+template <typename T, typename Allocator>
+void AVLTree<T, Allocator>::insert(const T &value)
+{
+    this->removeThreads();
 
-    x->setHeight(1 + std::max(getHeight(x->getLeft()), getHeight(x->getRight())));
-    y->setHeight(1 + std::max(getHeight(y->getLeft()), getHeight(y->getRight())));
+    std::vector<TreeNode<T> *> &path = pathBuffer();
+    TreeNode<T> *node = this->root;
+    while (node)
+    {
+        path.push_back(node);
+        if (value < node->getData())
+        {
+            node = node->getLeft();
+        }
+        else if (value > node->getData())
+        {
+            node = node->getRight();
+        }
+        else
+        {
+            return;
+        }
+    }
 
-    return y;
+    TreeNode<T> *leaf = this->nodeAllocator.create(value);
+    if (path.empty())
+    {
+        updateRoot(leaf);
+        return;
+    }
+    if (value < path.back()->getData())
+    {
+        path.back()->linkLeft(leaf);
+    }
+    else
+    {
+        path.back()->linkRight(leaf);
+    }
+    retrace(path, true);
 }
 
-template <typename T>
-TreeNode<T> *AVLTree<T>::rotateRight(TreeNode<T> *y)
+template <typename T, typename Allocator>
+void AVLTree<T, Allocator>::remove(const T &value)
 {
-    TreeNode<T> *x = y->getLeft();
-    TreeNode<T> *T2 = x->getRight();
+    this->removeThreads();
 
-    x->setRight(y);
-    y->setLeft(T2);
+    std::vector<TreeNode<T> *> &path = pathBuffer();
+    TreeNode<T> *node = this->root;
+    while (node)
+    {
+        if (value < node->getData())
+        {
+            path.push_back(node);
+            node = node->getLeft();
+        }
+        else if (value > node->getData())
+        {
+            path.push_back(node);
+            node = node->getRight();
+        }
+        else
+        {
+            break;
+        }
+    }
+    if (!node)
+    {
+        return;
+    }
 
-    y->setHeight(1 + std::max(getHeight(y->getLeft()), getHeight(y->getRight())));
-    x->setHeight(1 + std::max(getHeight(x->getLeft()), getHeight(x->getRight())));
+    // A node with two children takes its successor's key, and the successor (which has
+    // no left child) is unlinked instead
+    TreeNode<T> *victim = node;
+    if (node->getLeft() && node->getRight())
+    {
+        path.push_back(node);
+        victim = node->getRight();
+        while (victim->getLeft())
+        {
+            path.push_back(victim);
+            victim = victim->getLeft();
+        }
+        node->setData(victim->getData());
+    }
 
-    return x;
+    replaceChild(path.empty() ? nullptr : path.back(), victim,
+                 victim->getLeft() ? victim->getLeft() : victim->getRight());
+    this->nodeAllocator.retire(victim);
+    retrace(path, false);
 }
 
-template <typename T>
-TreeNode<T> *AVLTree<T>::rotateLeftRight(TreeNode<T> *node)
+template <typename T, typename Allocator>
+BinaryTree<T, Allocator> *AVLTree<T, Allocator>::mergeImmutable(const BinaryTree<T, Allocator> &other) const
 {
-    if (!node || !node->getLeft())
-        return node;
-    node->setLeft(rotateLeft(node->getLeft()));
-    return rotateRight(node);
+    AVLTree<T, Allocator> *result = new AVLTree<T, Allocator>(*this);
+    result->merge(other);
+    return result;
 }
 
-template <typename T>
-TreeNode<T> *AVLTree<T>::rotateRightLeft(TreeNode<T> *node)
+template <typename T, typename Allocator>
+template <typename InputIt>
+size_t AVLTree<T, Allocator>::bulkLoad(InputIt first, InputIt last)
 {
-    if (!node || !node->getRight())
-        return node;
-    node->setRight(rotateRight(node->getRight()));
-    return rotateLeft(node);
+    std::vector<T> values(first, last);
+    size_t duplicates = sortUnique(values);
+
+    // A midpoint split of a sorted sequence is perfectly balanced, so it is a valid
+    // AVL tree; setLeft/setRight fill in the heights bottom-up
+    this->clear();
+    this->root = this->buildBalancedTreeFromValues(values, 0, static_cast<int>(values.size()) - 1);
+    return duplicates;
 }
 
-template <typename T>
-TreeNode<T> *AVLTree<T>::insert(TreeNode<T> *node, const T &value)
+template <typename T, typename Allocator>
+template <typename InputIt>
+size_t AVLTree<T, Allocator>::insertBatch(InputIt first, InputIt last)
 {
-    if (!node)
+    std::vector<T> values(first, last);
+    sortUnique(values);
+    size_t before = size();
+
+    this->removeThreads();
+    if (values.size() * batchFallbackRatio < before)
     {
-        return new TreeNode<T>(value);
+        // Sorted keys walk neighbouring paths, so most of each descent is still cached
+        for (const T &value : values)
+        {
+            insert(value);
+        }
+        return size() - before;
     }
 
-    if (value < node->getData())
+    TreeNode<T> *batch = this->buildBalancedTreeFromValues(values, 0, static_cast<int>(values.size()) - 1);
+    std::vector<TreeNode<T> *> garbage;
+    this->root = unionNodes(this->root, batch, 1, garbage);
+    for (TreeNode<T> *node : garbage)
     {
-        node->setLeft(insert(node->getLeft(), value));
+        this->destroyNodes(node);
     }
-    else if (value > node->getData())
+    return size() - before;
+}
+
+template <typename T, typename Allocator>
+size_t AVLTree<T, Allocator>::sortUnique(std::vector<T> &values)
+{
+    if (!std::is_sorted(values.begin(), values.end()))
     {
-        node->setRight(insert(node->getRight(), value));
+        std::stable_sort(values.begin(), values.end());
     }
-    else
+
+    auto uniqueEnd = std::unique(values.begin(), values.end(), [](const T &a, const T &b)
+                                 { return !(a < b) && !(b < a); });
+    size_t duplicates = values.end() - uniqueEnd;
+    values.erase(uniqueEnd, values.end());
+    return duplicates;
+}
+
+template <typename T, typename Allocator>
+const TreeNode<T> *AVLTree<T, Allocator>::leftChild(const TreeNode<T> *node)
+{
+    return node->hasLeftThread() ? nullptr : node->getLeft();
+}
+
+template <typename T, typename Allocator>
+const TreeNode<T> *AVLTree<T, Allocator>::rightChild(const TreeNode<T> *node)
+{
+    return node->hasRightThread() ? nullptr : node->getRight();
+}
+
+template <typename T, typename Allocator>
+size_t AVLTree<T, Allocator>::sizeOf(const TreeNode<T> *node)
+{
+    return node ? node->getSize() : 0;
+}
+
+template <typename T, typename Allocator>
+size_t AVLTree<T, Allocator>::size() const
+{
+    return sizeOf(this->root);
+}
+
+template <typename T, typename Allocator>
+const T &AVLTree<T, Allocator>::select(size_t k) const
+{
+    if (k >= size())
     {
-        return node;
+        throw std::out_of_range("select index is out of range");
     }
 
-    node->setHeight(1 + std::max(getHeight(node->getLeft()), getHeight(node->getRight())));
+    const TreeNode<T> *node = this->root;
+    while (true)
+    {
+        size_t leftSize = sizeOf(leftChild(node));
+        if (k < leftSize)
+        {
+            node = leftChild(node);
+        }
+        else if (k == leftSize)
+        {
+            return node->getData();
+        }
+        else
+        {
+            k -= leftSize + 1;
+            node = rightChild(node);
+        }
+    }
+}
 
-    int balance = getBalance(node);
+template <typename T, typename Allocator>
+size_t AVLTree<T, Allocator>::countBelow(const T &value, bool inclusive) const
+{
+    size_t count = 0;
+    const TreeNode<T> *node = this->root;
+    while (node)
+    {
+        bool below = inclusive ? !(value < node->getData()) : node->getData() < value;
+        if (below)
+        {
+            count += sizeOf(leftChild(node)) + 1;
+            node = rightChild(node);
+        }
+        else
+        {
+            node = leftChild(node);
+        }
+    }
+    return count;
+}
+
+template <typename T, typename Allocator>
+size_t AVLTree<T, Allocator>::rank(const T &value) const
+{
+    return countBelow(value, false);
+}
+
+template <typename T, typename Allocator>
+size_t AVLTree<T, Allocator>::countRange(const T &lo, const T &hi) const
+{
+    if (hi < lo)
+    {
+        return 0;
+    }
+    return countBelow(hi, true) - countBelow(lo, false);
+}
+
+template <typename T, typename Allocator>
+TreeNode<T> *AVLTree<T, Allocator>::joinRight(TreeNode<T> *left, TreeNode<T> *key, TreeNode<T> *right)
+{
+    // left is the taller tree: walk down its right spine to a subtree of about right's height
+    TreeNode<T> *spine = left->getRight();
+    if (getHeight(spine) <= getHeight(right) + 1)
+    {
+        key->setLeft(spine);
+        key->setRight(right);
+        if (getHeight(key) <= getHeight(left->getLeft()) + 1)
+        {
+            left->setRight(key);
+            return left;
+        }
+        left->setRight(rotateRight(key));
+        return rotateLeft(left);
+    }
 
-    if (balance > 1 && node->getLeft() && value < node->getLeft()->getData())
+    TreeNode<T> *joined = joinRight(spine, key, right);
+    left->setRight(joined);
+    if (getHeight(joined) <= getHeight(left->getLeft()) + 1)
     {
-        return rotateRight(node);
+        return left;
     }
+    return rotateLeft(left);
+}
 
-    if (balance < -1 && node->getRight() && value > node->getRight()->getData())
+template <typename T, typename Allocator>
+TreeNode<T> *AVLTree<T, Allocator>::joinLeft(TreeNode<T> *left, TreeNode<T> *key, TreeNode<T> *right)
+{
+    TreeNode<T> *spine = right->getLeft();
+    if (getHeight(spine) <= getHeight(left) + 1)
     {
-        return rotateLeft(node);
+        key->setLeft(left);
+        key->setRight(spine);
+        if (getHeight(key) <= getHeight(right->getRight()) + 1)
+        {
+            right->setLeft(key);
+            return right;
+        }
+        right->setLeft(rotateLeft(key));
+        return rotateRight(right);
     }
 
-    if (balance > 1 && node->getLeft() && value > node->getLeft()->getData())
+    TreeNode<T> *joined = joinLeft(left, key, spine);
+    right->setLeft(joined);
+    if (getHeight(joined) <= getHeight(right->getRight()) + 1)
     {
-        return rotateLeftRight(node);
+        return right;
     }
+    return rotateRight(right);
+}
 
-    if (balance < -1 && node->getRight() && value < node->getRight()->getData())
+template <typename T, typename Allocator>
+TreeNode<T> *AVLTree<T, Allocator>::joinNodes(TreeNode<T> *left, TreeNode<T> *key, TreeNode<T> *right)
+{
+    if (getHeight(left) > getHeight(right) + 1)
+    {
+        return joinRight(left, key, right);
+    }
+    if (getHeight(right) > getHeight(left) + 1)
     {
-        return rotateRightLeft(node);
+        return joinLeft(left, key, right);
     }
+    key->setLeft(left);
+    key->setRight(right);
+    return key;
+}
 
-    return node;
+template <typename T, typename Allocator>
+TreeNode<T> *AVLTree<T, Allocator>::splitLast(TreeNode<T> *node, TreeNode<T> *&last)
+{
+    TreeNode<T> *left = node->getLeft();
+    TreeNode<T> *right = node->getRight();
+    node->detach();
+    if (!right)
+    {
+        last = node;
+        return left;
+    }
+    return joinNodes(left, node, splitLast(right, last));
 }
 
-template <typename T>
-void AVLTree<T>::insert(const T &value)
+template <typename T, typename Allocator>
+TreeNode<T> *AVLTree<T, Allocator>::joinNodes(TreeNode<T> *left, TreeNode<T> *right)
 {
-    this->isThreaded = false;
-    updateRoot(insert(this->root, value));
+    if (!left)
+    {
+        return right;
+    }
+    TreeNode<T> *last = nullptr;
+    TreeNode<T> *rest = splitLast(left, last);
+    return joinNodes(rest, last, right);
 }
 
-template <typename T>
-TreeNode<T> *AVLTree<T>::remove(TreeNode<T> *node, const T &value)
+template <typename T, typename Allocator>
+TreeNode<T> *AVLTree<T, Allocator>::splitNodes(TreeNode<T> *node, const T &key, TreeNode<T> *&less, TreeNode<T> *&greater)
 {
     if (!node)
     {
+        less = nullptr;
+        greater = nullptr;
         return nullptr;
     }
 
-    if (value < node->getData())
+    TreeNode<T> *left = node->getLeft();
+    TreeNode<T> *right = node->getRight();
+    node->detach();
+
+    if (key < node->getData())
     {
-        node->setLeft(remove(node->getLeft(), value));
+        TreeNode<T> *rest = nullptr;
+        TreeNode<T> *found = splitNodes(left, key, less, rest);
+        greater = joinNodes(rest, node, right);
+        return found;
     }
-    else if (value > node->getData())
+    if (key > node->getData())
     {
-        node->setRight(remove(node->getRight(), value));
+        TreeNode<T> *rest = nullptr;
+        TreeNode<T> *found = splitNodes(right, key, rest, greater);
+        less = joinNodes(left, node, rest);
+        return found;
     }
-    else
+    less = left;
+    greater = right;
+    return node;
+}
+
+template <typename T, typename Allocator>
+template <typename First, typename Second>
+void AVLTree<T, Allocator>::forkJoin(bool parallel, First first, Second second)
+{
+    if (!parallel)
     {
-        if (!node->getLeft() || !node->getRight())
-        {
-            TreeNode<T> *temp = node->getLeft() ? node->getLeft() : node->getRight();
-            if (!temp)
-            {
-                temp = node;
-                node = nullptr;
-            }
-            else
-            {
-                node->setData(temp->getData());
-                node->setLeft(temp->getLeft());
-                node->setRight(temp->getRight());
-            }
-            delete temp;
-        }
-        else
-        {
-            TreeNode<T> *temp = node->getRight();
-            while (temp->getLeft())
-                temp = temp->getLeft();
-            node->setData(temp->getData());
-            node->setRight(remove(node->getRight(), temp->getData()));
-        }
+        first();
+        second();
+        return;
     }
+    std::thread worker(first);
+    second();
+    worker.join();
+}
 
-    if (!node)
+template <typename T, typename Allocator>
+TreeNode<T> *AVLTree<T, Allocator>::unionNodes(TreeNode<T> *a, TreeNode<T> *b, unsigned threads,
+                                               std::vector<TreeNode<T> *> &garbage)
+{
+    if (!a)
+    {
+        return b;
+    }
+    if (!b)
+    {
+        return a;
+    }
+
+    bool parallel = threads > 1 && a->getHeight() >= parallelCutoffHeight;
+    TreeNode<T> *left = a->getLeft();
+    TreeNode<T> *right = a->getRight();
+    a->detach();
+
+    TreeNode<T> *less = nullptr;
+    TreeNode<T> *greater = nullptr;
+    TreeNode<T> *found = splitNodes(b, a->getData(), less, greater);
+    if (found)
     {
+        garbage.push_back(found);
+    }
+
+    // The two halves share no nodes, so they can be combined on different threads
+    unsigned forked = parallel ? threads / 2 : threads;
+    unsigned kept = parallel ? threads - threads / 2 : threads;
+    std::vector<TreeNode<T> *> rightGarbage;
+    forkJoin(parallel,
+             [&]
+             { left = unionNodes(left, less, forked, garbage); },
+             [&]
+             { right = unionNodes(right, greater, kept, rightGarbage); });
+    garbage.insert(garbage.end(), rightGarbage.begin(), rightGarbage.end());
+    return joinNodes(left, a, right);
+}
+
+template <typename T, typename Allocator>
+TreeNode<T> *AVLTree<T, Allocator>::intersectNodes(TreeNode<T> *a, TreeNode<T> *b, unsigned threads,
+                                                   std::vector<TreeNode<T> *> &garbage)
+{
+    if (!a || !b)
+    {
+        if (a)
+            garbage.push_back(a);
+        if (b)
+            garbage.push_back(b);
         return nullptr;
     }
 
-    node->setHeight(1 + std::max(getHeight(node->getLeft()), getHeight(node->getRight())));
+    bool parallel = threads > 1 && a->getHeight() >= parallelCutoffHeight;
+    TreeNode<T> *left = a->getLeft();
+    TreeNode<T> *right = a->getRight();
+    a->detach();
+
+    TreeNode<T> *less = nullptr;
+    TreeNode<T> *greater = nullptr;
+    TreeNode<T> *found = splitNodes(b, a->getData(), less, greater);
+
+    unsigned forked = parallel ? threads / 2 : threads;
+    unsigned kept = parallel ? threads - threads / 2 : threads;
+    std::vector<TreeNode<T> *> rightGarbage;
+    forkJoin(parallel,
+             [&]
+             { left = intersectNodes(left, less, forked, garbage); },
+             [&]
+             { right = intersectNodes(right, greater, kept, rightGarbage); });
+    garbage.insert(garbage.end(), rightGarbage.begin(), rightGarbage.end());
+
+    if (found)
+    {
+        garbage.push_back(found);
+        return joinNodes(left, a, right);
+    }
+    garbage.push_back(a);
+    return joinNodes(left, right);
+}
 
-    int balance = getBalance(node);
+template <typename T, typename Allocator>
+TreeNode<T> *AVLTree<T, Allocator>::differenceNodes(TreeNode<T> *a, TreeNode<T> *b, unsigned threads,
+                                                    std::vector<TreeNode<T> *> &garbage)
+{
+    if (!a || !b)
+    {
+        if (b)
+            garbage.push_back(b);
+        return a;
+    }
+
+    bool parallel = threads > 1 && b->getHeight() >= parallelCutoffHeight;
+    TreeNode<T> *left = b->getLeft();
+    TreeNode<T> *right = b->getRight();
+    b->detach();
 
-    if (balance > 1 && node->getLeft() && getBalance(node->getLeft()) >= 0)
+    TreeNode<T> *less = nullptr;
+    TreeNode<T> *greater = nullptr;
+    TreeNode<T> *found = splitNodes(a, b->getData(), less, greater);
+    if (found)
     {
-        return rotateRight(node);
+        garbage.push_back(found);
     }
+    garbage.push_back(b);
+
+    unsigned forked = parallel ? threads / 2 : threads;
+    unsigned kept = parallel ? threads - threads / 2 : threads;
+    std::vector<TreeNode<T> *> rightGarbage;
+    forkJoin(parallel,
+             [&]
+             { less = differenceNodes(less, left, forked, garbage); },
+             [&]
+             { greater = differenceNodes(greater, right, kept, rightGarbage); });
+    garbage.insert(garbage.end(), rightGarbage.begin(), rightGarbage.end());
+    return joinNodes(less, greater);
+}
 
-    if (balance > 1 && node->getLeft() && getBalance(node->getLeft()) < 0)
+template <typename T, typename Allocator>
+TreeNode<T> *AVLTree<T, Allocator>::cloneParallel(const TreeNode<T> *node, unsigned threads)
+{
+    // Only a stateless allocator (plain new) may be called from several threads
+    if (!node || threads <= 1 || !std::is_empty<Allocator>::value || node->getHeight() < parallelCutoffHeight)
     {
-        return rotateLeftRight(node);
+        return this->cloneNodes(node);
     }
 
-    if (balance < -1 && node->getRight() && getBalance(node->getRight()) <= 0)
+    TreeNode<T> *copy = this->nodeAllocator.create(node->getData());
+    TreeNode<T> *left = nullptr;
+    TreeNode<T> *right = nullptr;
+    forkJoin(true,
+             [&]
+             { left = cloneParallel(node->hasLeftThread() ? nullptr : node->getLeft(), threads / 2); },
+             [&]
+             { right = cloneParallel(node->hasRightThread() ? nullptr : node->getRight(), threads - threads / 2); });
+    copy->setLeft(left);
+    copy->setRight(right);
+    return copy;
+}
+
+template <typename T, typename Allocator>
+void AVLTree<T, Allocator>::combineFrom(const TreeNode<T> *a, const TreeNode<T> *b, NodeSetOperation operation,
+                                        unsigned threads)
+{
+    TreeNode<T> *mine = nullptr;
+    TreeNode<T> *theirs = nullptr;
+    bool parallel = threads > 1 && std::is_empty<Allocator>::value;
+    forkJoin(parallel,
+             [&]
+             { mine = cloneParallel(a, parallel ? threads / 2 : 1); },
+             [&]
+             { theirs = cloneParallel(b, parallel ? threads - threads / 2 : 1); });
+
+    std::vector<TreeNode<T> *> garbage;
+    this->root = (this->*operation)(mine, theirs, threads, garbage);
+    for (TreeNode<T> *node : garbage)
     {
-        return rotateLeft(node);
+        this->destroyNodes(node);
     }
+}
+
+template <typename T, typename Allocator>
+AVLTree<T, Allocator> AVLTree<T, Allocator>::unionWith(const AVLTree &other, unsigned threads) const
+{
+    AVLTree<T, Allocator> result;
+    result.combineFrom(this->root, other.root, &AVLTree::unionNodes, threads);
+    return result;
+}
+
+template <typename T, typename Allocator>
+AVLTree<T, Allocator> AVLTree<T, Allocator>::intersect(const AVLTree &other, unsigned threads) const
+{
+    AVLTree<T, Allocator> result;
+    result.combineFrom(this->root, other.root, &AVLTree::intersectNodes, threads);
+    return result;
+}
 
-    if (balance < -1 && node->getRight() && getBalance(node->getRight()) > 0)
+template <typename T, typename Allocator>
+AVLTree<T, Allocator> AVLTree<T, Allocator>::difference(const AVLTree &other, unsigned threads) const
+{
+    AVLTree<T, Allocator> result;
+    result.combineFrom(this->root, other.root, &AVLTree::differenceNodes, threads);
+    return result;
+}
+
+template <typename T, typename Allocator>
+void AVLTree<T, Allocator>::merge(const AVLTree &other, unsigned threads)
+{
+    if (&other == this)
     {
-        return rotateRightLeft(node);
+        return;
     }
 
-    return node;
+    this->removeThreads();
+    TreeNode<T> *theirs = cloneParallel(other.root, threads);
+    std::vector<TreeNode<T> *> garbage;
+    this->root = unionNodes(this->root, theirs, threads, garbage);
+    for (TreeNode<T> *node : garbage)
+    {
+        this->destroyNodes(node);
+    }
 }
 
-template <typename T>
-void AVLTree<T>::remove(const T &value)
+template <typename T, typename Allocator>
+TreeNode<T> *AVLTree<T, Allocator>::takeNodes(AVLTree &from)
 {
-    updateRoot(remove(this->root, value));
-    this->isThreaded = false;
-}
\ No newline at end of file
+    from.removeThreads();
+    TreeNode<T> *nodes = from.root;
+    if (&from != this && !std::is_empty<Allocator>::value)
+    {
+        // A stateful allocator (a pool) owns its nodes, so they are copied across
+        nodes = this->cloneNodes(from.root);
+        from.clear();
+    }
+    from.root = nullptr;
+    return nodes;
+}
+
+template <typename T, typename Allocator>
+void AVLTree<T, Allocator>::placeNodes(AVLTree &to, TreeNode<T> *nodes)
+{
+    if (&to == this)
+    {
+        this->root = nodes;
+        return;
+    }
+    to.clear();
+    if (std::is_empty<Allocator>::value)
+    {
+        to.root = nodes;
+        return;
+    }
+    to.root = to.cloneNodes(nodes);
+    this->destroyNodes(nodes);
+}
+
+template <typename T, typename Allocator>
+bool AVLTree<T, Allocator>::split(const T &key, AVLTree &less, AVLTree &greater)
+{
+    if (&less == &greater)
+    {
+        throw std::invalid_argument("split needs two distinct target trees");
+    }
+
+    TreeNode<T> *lessNodes = nullptr;
+    TreeNode<T> *greaterNodes = nullptr;
+    TreeNode<T> *found = splitNodes(takeNodes(*this), key, lessNodes, greaterNodes);
+    this->nodeAllocator.retire(found);
+
+    placeNodes(less, lessNodes);
+    placeNodes(greater, greaterNodes);
+    return found != nullptr;
+}
+
+template <typename T, typename Allocator>
+void AVLTree<T, Allocator>::join(AVLTree &less, const T &key, AVLTree &greater)
+{
+    if (&less == &greater && !less.isEmpty())
+    {
+        throw std::invalid_argument("join needs two distinct source trees");
+    }
+    if ((!less.isEmpty() && !(less.getMax() < key)) || (!greater.isEmpty() && !(key < greater.getMin())))
+    {
+        throw std::invalid_argument("join keys are out of order");
+    }
+
+    if (&less != this && &greater != this)
+    {
+        this->clear();
+    }
+    TreeNode<T> *lessNodes = takeNodes(less);
+    TreeNode<T> *greaterNodes = takeNodes(greater);
+    this->root = joinNodes(lessNodes, this->nodeAllocator.create(key), greaterNodes);
+}
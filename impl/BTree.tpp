@@ -0,0 +1,658 @@
+#include "../inc/BTree.hpp"
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+template <typename T, size_t NodeBytes>
+BTree<T, NodeBytes>::BTree() : root(nullptr), count(0) {}
+
+template <typename T, size_t NodeBytes>
+BTree<T, NodeBytes>::BTree(const BTree &other) : root(nullptr), count(other.count)
+{
+    Leaf *lastLeaf = nullptr;
+    root = cloneNode(other.root, lastLeaf);
+}
+
+template <typename T, size_t NodeBytes>
+BTree<T, NodeBytes>::BTree(BTree &&other) noexcept : root(other.root), count(other.count)
+{
+    other.root = nullptr;
+    other.count = 0;
+}
+
+template <typename T, size_t NodeBytes>
+BTree<T, NodeBytes> &BTree<T, NodeBytes>::operator=(const BTree &other)
+{
+    if (this != &other)
+    {
+        BTree copy(other);
+        std::swap(root, copy.root);
+        std::swap(count, copy.count);
+    }
+    return *this;
+}
+
+template <typename T, size_t NodeBytes>
+BTree<T, NodeBytes> &BTree<T, NodeBytes>::operator=(BTree &&other) noexcept
+{
+    if (this != &other)
+    {
+        std::swap(root, other.root);
+        std::swap(count, other.count);
+        other.clear();
+    }
+    return *this;
+}
+
+template <typename T, size_t NodeBytes>
+BTree<T, NodeBytes>::~BTree()
+{
+    clear();
+}
+
+template <typename T, size_t NodeBytes>
+void *BTree<T, NodeBytes>::Node::operator new(size_t bytes)
+{
+    return tree_detail::cacheAlignedNew(bytes);
+}
+
+template <typename T, size_t NodeBytes>
+void BTree<T, NodeBytes>::Node::operator delete(void *node)
+{
+    tree_detail::cacheAlignedDelete(node);
+}
+
+template <typename T, size_t NodeBytes>
+typename BTree<T, NodeBytes>::Leaf *BTree<T, NodeBytes>::makeLeaf()
+{
+    Leaf *leaf = new Leaf;
+    leaf->count = 0;
+    leaf->leaf = true;
+    leaf->next = nullptr;
+    return leaf;
+}
+
+template <typename T, size_t NodeBytes>
+typename BTree<T, NodeBytes>::Inner *BTree<T, NodeBytes>::makeInner()
+{
+    Inner *inner = new Inner;
+    inner->count = 0;
+    inner->leaf = false;
+    return inner;
+}
+
+template <typename T, size_t NodeBytes>
+template <typename U>
+void BTree<T, NodeBytes>::insertAt(U *items, size_t count, size_t pos, U item)
+{
+    std::move_backward(items + pos, items + count, items + count + 1);
+    items[pos] = std::move(item);
+}
+
+template <typename T, size_t NodeBytes>
+template <typename U>
+void BTree<T, NodeBytes>::eraseAt(U *items, size_t count, size_t pos)
+{
+    std::move(items + pos + 1, items + count, items + pos);
+}
+
+template <typename T, size_t NodeBytes>
+size_t BTree<T, NodeBytes>::minimumOf(const Node *node)
+{
+    if (node->leaf)
+    {
+        return leafMinimum;
+    }
+    return innerMinimum;
+}
+
+template <typename T, size_t NodeBytes>
+size_t BTree<T, NodeBytes>::childIndex(const Inner *inner, const T &value)
+{
+    return std::upper_bound(inner->keys, inner->keys + inner->count, value) - inner->keys;
+}
+
+template <typename T, size_t NodeBytes>
+size_t BTree<T, NodeBytes>::lowerIndex(const Leaf *leaf, const T &value)
+{
+    return std::lower_bound(leaf->keys, leaf->keys + leaf->count, value) - leaf->keys;
+}
+
+template <typename T, size_t NodeBytes>
+const typename BTree<T, NodeBytes>::Leaf *BTree<T, NodeBytes>::findLeaf(const T &value) const
+{
+    const Node *node = root;
+    while (!node->leaf)
+    {
+        const Inner *inner = asInner(node);
+        node = inner->children[childIndex(inner, value)];
+    }
+    return asLeaf(node);
+}
+
+template <typename T, size_t NodeBytes>
+void BTree<T, NodeBytes>::insert(const T &value)
+{
+    if (!root)
+    {
+        Leaf *leaf = makeLeaf();
+        leaf->keys[0] = value;
+        leaf->count = 1;
+        root = leaf;
+        count = 1;
+        return;
+    }
+
+    T separator;
+    Node *sibling = nullptr;
+    if (!insertInto(root, value, separator, sibling))
+    {
+        return;
+    }
+    ++count;
+    if (sibling)
+    {
+        // The root split: the tree grows by one level at the top
+        Inner *top = makeInner();
+        top->keys[0] = std::move(separator);
+        top->children[0] = root;
+        top->children[1] = sibling;
+        top->count = 1;
+        root = top;
+    }
+}
+
+template <typename T, size_t NodeBytes>
+bool BTree<T, NodeBytes>::insertInto(Node *node, const T &value, T &separator, Node *&sibling)
+{
+    if (node->leaf)
+    {
+        Leaf *leaf = asLeaf(node);
+        size_t pos = lowerIndex(leaf, value);
+        if (pos < leaf->count && !(value < leaf->keys[pos]))
+        {
+            return false;
+        }
+        if (leaf->count < leafCapacity)
+        {
+            insertAt(leaf->keys, leaf->count, pos, value);
+            ++leaf->count;
+            return true;
+        }
+
+        // Full: the upper keys move to a new right sibling so that, with the new key,
+        // the left one ends up with half of the leafCapacity + 1 keys
+        size_t half = (leafCapacity + 1) / 2;
+        size_t moveFrom = pos < half ? half - 1 : half;
+        Leaf *right = makeLeaf();
+        std::move(leaf->keys + moveFrom, leaf->keys + leafCapacity, right->keys);
+        right->count = leafCapacity - moveFrom;
+        leaf->count = moveFrom;
+        if (pos < half)
+        {
+            insertAt(leaf->keys, leaf->count, pos, value);
+            ++leaf->count;
+        }
+        else
+        {
+            insertAt(right->keys, right->count, pos - half, value);
+            ++right->count;
+        }
+        right->next = leaf->next;
+        leaf->next = right;
+        separator = right->keys[0];
+        sibling = right;
+        return true;
+    }
+
+    Inner *inner = asInner(node);
+    size_t i = childIndex(inner, value);
+    T childSeparator;
+    Node *childSibling = nullptr;
+    if (!insertInto(inner->children[i], value, childSeparator, childSibling))
+    {
+        return false;
+    }
+    if (!childSibling)
+    {
+        return true;
+    }
+    if (inner->count < innerCapacity)
+    {
+        insertAt(inner->keys, inner->count, i, std::move(childSeparator));
+        insertAt(inner->children, inner->count + 1, i + 1, childSibling);
+        ++inner->count;
+        return true;
+    }
+
+    // Full: lay out the innerCapacity + 1 separators in order, keep the lower half,
+    // move the upper half to a new sibling and pass the middle one up
+    T keys[innerCapacity + 1];
+    Node *children[innerCapacity + 2];
+    std::move(inner->keys, inner->keys + innerCapacity, keys);
+    std::copy(inner->children, inner->children + innerCapacity + 1, children);
+    insertAt(keys, innerCapacity, i, std::move(childSeparator));
+    insertAt(children, innerCapacity + 1, i + 1, childSibling);
+
+    size_t mid = (innerCapacity + 1) / 2;
+    Inner *right = makeInner();
+    std::move(keys, keys + mid, inner->keys);
+    std::copy(children, children + mid + 1, inner->children);
+    inner->count = mid;
+    std::move(keys + mid + 1, keys + innerCapacity + 1, right->keys);
+    std::copy(children + mid + 1, children + innerCapacity + 2, right->children);
+    right->count = innerCapacity - mid;
+    separator = std::move(keys[mid]);
+    sibling = right;
+    return true;
+}
+
+template <typename T, size_t NodeBytes>
+void BTree<T, NodeBytes>::remove(const T &value)
+{
+    if (!root || !removeFrom(root, value))
+    {
+        return;
+    }
+    --count;
+    if (root->leaf)
+    {
+        if (root->count == 0)
+        {
+            delete asLeaf(root);
+            root = nullptr;
+        }
+    }
+    else if (root->count == 0)
+    {
+        // The root lost its last separator: its only child becomes the root
+        Inner *old = asInner(root);
+        root = old->children[0];
+        delete old;
+    }
+}
+
+template <typename T, size_t NodeBytes>
+bool BTree<T, NodeBytes>::removeFrom(Node *node, const T &value)
+{
+    if (node->leaf)
+    {
+        Leaf *leaf = asLeaf(node);
+        size_t pos = lowerIndex(leaf, value);
+        if (pos == leaf->count || value < leaf->keys[pos])
+        {
+            return false;
+        }
+        eraseAt(leaf->keys, leaf->count, pos);
+        --leaf->count;
+        return true;
+    }
+
+    // Separators are left alone when their key goes; they still split the key ranges
+    Inner *inner = asInner(node);
+    size_t i = childIndex(inner, value);
+    if (!removeFrom(inner->children[i], value))
+    {
+        return false;
+    }
+    if (inner->children[i]->count < minimumOf(inner->children[i]))
+    {
+        refillChild(inner, i);
+    }
+    return true;
+}
+
+template <typename T, size_t NodeBytes>
+void BTree<T, NodeBytes>::refillChild(Inner *parent, size_t i)
+{
+    if (i > 0 && parent->children[i - 1]->count > minimumOf(parent->children[i - 1]))
+    {
+        borrowFromLeft(parent, i);
+    }
+    else if (i < parent->count && parent->children[i + 1]->count > minimumOf(parent->children[i + 1]))
+    {
+        borrowFromRight(parent, i);
+    }
+    else
+    {
+        mergeChildren(parent, i < parent->count ? i : i - 1);
+    }
+}
+
+template <typename T, size_t NodeBytes>
+void BTree<T, NodeBytes>::borrowFromLeft(Inner *parent, size_t i)
+{
+    Node *left = parent->children[i - 1];
+    Node *child = parent->children[i];
+    if (child->leaf)
+    {
+        Leaf *from = asLeaf(left);
+        Leaf *to = asLeaf(child);
+        insertAt(to->keys, to->count, 0, std::move(from->keys[from->count - 1]));
+        ++to->count;
+        --from->count;
+        parent->keys[i - 1] = to->keys[0];
+        return;
+    }
+
+    // The separator comes down in front of the child, the left sibling's last key goes up
+    Inner *from = asInner(left);
+    Inner *to = asInner(child);
+    insertAt(to->keys, to->count, 0, std::move(parent->keys[i - 1]));
+    insertAt(to->children, to->count + 1, 0, from->children[from->count]);
+    ++to->count;
+    parent->keys[i - 1] = std::move(from->keys[from->count - 1]);
+    --from->count;
+}
+
+template <typename T, size_t NodeBytes>
+void BTree<T, NodeBytes>::borrowFromRight(Inner *parent, size_t i)
+{
+    Node *child = parent->children[i];
+    Node *right = parent->children[i + 1];
+    if (child->leaf)
+    {
+        Leaf *to = asLeaf(child);
+        Leaf *from = asLeaf(right);
+        to->keys[to->count] = std::move(from->keys[0]);
+        ++to->count;
+        eraseAt(from->keys, from->count, 0);
+        --from->count;
+        parent->keys[i] = from->keys[0];
+        return;
+    }
+
+    Inner *to = asInner(child);
+    Inner *from = asInner(right);
+    to->keys[to->count] = std::move(parent->keys[i]);
+    to->children[to->count + 1] = from->children[0];
+    ++to->count;
+    parent->keys[i] = std::move(from->keys[0]);
+    eraseAt(from->keys, from->count, 0);
+    eraseAt(from->children, from->count + 1, 0);
+    --from->count;
+}
+
+template <typename T, size_t NodeBytes>
+void BTree<T, NodeBytes>::mergeChildren(Inner *parent, size_t i)
+{
+    Node *left = parent->children[i];
+    Node *right = parent->children[i + 1];
+    if (left->leaf)
+    {
+        Leaf *to = asLeaf(left);
+        Leaf *from = asLeaf(right);
+        std::move(from->keys, from->keys + from->count, to->keys + to->count);
+        to->count += from->count;
+        to->next = from->next;
+        delete from;
+    }
+    else
+    {
+        Inner *to = asInner(left);
+        Inner *from = asInner(right);
+        to->keys[to->count] = std::move(parent->keys[i]);
+        std::move(from->keys, from->keys + from->count, to->keys + to->count + 1);
+        std::copy(from->children, from->children + from->count + 1, to->children + to->count + 1);
+        to->count += from->count + 1;
+        delete from;
+    }
+    eraseAt(parent->keys, parent->count, i);
+    eraseAt(parent->children, parent->count + 1, i + 1);
+    --parent->count;
+}
+
+template <typename T, size_t NodeBytes>
+const T *BTree<T, NodeBytes>::search(const T &value) const
+{
+    if (!root)
+    {
+        return nullptr;
+    }
+    const Leaf *leaf = findLeaf(value);
+    size_t pos = lowerIndex(leaf, value);
+    return pos < leaf->count && leaf->keys[pos] == value ? &leaf->keys[pos] : nullptr;
+}
+
+template <typename T, size_t NodeBytes>
+bool BTree<T, NodeBytes>::hasValue(const T &value) const
+{
+    return search(value) != nullptr;
+}
+
+template <typename T, size_t NodeBytes>
+const T &BTree<T, NodeBytes>::getMin() const
+{
+    if (!root)
+    {
+        throw std::runtime_error("Tree is empty");
+    }
+    const Node *node = root;
+    while (!node->leaf)
+    {
+        node = asInner(node)->children[0];
+    }
+    return asLeaf(node)->keys[0];
+}
+
+template <typename T, size_t NodeBytes>
+const T &BTree<T, NodeBytes>::getMax() const
+{
+    if (!root)
+    {
+        throw std::runtime_error("Tree is empty");
+    }
+    const Node *node = root;
+    while (!node->leaf)
+    {
+        node = asInner(node)->children[node->count];
+    }
+    return asLeaf(node)->keys[node->count - 1];
+}
+
+template <typename T, size_t NodeBytes>
+int BTree<T, NodeBytes>::getHeight() const
+{
+    if (!root)
+    {
+        throw std::runtime_error("Tree is empty");
+    }
+    int height = 0;
+    for (const Node *node = root; !node->leaf; node = asInner(node)->children[0])
+    {
+        ++height;
+    }
+    return height;
+}
+
+template <typename T, size_t NodeBytes>
+size_t BTree<T, NodeBytes>::size() const
+{
+    return count;
+}
+
+template <typename T, size_t NodeBytes>
+bool BTree<T, NodeBytes>::isEmpty() const
+{
+    return root == nullptr;
+}
+
+template <typename T, size_t NodeBytes>
+void BTree<T, NodeBytes>::clear()
+{
+    destroyNode(root);
+    root = nullptr;
+    count = 0;
+}
+
+template <typename T, size_t NodeBytes>
+void BTree<T, NodeBytes>::destroyNode(Node *node)
+{
+    if (!node)
+    {
+        return;
+    }
+    if (node->leaf)
+    {
+        delete asLeaf(node);
+        return;
+    }
+    Inner *inner = asInner(node);
+    for (size_t i = 0; i <= inner->count; ++i)
+    {
+        destroyNode(inner->children[i]);
+    }
+    delete inner;
+}
+
+template <typename T, size_t NodeBytes>
+typename BTree<T, NodeBytes>::Node *BTree<T, NodeBytes>::cloneNode(const Node *node, Leaf *&lastLeaf)
+{
+    if (!node)
+    {
+        return nullptr;
+    }
+    if (node->leaf)
+    {
+        const Leaf *leaf = asLeaf(node);
+        Leaf *copy = makeLeaf();
+        std::copy(leaf->keys, leaf->keys + leaf->count, copy->keys);
+        copy->count = leaf->count;
+        if (lastLeaf)
+        {
+            lastLeaf->next = copy;
+        }
+        lastLeaf = copy;
+        return copy;
+    }
+
+    const Inner *inner = asInner(node);
+    Inner *copy = makeInner();
+    std::copy(inner->keys, inner->keys + inner->count, copy->keys);
+    copy->count = inner->count;
+    for (size_t i = 0; i <= inner->count; ++i)
+    {
+        copy->children[i] = cloneNode(inner->children[i], lastLeaf);
+    }
+    return copy;
+}
+
+template <typename T, size_t NodeBytes>
+typename BTree<T, NodeBytes>::ConstIterator BTree<T, NodeBytes>::cbegin() const
+{
+    if (!root)
+    {
+        return cend();
+    }
+    const Node *node = root;
+    while (!node->leaf)
+    {
+        node = asInner(node)->children[0];
+    }
+    return ConstIterator(asLeaf(node), 0);
+}
+
+template <typename T, size_t NodeBytes>
+typename BTree<T, NodeBytes>::ConstIterator BTree<T, NodeBytes>::cend() const
+{
+    return ConstIterator(nullptr, 0);
+}
+
+template <typename T, size_t NodeBytes>
+void BTree<T, NodeBytes>::inorderTraversal(std::ostream &os) const
+{
+    for (auto it = cbegin(); it != cend(); ++it)
+    {
+        os << *it << " ";
+    }
+}
+
+template <typename T, size_t NodeBytes>
+std::string BTree<T, NodeBytes>::serialize(const std::string &traversalOrder) const
+{
+    std::ostringstream output;
+    output << "{\n";
+    output << "  \"type\": \"b_tree\",\n";
+    output << "  \"traversal\": \"" << traversalOrder << "\",\n";
+    output << "  \"values\": [";
+    for (auto it = cbegin(); it != cend(); ++it)
+    {
+        output << (it == cbegin() ? "" : ", ") << "\"" << *it << "\"";
+    }
+    output << "],\n";
+
+    output << "  \"levels\": [";
+    std::vector<const Node *> level;
+    if (root)
+    {
+        level.push_back(root);
+    }
+    for (bool firstLevel = true; !level.empty(); firstLevel = false)
+    {
+        output << (firstLevel ? "" : ", ") << "[";
+        std::vector<const Node *> below;
+        for (size_t n = 0; n < level.size(); ++n)
+        {
+            const Node *node = level[n];
+            const T *keys = node->leaf ? asLeaf(node)->keys : asInner(node)->keys;
+            output << (n == 0 ? "" : ", ") << "[";
+            for (size_t k = 0; k < node->count; ++k)
+            {
+                output << (k == 0 ? "" : ", ") << "\"" << keys[k] << "\"";
+            }
+            output << "]";
+            if (!node->leaf)
+            {
+                const Inner *inner = asInner(node);
+                below.insert(below.end(), inner->children, inner->children + inner->count + 1);
+            }
+        }
+        output << "]";
+        level.swap(below);
+    }
+    output << "],\n";
+    output << "  \"size\": " << count << "\n";
+    output << "}";
+    return output.str();
+}
+
+template <typename T, size_t NodeBytes>
+const T &BTree<T, NodeBytes>::ConstIterator::operator*() const
+{
+    if (!leaf)
+    {
+        throw std::out_of_range("Iterator dereference out of range");
+    }
+    return leaf->keys[index];
+}
+
+template <typename T, size_t NodeBytes>
+typename BTree<T, NodeBytes>::ConstIterator &BTree<T, NodeBytes>::ConstIterator::operator++()
+{
+    if (leaf && ++index == leaf->count)
+    {
+        leaf = leaf->next;
+        index = 0;
+    }
+    return *this;
+}
+
+template <typename T, size_t NodeBytes>
+typename BTree<T, NodeBytes>::ConstIterator BTree<T, NodeBytes>::ConstIterator::operator++(int)
+{
+    ConstIterator previous = *this;
+    ++(*this);
+    return previous;
+}
+
+template <typename T, size_t NodeBytes>
+bool BTree<T, NodeBytes>::ConstIterator::operator==(const ConstIterator &other) const
+{
+    return leaf == other.leaf && index == other.index;
+}
+
+template <typename T, size_t NodeBytes>
+bool BTree<T, NodeBytes>::ConstIterator::operator!=(const ConstIterator &other) const
+{
+    return !(*this == other);
+}
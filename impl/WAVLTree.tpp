@@ -0,0 +1,293 @@
+#include "../inc/WAVLTree.hpp"
+#include <cmath>
+
+template <typename T, typename Allocator>
+void WAVLTree<T, Allocator>::insert(const T &value)
+{
+    this->removeThreads();
+
+    std::vector<TreeNode<T> *> &path = this->pathBuffer();
+    TreeNode<T> *node = this->root;
+    while (node)
+    {
+        path.push_back(node);
+        if (value < node->getData())
+        {
+            node = node->getLeft();
+        }
+        else if (value > node->getData())
+        {
+            node = node->getRight();
+        }
+        else
+        {
+            return;
+        }
+    }
+
+    // New nodes start with an even balance bit, i.e. as rank 0 leaves
+    TreeNode<T> *leaf = this->nodeAllocator.create(value);
+    if (path.empty())
+    {
+        this->root = leaf;
+        return;
+    }
+    if (value < path.back()->getData())
+    {
+        path.back()->linkLeft(leaf);
+    }
+    else
+    {
+        path.back()->linkRight(leaf);
+    }
+    fixInsert(path, leaf);
+}
+
+template <typename T, typename Allocator>
+void WAVLTree<T, Allocator>::fixInsert(std::vector<TreeNode<T> *> &path, TreeNode<T> *node)
+{
+    // node was just created or promoted, so its rank difference is 0 or 1 and equal
+    // parities mean 0, the one violation insertion can cause. Heights and sizes are
+    // refreshed on the way up, so everything below path[i - 1] is up to date.
+    size_t i = path.size();
+    while (i > 0)
+    {
+        TreeNode<T> *parent = path[i - 1];
+        parent->update();
+        if (oddRank(parent) != oddRank(node))
+        {
+            break;
+        }
+
+        bool left = parent->getLeft() == node;
+        TreeNode<T> *sibling = left ? parent->getRight() : parent->getLeft();
+        if (oddRank(sibling) != oddRank(parent))
+        {
+            // The sibling is a 1-child: promote the parent and carry on above it
+            flipRank(parent);
+            node = parent;
+            --i;
+            continue;
+        }
+
+        // The sibling is a 2-child: one or two rotations end the walk
+        TreeNode<T> *inner = left ? node->getRight() : node->getLeft();
+        TreeNode<T> *top;
+        if (oddRank(inner) == oddRank(node))
+        {
+            top = left ? rotateRight(parent) : rotateLeft(parent);
+            flipRank(parent);
+        }
+        else
+        {
+            if (left)
+            {
+                parent->linkLeft(rotateLeft(node));
+                top = rotateRight(parent);
+            }
+            else
+            {
+                parent->linkRight(rotateRight(node));
+                top = rotateLeft(parent);
+            }
+            flipRank(top);
+            flipRank(node);
+            flipRank(parent);
+        }
+        this->replaceChild(i > 1 ? path[i - 2] : nullptr, parent, top);
+        break;
+    }
+    this->updatePath(path, i > 0 ? i - 1 : 0, 1);
+}
+
+template <typename T, typename Allocator>
+void WAVLTree<T, Allocator>::remove(const T &value)
+{
+    this->removeThreads();
+
+    std::vector<TreeNode<T> *> &path = this->pathBuffer();
+    TreeNode<T> *node = this->root;
+    while (node)
+    {
+        if (value < node->getData())
+        {
+            path.push_back(node);
+            node = node->getLeft();
+        }
+        else if (value > node->getData())
+        {
+            path.push_back(node);
+            node = node->getRight();
+        }
+        else
+        {
+            break;
+        }
+    }
+    if (!node)
+    {
+        return;
+    }
+
+    // As in AVLTree, a node with two children takes its successor's key and the
+    // successor is unlinked instead
+    TreeNode<T> *victim = node;
+    if (node->getLeft() && node->getRight())
+    {
+        path.push_back(node);
+        victim = node->getRight();
+        while (victim->getLeft())
+        {
+            path.push_back(victim);
+            victim = victim->getLeft();
+        }
+        node->setData(victim->getData());
+    }
+
+    TreeNode<T> *parent = path.empty() ? nullptr : path.back();
+    TreeNode<T> *child = victim->getLeft() ? victim->getLeft() : victim->getRight();
+    bool left = parent && parent->getLeft() == victim;
+    this->replaceChild(parent, victim, child);
+    this->nodeAllocator.retire(victim);
+    fixRemove(path, child, left);
+}
+
+template <typename T, typename Allocator>
+void WAVLTree<T, Allocator>::fixRemove(std::vector<TreeNode<T> *> &path, TreeNode<T> *node, bool left)
+{
+    // Heights and sizes are refreshed on the way up, as in fixInsert
+    size_t i = path.size();
+    // A parent left without children has rank 1 and must become a rank 0 leaf
+    if (i > 0 && path[i - 1]->isLeaf() && oddRank(path[i - 1]))
+    {
+        path[i - 1]->update();
+        flipRank(path[i - 1]);
+        node = path[--i];
+        left = i > 0 && path[i - 1]->getLeft() == node;
+    }
+
+    // node's rank difference is 2 or 3 here and unequal parities mean 3, a violation
+    while (i > 0)
+    {
+        TreeNode<T> *parent = path[i - 1];
+        parent->update();
+        if (oddRank(parent) == oddRank(node))
+        {
+            break;
+        }
+
+        TreeNode<T> *sibling = left ? parent->getRight() : parent->getLeft();
+        TreeNode<T> *inner = left ? sibling->getLeft() : sibling->getRight();
+        TreeNode<T> *outer = left ? sibling->getRight() : sibling->getLeft();
+        bool siblingIsTwoChild = oddRank(sibling) == oddRank(parent);
+        if (siblingIsTwoChild || (oddRank(inner) == oddRank(sibling) && oddRank(outer) == oddRank(sibling)))
+        {
+            // Demote the parent (and a 1-child sibling whose children are both 2-children)
+            // and carry on above it
+            flipRank(parent);
+            if (!siblingIsTwoChild)
+            {
+                flipRank(sibling);
+            }
+            node = parent;
+            --i;
+            left = i > 0 && path[i - 1]->getLeft() == node;
+            continue;
+        }
+
+        TreeNode<T> *top;
+        if (oddRank(outer) != oddRank(sibling))
+        {
+            // The outer child is a 1-child: a single rotation, the sibling goes up a rank
+            // and the parent down one, or two if it ends up a leaf
+            top = left ? rotateLeft(parent) : rotateRight(parent);
+            flipRank(sibling);
+            if (!parent->isLeaf())
+            {
+                flipRank(parent);
+            }
+        }
+        else
+        {
+            // Double rotation: inner goes up two ranks, the sibling down one and the
+            // parent down two
+            if (left)
+            {
+                parent->linkRight(rotateRight(sibling));
+                top = rotateLeft(parent);
+            }
+            else
+            {
+                parent->linkLeft(rotateLeft(sibling));
+                top = rotateRight(parent);
+            }
+            flipRank(sibling);
+        }
+        this->replaceChild(i > 1 ? path[i - 2] : nullptr, parent, top);
+        break;
+    }
+    this->updatePath(path, i > 0 ? i - 1 : 0, -1);
+}
+
+template <typename T, typename Allocator>
+BinaryTree<T, Allocator> *WAVLTree<T, Allocator>::mergeImmutable(const BinaryTree<T, Allocator> &other) const
+{
+    WAVLTree<T, Allocator> *result = new WAVLTree<T, Allocator>(*this);
+    result->merge(other);
+    return result;
+}
+
+template <typename T, typename Allocator>
+void WAVLTree<T, Allocator>::rebuilt()
+{
+    rankByHeight(this->root);
+}
+
+template <typename T, typename Allocator>
+void WAVLTree<T, Allocator>::rankByHeight(TreeNode<T> *node)
+{
+    if (!node)
+    {
+        return;
+    }
+    node->setBalanceBit(node->getHeight() % 2 != 0);
+    rankByHeight(node->getLeft());
+    rankByHeight(node->getRight());
+}
+
+template <typename T, typename Allocator>
+int WAVLTree<T, Allocator>::checkedRank(const TreeNode<T> *node)
+{
+    if (!node)
+    {
+        return -1;
+    }
+    int left = checkedRank(node->getLeft());
+    int right = checkedRank(node->getRight());
+    if (left == -2 || right == -2)
+    {
+        return -2;
+    }
+    // A child of the other parity is one rank below, one of the same parity two
+    int fromLeft = left + (oddRank(node->getLeft()) != oddRank(node) ? 1 : 2);
+    int fromRight = right + (oddRank(node->getRight()) != oddRank(node) ? 1 : 2);
+    if (fromLeft != fromRight || (!node->getLeft() && !node->getRight() && fromLeft != 0))
+    {
+        return -2;
+    }
+    return fromLeft;
+}
+
+template <typename T, typename Allocator>
+bool WAVLTree<T, Allocator>::isBalanced() const
+{
+    if (!this->root)
+    {
+        return true;
+    }
+    if (checkedRank(this->root) == -2)
+    {
+        return false;
+    }
+    return this->root->getHeight() <= 2 * std::log2(this->root->getSize() + 1);
+}
@@ -2,120 +2,197 @@
 #include <queue>
 #include <sstream>
 #include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
 #include <typeinfo>
 #include <unordered_set>
 
-template <typename T>
-BinaryTree<T>::BinaryTree() : root(nullptr) {}
+template <typename T, typename Allocator>
+BinaryTree<T, Allocator>::BinaryTree() : root(nullptr) {}
 
-template <typename T>
-BinaryTree<T>::BinaryTree(const BinaryTree<T> &other)
+template <typename T, typename Allocator>
+BinaryTree<T, Allocator>::BinaryTree(const BinaryTree<T, Allocator> &other)
 {
-    root = other.root ? other.root->clone() : nullptr;
+    root = cloneNodes(other.root);
+    isOrdered = other.isOrdered;
 }
 
-template <typename T>
-BinaryTree<T>::~BinaryTree()
+template <typename T, typename Allocator>
+BinaryTree<T, Allocator>::BinaryTree(BinaryTree<T, Allocator> &&other) noexcept
+    : root(other.root), nodeAllocator(std::move(other.nodeAllocator)), isThreaded(other.isThreaded),
+      isOrdered(other.isOrdered), threadedOrder(std::move(other.threadedOrder))
+{
+    other.root = nullptr;
+    other.isThreaded = false;
+    other.isOrdered = true;
+}
+
+template <typename T, typename Allocator>
+BinaryTree<T, Allocator>::~BinaryTree()
 {
     clear();
 }
 
-template <typename T>
-TreeNode<T> *BinaryTree<T>::findParent(TreeNode<T> *node) const
+template <typename T, typename Allocator>
+TreeNode<T> *BinaryTree<T, Allocator>::findParent(TreeNode<T> *node) const
 {
     if (!root || !node || node == root)
         return nullptr;
 
-    return node->getParent(root);
+    // The key descent only finds the node where insert(value) would have put it
+    if (isOrdered)
+    {
+        TreeNode<T> *parent = node->getParent(root);
+        if (parent)
+            return parent;
+    }
+
+    std::vector<TreeNode<T> *> stack = {root};
+    while (!stack.empty())
+    {
+        TreeNode<T> *current = stack.back();
+        stack.pop_back();
+        TreeNode<T> *left = current->hasLeftThread() ? nullptr : current->getLeft();
+        TreeNode<T> *right = current->hasRightThread() ? nullptr : current->getRight();
+        if (left == node || right == node)
+            return current;
+        if (left)
+            stack.push_back(left);
+        if (right)
+            stack.push_back(right);
+    }
+    return nullptr;
 }
 
-template <typename T>
-void BinaryTree<T>::remove(const T &value)
+template <typename T, typename Allocator>
+void BinaryTree<T, Allocator>::remove(const T &value)
 {
-    isThreaded = false;
-    TreeNode<T> *nodeToRemove = search(value);
-    if (!nodeToRemove)
+    removeThreads();
+    if (isOrdered)
     {
-        throw std::runtime_error("Value not found");
+        removeOrdered(value);
     }
+    else
+    {
+        removeUnordered(value);
+    }
+}
 
-    std::queue<TreeNode<T> *> q;
-    TreeNode<T> *temp = nullptr;
-    q.push(root);
-    while (!q.empty())
+template <typename T, typename Allocator>
+void BinaryTree<T, Allocator>::unlink(TreeNode<T> *parent, TreeNode<T> *node, TreeNode<T> *replacement)
+{
+    if (!parent)
     {
-        temp = q.front();
-        q.pop();
-        if (temp->getLeft() != nullptr)
-        {
-            q.push(temp->getLeft());
-        }
-        if (temp->getRight() != nullptr)
-        {
-            q.push(temp->getRight());
-        }
+        root = replacement;
+    }
+    else if (parent->getLeft() == node)
+    {
+        parent->setLeft(replacement);
+    }
+    else
+    {
+        parent->setRight(replacement);
     }
+}
 
-    TreeNode<T> *parent = findParent(temp);
+template <typename T, typename Allocator>
+void BinaryTree<T, Allocator>::removeOrdered(const T &value)
+{
+    const TreeNode<T> *constParent = nullptr;
+    TreeNode<T> *node = const_cast<TreeNode<T> *>(orderedSearch(value, constParent));
+    TreeNode<T> *parent = const_cast<TreeNode<T> *>(constParent);
+    if (!node)
+    {
+        throw std::runtime_error("Value not found");
+    }
 
-    if (nodeToRemove == temp)
+    if (node->getLeft() && node->getRight())
     {
-        if (parent)
-        {
-            if (parent->getLeft() == temp)
-            {
-                parent->setLeft(nullptr);
-            }
-            else
-            {
-                parent->setRight(nullptr);
-            }
-        }
-        else
+        // The in-order successor is the smallest key not below node, so it can take
+        // node's place without breaking left <= node <= right
+        TreeNode<T> *successorParent = node;
+        TreeNode<T> *successor = node->getRight();
+        while (successor->getLeft())
         {
-            root = nullptr;
+            successorParent = successor;
+            successor = successor->getLeft();
         }
-
-        temp->setLeft(nullptr);
-        temp->setRight(nullptr);
-        delete temp;
-        return;
+        node->setData(successor->getData());
+        node = successor;
+        parent = successorParent;
     }
 
-    T dataDeepestRight = temp->getData();
+    unlink(parent, node, node->getLeft() ? node->getLeft() : node->getRight());
+    nodeAllocator.retire(node);
+}
 
-    if (parent)
+template <typename T, typename Allocator>
+void BinaryTree<T, Allocator>::removeUnordered(const T &value)
+{
+    // One breadth-first pass finds the first matching node and the last node in level
+    // order (the deepest one), together with its parent
+    TreeNode<T> *target = nullptr;
+    TreeNode<T> *last = nullptr;
+    TreeNode<T> *lastParent = nullptr;
+    std::queue<std::pair<TreeNode<T> *, TreeNode<T> *>> q;
+    if (root)
     {
-        if (parent->getLeft() == temp)
+        q.push(std::make_pair(root, static_cast<TreeNode<T> *>(nullptr)));
+    }
+    while (!q.empty())
+    {
+        last = q.front().first;
+        lastParent = q.front().second;
+        q.pop();
+        if (!target && last->getData() == value)
         {
-            parent->setLeft(nullptr);
+            target = last;
         }
-        else
+        if (last->getLeft())
         {
-            parent->setRight(nullptr);
+            q.push(std::make_pair(last->getLeft(), last));
         }
+        if (last->getRight())
+        {
+            q.push(std::make_pair(last->getRight(), last));
+        }
+    }
+
+    if (!target)
+    {
+        throw std::runtime_error("Value not found");
     }
 
-    nodeToRemove->setData(dataDeepestRight);
-    temp->setLeft(nullptr);
-    temp->setRight(nullptr);
-    delete temp;
+    if (target != last)
+    {
+        target->setData(last->getData());
+    }
+    unlink(lastParent, last, nullptr);
+    nodeAllocator.retire(last);
 }
 
-template <typename T>
-TreeNode<T> *BinaryTree<T>::getRoot()
+template <typename T, typename Allocator>
+TreeNode<T> *BinaryTree<T, Allocator>::getRoot()
 {
     return root;
 }
 
-template <typename T>
-const TreeNode<T> *BinaryTree<T>::getRoot() const
+template <typename T, typename Allocator>
+const TreeNode<T> *BinaryTree<T, Allocator>::getRoot() const
 {
     return root;
 }
 
-template <typename T>
-void BinaryTree<T>::insert(const T &value)
+template <typename T, typename Allocator>
+const Allocator &BinaryTree<T, Allocator>::getAllocator() const
+{
+    return nodeAllocator;
+}
+
+template <typename T, typename Allocator>
+void BinaryTree<T, Allocator>::insert(const T &value)
 {
     if (isThreaded)
     {
@@ -144,7 +221,7 @@ void BinaryTree<T>::insert(const T &value)
 
     if (!root)
     {
-        root = new TreeNode<T>(value);
+        root = nodeAllocator.create(value);
         return;
     }
 
@@ -155,7 +232,7 @@ void BinaryTree<T>::insert(const T &value)
         {
             if (!current->getLeft())
             {
-                current->setLeft(new TreeNode<T>(value));
+                current->setLeft(nodeAllocator.create(value));
                 return;
             }
             current = current->getLeft();
@@ -164,7 +241,7 @@ void BinaryTree<T>::insert(const T &value)
         {
             if (!current->getRight())
             {
-                current->setRight(new TreeNode<T>(value));
+                current->setRight(nodeAllocator.create(value));
                 return;
             }
             current = current->getRight();
@@ -172,19 +249,20 @@ void BinaryTree<T>::insert(const T &value)
     }
 }
 
-template <typename T>
-void BinaryTree<T>::insert(const T &value, TreeNode<T> *startingRoot)
+template <typename T, typename Allocator>
+void BinaryTree<T, Allocator>::insert(const T &value, TreeNode<T> *startingRoot)
 {
     isThreaded = false;
     if (!startingRoot)
     {
         if (!root)
         {
-            root = new TreeNode<T>(value);
+            root = nodeAllocator.create(value);
         }
         return;
     }
 
+    isOrdered = false;
     std::queue<TreeNode<T> *> q;
     q.push(startingRoot);
 
@@ -195,7 +273,7 @@ void BinaryTree<T>::insert(const T &value, TreeNode<T> *startingRoot)
 
         if (!current->getLeft())
         {
-            current->setLeft(new TreeNode<T>(value));
+            current->setLeft(nodeAllocator.create(value));
             return;
         }
         else
@@ -205,7 +283,7 @@ void BinaryTree<T>::insert(const T &value, TreeNode<T> *startingRoot)
 
         if (!current->getRight())
         {
-            current->setRight(new TreeNode<T>(value));
+            current->setRight(nodeAllocator.create(value));
             return;
         }
         else
@@ -215,14 +293,19 @@ void BinaryTree<T>::insert(const T &value, TreeNode<T> *startingRoot)
     }
 }
 
-template <typename T>
-const TreeNode<T> *BinaryTree<T>::search(const T &value) const
+template <typename T, typename Allocator>
+const TreeNode<T> *BinaryTree<T, Allocator>::search(const T &value) const
 {
     if (!root)
     {
         return nullptr;
     }
 
+    if (isOrdered)
+    {
+        return orderedSearch(value);
+    }
+
     std::queue<TreeNode<T> *> q;
     q.push(root);
 
@@ -244,14 +327,19 @@ const TreeNode<T> *BinaryTree<T>::search(const T &value) const
     return nullptr;
 }
 
-template <typename T>
-TreeNode<T> *BinaryTree<T>::search(const T &value)
+template <typename T, typename Allocator>
+TreeNode<T> *BinaryTree<T, Allocator>::search(const T &value)
 {
     if (!root)
     {
         return nullptr;
     }
 
+    if (isOrdered)
+    {
+        return const_cast<TreeNode<T> *>(orderedSearch(value));
+    }
+
     if (root->getData() == value)
     {
         return root;
@@ -278,37 +366,184 @@ TreeNode<T> *BinaryTree<T>::search(const T &value)
     return nullptr;
 }
 
-template <typename T>
-bool BinaryTree<T>::hasValue(const T &value) const
+template <typename T, typename Allocator>
+const TreeNode<T> *BinaryTree<T, Allocator>::orderedSearch(const T &value) const
+{
+    const TreeNode<T> *parent = nullptr;
+    return orderedSearch(value, parent);
+}
+
+template <typename T, typename Allocator>
+const TreeNode<T> *BinaryTree<T, Allocator>::orderedSearch(const T &value, const TreeNode<T> *&parent) const
+{
+    // Types such as Complex and Person order by a key (magnitude, age) that is coarser
+    // than operator==, so a node that is neither less nor greater may still differ.
+    // Such equivalent nodes can sit on both sides after balance(), keep them on a stack.
+    std::vector<std::pair<const TreeNode<T> *, const TreeNode<T> *>> pending;
+    const TreeNode<T> *current = root;
+    parent = nullptr;
+
+    while (current || !pending.empty())
+    {
+        if (!current)
+        {
+            current = pending.back().first;
+            parent = pending.back().second;
+            pending.pop_back();
+        }
+
+        const TreeNode<T> *left = current->hasLeftThread() ? nullptr : current->getLeft();
+        const TreeNode<T> *right = current->hasRightThread() ? nullptr : current->getRight();
+
+        if (value < current->getData())
+        {
+            parent = current;
+            current = left;
+        }
+        else if (value > current->getData())
+        {
+            parent = current;
+            current = right;
+        }
+        else if (current->getData() == value)
+        {
+            return current;
+        }
+        else
+        {
+            if (left)
+                pending.push_back(std::make_pair(left, current));
+            parent = current;
+            current = right;
+        }
+    }
+
+    parent = nullptr;
+    return nullptr;
+}
+
+template <typename T, typename Allocator>
+bool BinaryTree<T, Allocator>::hasValue(const T &value) const
 {
     return search(value) != nullptr;
 }
 
-template <typename T>
-int BinaryTree<T>::getHeight() const
+template <typename T, typename Allocator>
+std::vector<bool> BinaryTree<T, Allocator>::hasValues(const std::vector<T> &values) const
+{
+    std::vector<const TreeNode<T> *> nodes = searchBatch(values);
+    std::vector<bool> found(nodes.size());
+    for (size_t i = 0; i < nodes.size(); ++i)
+    {
+        found[i] = nodes[i] != nullptr;
+    }
+    return found;
+}
+
+template <typename T, typename Allocator>
+std::vector<const TreeNode<T> *> BinaryTree<T, Allocator>::searchBatch(const std::vector<T> &values) const
+{
+    std::vector<const TreeNode<T> *> results(values.size(), nullptr);
+    if (!root)
+    {
+        return results;
+    }
+    if (!isOrdered)
+    {
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            results[i] = search(values[i]);
+        }
+        return results;
+    }
+
+    struct Lane
+    {
+        const TreeNode<T> *node;
+        size_t query;
+    };
+    Lane lanes[batchLanes];
+    size_t active = 0;
+    size_t next = 0;
+    while (active < batchLanes && next < values.size())
+    {
+        lanes[active++] = {root, next++};
+    }
+
+    // Each round moves every lane one level down; by the time a lane comes round
+    // again the node it prefetched has had the other lanes' work to arrive
+    while (active > 0)
+    {
+        size_t i = 0;
+        while (i < active)
+        {
+            Lane &lane = lanes[i];
+            const TreeNode<T> *node = lane.node;
+            const T &value = values[lane.query];
+            bool done = node == nullptr;
+
+            if (!done && value < node->getData())
+            {
+                node = node->hasLeftThread() ? nullptr : node->getLeft();
+            }
+            else if (!done && value > node->getData())
+            {
+                node = node->hasRightThread() ? nullptr : node->getRight();
+            }
+            else if (!done)
+            {
+                // Equivalent but not equal keys may sit in both subtrees, leave those
+                // to the full search
+                results[lane.query] = node->getData() == value ? node : orderedSearch(value);
+                done = true;
+            }
+
+            if (!done)
+            {
+                if (node)
+                {
+                    tree_detail::prefetch(node);
+                }
+                lane.node = node;
+                ++i;
+            }
+            else if (next < values.size())
+            {
+                lane = {root, next++};
+                ++i;
+            }
+            else
+            {
+                lane = lanes[--active];
+            }
+        }
+    }
+    return results;
+}
+
+template <typename T, typename Allocator>
+int BinaryTree<T, Allocator>::getHeight() const
 {
     return root ? root->getHeight() : throw std::runtime_error("Tree is empty");
 }
 
-template <typename T>
-bool BinaryTree<T>::isEmpty() const
+template <typename T, typename Allocator>
+bool BinaryTree<T, Allocator>::isEmpty() const
 {
     return root == nullptr;
 }
 
-template <typename T>
-void BinaryTree<T>::clear()
+template <typename T, typename Allocator>
+void BinaryTree<T, Allocator>::clear()
 {
     isThreaded = false;
-    if (root)
-    {
-        delete root;
-        root = nullptr;
-    }
+    isOrdered = true;
+    nodeAllocator.destroyAll(root);
+    root = nullptr;
 }
 
-template <typename T>
-void BinaryTree<T>::print(std::ostream &os) const
+template <typename T, typename Allocator>
+void BinaryTree<T, Allocator>::print(std::ostream &os) const
 {
     if (!root)
     {
@@ -358,8 +593,8 @@ void BinaryTree<T>::print(std::ostream &os) const
     }
 }
 
-template <typename T>
-void BinaryTree<T>::inorderTraversal(std::ostream &os) const
+template <typename T, typename Allocator>
+void BinaryTree<T, Allocator>::inorderTraversal(std::ostream &os) const
 {
     for (auto it = cbegin("inorder"); it != cend("inorder"); ++it)
     {
@@ -367,8 +602,8 @@ void BinaryTree<T>::inorderTraversal(std::ostream &os) const
     }
 }
 
-template <typename T>
-void BinaryTree<T>::inorderTraversal(const TreeNode<T> *node, std::ostream &os) const
+template <typename T, typename Allocator>
+void BinaryTree<T, Allocator>::inorderTraversal(const TreeNode<T> *node, std::ostream &os) const
 {
     if (!node)
     {
@@ -381,8 +616,8 @@ void BinaryTree<T>::inorderTraversal(const TreeNode<T> *node, std::ostream &os)
     }
 }
 
-template <typename T>
-void BinaryTree<T>::preorderTraversal(std::ostream &os) const
+template <typename T, typename Allocator>
+void BinaryTree<T, Allocator>::preorderTraversal(std::ostream &os) const
 {
     for (auto it = cbegin("preorder"); it != cend("preorder"); ++it)
     {
@@ -390,8 +625,8 @@ void BinaryTree<T>::preorderTraversal(std::ostream &os) const
     }
 }
 
-template <typename T>
-void BinaryTree<T>::preorderTraversal(const TreeNode<T> *node, std::ostream &os) const
+template <typename T, typename Allocator>
+void BinaryTree<T, Allocator>::preorderTraversal(const TreeNode<T> *node, std::ostream &os) const
 {
     if (!node)
     {
@@ -404,8 +639,8 @@ void BinaryTree<T>::preorderTraversal(const TreeNode<T> *node, std::ostream &os)
     }
 }
 
-template <typename T>
-void BinaryTree<T>::postorderTraversal(std::ostream &os) const
+template <typename T, typename Allocator>
+void BinaryTree<T, Allocator>::postorderTraversal(std::ostream &os) const
 {
     for (auto it = cbegin("postorder"); it != cend("postorder"); ++it)
     {
@@ -413,8 +648,8 @@ void BinaryTree<T>::postorderTraversal(std::ostream &os) const
     }
 }
 
-template <typename T>
-void BinaryTree<T>::postorderTraversal(const TreeNode<T> *node, std::ostream &os) const
+template <typename T, typename Allocator>
+void BinaryTree<T, Allocator>::postorderTraversal(const TreeNode<T> *node, std::ostream &os) const
 {
     if (!node)
     {
@@ -427,58 +662,53 @@ void BinaryTree<T>::postorderTraversal(const TreeNode<T> *node, std::ostream &os
     }
 }
 
-template <typename T>
-const TreeNode<T> *BinaryTree<T>::getMaxNode() const
+template <typename T, typename Allocator>
+const TreeNode<T> *BinaryTree<T, Allocator>::getMaxNode() const
 {
     if (!root)
     {
         return nullptr;
     }
-    const TreeNode<T> *max = root;
-    getMaxHelper(root, max);
-    return max;
-}
-
-template <typename T>
-TreeNode<T> *BinaryTree<T>::getMaxNode()
-{
-    if (!root)
+    // In an ordered tree the maximum is the rightmost node, no need to visit the rest
+    if (isOrdered)
     {
-        return nullptr;
+        return root->getMax();
     }
     TreeNode<T> *max = root;
     getMaxHelper(root, max);
     return max;
 }
 
-template <typename T>
-const T &BinaryTree<T>::getMax() const
+template <typename T, typename Allocator>
+TreeNode<T> *BinaryTree<T, Allocator>::getMaxNode()
 {
-    if (!root)
+    return const_cast<TreeNode<T> *>(static_cast<const BinaryTree<T, Allocator> *>(this)->getMaxNode());
+}
+
+template <typename T, typename Allocator>
+const T &BinaryTree<T, Allocator>::getMax() const
+{
+    const TreeNode<T> *max = getMaxNode();
+    if (!max)
     {
         throw std::runtime_error("Tree is empty");
     }
-    const TreeNode<T> *max = root;
-    getMaxHelper(root, max);
-
     return max->getData();
 }
 
-template <typename T>
-T &BinaryTree<T>::getMax()
+template <typename T, typename Allocator>
+T &BinaryTree<T, Allocator>::getMax()
 {
-    if (!root)
+    TreeNode<T> *max = getMaxNode();
+    if (!max)
     {
         throw std::runtime_error("Tree is empty");
     }
-    TreeNode<T> *max = root;
-    getMaxHelper(root, max);
-
     return max->getData();
 }
 
-template <typename T>
-void BinaryTree<T>::getMaxHelper(TreeNode<T> *node, TreeNode<T> *&max) const
+template <typename T, typename Allocator>
+void BinaryTree<T, Allocator>::getMaxHelper(TreeNode<T> *node, TreeNode<T> *&max) const
 {
     if (!node)
     {
@@ -492,58 +722,53 @@ void BinaryTree<T>::getMaxHelper(TreeNode<T> *node, TreeNode<T> *&max) const
     getMaxHelper(node->getRight(), max);
 }
 
-template <typename T>
-const TreeNode<T> *BinaryTree<T>::getMinNode() const
+template <typename T, typename Allocator>
+const TreeNode<T> *BinaryTree<T, Allocator>::getMinNode() const
 {
     if (!root)
     {
         return nullptr;
     }
-    const TreeNode<T> *min = root;
-    getMinHelper(root, min);
-    return min;
-}
-
-template <typename T>
-TreeNode<T> *BinaryTree<T>::getMinNode()
-{
-    if (!root)
+    // In an ordered tree the minimum is the leftmost node, no need to visit the rest
+    if (isOrdered)
     {
-        return nullptr;
+        return root->getMin();
     }
     TreeNode<T> *min = root;
     getMinHelper(root, min);
     return min;
 }
 
-template <typename T>
-const T &BinaryTree<T>::getMin() const
+template <typename T, typename Allocator>
+TreeNode<T> *BinaryTree<T, Allocator>::getMinNode()
 {
-    if (!root)
+    return const_cast<TreeNode<T> *>(static_cast<const BinaryTree<T, Allocator> *>(this)->getMinNode());
+}
+
+template <typename T, typename Allocator>
+const T &BinaryTree<T, Allocator>::getMin() const
+{
+    const TreeNode<T> *min = getMinNode();
+    if (!min)
     {
         throw std::runtime_error("Tree is empty");
     }
-    const TreeNode<T> *min = root;
-    getMinHelper(root, min);
-
     return min->getData();
 }
 
-template <typename T>
-T &BinaryTree<T>::getMin()
+template <typename T, typename Allocator>
+T &BinaryTree<T, Allocator>::getMin()
 {
-    if (!root)
+    TreeNode<T> *min = getMinNode();
+    if (!min)
     {
         throw std::runtime_error("Tree is empty");
     }
-    TreeNode<T> *min = root;
-    getMinHelper(root, min);
-
     return min->getData();
 }
 
-template <typename T>
-void BinaryTree<T>::getMinHelper(TreeNode<T> *node, TreeNode<T> *&min) const
+template <typename T, typename Allocator>
+void BinaryTree<T, Allocator>::getMinHelper(TreeNode<T> *node, TreeNode<T> *&min) const
 {
     if (!node)
     {
@@ -558,14 +783,14 @@ void BinaryTree<T>::getMinHelper(TreeNode<T> *node, TreeNode<T> *&min) const
     getMinHelper(node->getRight(), min);
 }
 
-template <typename T>
-bool BinaryTree<T>::isBalanced() const
+template <typename T, typename Allocator>
+bool BinaryTree<T, Allocator>::isBalanced() const
 {
     return isBalancedHelper(root) != -1;
 }
 
-template <typename T>
-int BinaryTree<T>::isBalancedHelper(const TreeNode<T> *node) const
+template <typename T, typename Allocator>
+int BinaryTree<T, Allocator>::isBalancedHelper(const TreeNode<T> *node) const
 {
     if (!node)
         return 0;
@@ -580,8 +805,8 @@ int BinaryTree<T>::isBalancedHelper(const TreeNode<T> *node) const
     return 1 + std::max(lh, rh);
 }
 
-template <typename T>
-void BinaryTree<T>::inorderTraversal(TreeNode<T> *node, std::vector<TreeNode<T> *> &nodes)
+template <typename T, typename Allocator>
+void BinaryTree<T, Allocator>::inorderTraversal(TreeNode<T> *node, std::vector<TreeNode<T> *> &nodes)
 {
     if (!node)
     {
@@ -592,8 +817,8 @@ void BinaryTree<T>::inorderTraversal(TreeNode<T> *node, std::vector<TreeNode<T>
     inorderTraversal(node->getRight(), nodes);
 }
 
-template <typename T>
-TreeNode<T> *BinaryTree<T>::buildBalancedTree(std::vector<TreeNode<T> *> &nodes, int start, int end)
+template <typename T, typename Allocator>
+TreeNode<T> *BinaryTree<T, Allocator>::buildBalancedTree(std::vector<TreeNode<T> *> &nodes, int start, int end)
 {
     if (start > end)
     {
@@ -607,20 +832,252 @@ TreeNode<T> *BinaryTree<T>::buildBalancedTree(std::vector<TreeNode<T> *> &nodes,
     return node;
 }
 
-template <typename T>
-TreeNode<T> *BinaryTree<T>::buildBalancedTreeFromValues(const std::vector<T> &values, int start, int end)
+template <typename T, typename Allocator>
+TreeNode<T> *BinaryTree<T, Allocator>::cloneNodes(const TreeNode<T> *node)
+{
+    if (!node)
+    {
+        return nullptr;
+    }
+
+    TreeNode<T> *copy = nodeAllocator.create(node->getData());
+    if (!node->hasLeftThread())
+    {
+        copy->setLeft(cloneNodes(node->getLeft()));
+    }
+    if (!node->hasRightThread())
+    {
+        copy->setRight(cloneNodes(node->getRight()));
+    }
+    copy->setHeight(node->getHeight());
+    copy->setBalanceBit(node->getBalanceBit());
+    return copy;
+}
+
+template <typename T, typename Allocator>
+typename BinaryTree<T, Allocator>::ConstIterator BinaryTree<T, Allocator>::boundOf(const T &value, bool strict) const
+{
+    if (!isOrdered)
+    {
+        throw std::logic_error("Tree is not ordered");
+    }
+
+    // The path down to the last node where the search turned left is exactly the
+    // iterator state for that node
+    std::vector<const TreeNode<T> *> path;
+    size_t keep = 0;
+    const TreeNode<T> *node = root;
+    while (node)
+    {
+        path.push_back(node);
+        bool atOrAbove = strict ? value < node->getData() : !(node->getData() < value);
+        if (atOrAbove)
+        {
+            keep = path.size();
+            node = node->hasLeftThread() ? nullptr : node->getLeft();
+        }
+        else
+        {
+            node = node->hasRightThread() ? nullptr : node->getRight();
+        }
+    }
+    path.resize(keep);
+    return ConstIterator(root, TraversalOrder::Inorder, path);
+}
+
+template <typename T, typename Allocator>
+typename BinaryTree<T, Allocator>::ConstIterator BinaryTree<T, Allocator>::lowerBound(const T &value) const
+{
+    return boundOf(value, false);
+}
+
+template <typename T, typename Allocator>
+typename BinaryTree<T, Allocator>::ConstIterator BinaryTree<T, Allocator>::upperBound(const T &value) const
+{
+    return boundOf(value, true);
+}
+
+template <typename T, typename Allocator>
+std::pair<typename BinaryTree<T, Allocator>::ConstIterator, typename BinaryTree<T, Allocator>::ConstIterator>
+BinaryTree<T, Allocator>::equalRange(const T &value) const
+{
+    return std::make_pair(boundOf(value, false), boundOf(value, true));
+}
+
+template <typename T, typename Allocator>
+void BinaryTree<T, Allocator>::forEachInRange(const T &lo, const T &hi, std::function<void(const T &)> visitor) const
+{
+    ConstIterator last = cend();
+    for (ConstIterator it = lowerBound(lo); it != last && !(hi < *it); ++it)
+    {
+        visitor(*it);
+    }
+}
+
+template <typename T, typename Allocator>
+FrozenTree<T> BinaryTree<T, Allocator>::freeze() const
+{
+    std::vector<T> values;
+    for (auto it = cbegin(); it != cend(); ++it)
+    {
+        values.push_back(*it);
+    }
+    return FrozenTree<T>(std::move(values));
+}
+
+template <typename T, typename Allocator>
+StaticSearchTree<T> BinaryTree<T, Allocator>::freezeSimd(SimdLevel level) const
+{
+    std::vector<T> values;
+    for (auto it = cbegin(); it != cend(); ++it)
+    {
+        values.push_back(*it);
+    }
+    return StaticSearchTree<T>(std::move(values), level);
+}
+
+template <typename T, typename Allocator>
+void BinaryTree<T, Allocator>::destroyNodes(TreeNode<T> *node)
+{
+    std::vector<TreeNode<T> *> stack;
+    if (node)
+    {
+        stack.push_back(node);
+    }
+    while (!stack.empty())
+    {
+        TreeNode<T> *current = stack.back();
+        stack.pop_back();
+        if (current->getLeft() && !current->hasLeftThread())
+            stack.push_back(current->getLeft());
+        if (current->getRight() && !current->hasRightThread())
+            stack.push_back(current->getRight());
+        nodeAllocator.destroy(current);
+    }
+}
+
+template <typename T, typename Allocator>
+void BinaryTree<T, Allocator>::removeThreads()
+{
+    if (!isThreaded)
+    {
+        return;
+    }
+
+    std::vector<TreeNode<T> *> stack;
+    if (root)
+    {
+        stack.push_back(root);
+    }
+    while (!stack.empty())
+    {
+        TreeNode<T> *current = stack.back();
+        stack.pop_back();
+        if (current->hasLeftThread())
+            current->setLeft(nullptr);
+        else if (current->getLeft())
+            stack.push_back(current->getLeft());
+        if (current->hasRightThread())
+            current->setRight(nullptr);
+        else if (current->getRight())
+            stack.push_back(current->getRight());
+    }
+    isThreaded = false;
+}
+
+template <typename T, typename Allocator>
+TreeNode<T> *BinaryTree<T, Allocator>::buildBalancedTreeFromValues(const std::vector<T> &values, int start, int end)
 {
     if (start > end)
         return nullptr;
     int mid = start + (end - start) / 2;
-    TreeNode<T> *node = new TreeNode<T>(values[mid]);
+    TreeNode<T> *node = nodeAllocator.create(values[mid]);
     node->setLeft(buildBalancedTreeFromValues(values, start, mid - 1));
     node->setRight(buildBalancedTreeFromValues(values, mid + 1, end));
     return node;
 }
 
-template <typename T>
-void BinaryTree<T>::balance()
+template <typename T, typename Allocator>
+TreeNode<T> *BinaryTree<T, Allocator>::rotateLeft(TreeNode<T> *x)
+{
+    TreeNode<T> *y = x->getRight();
+    TreeNode<T> *T2 = y->getLeft();
+
+    // Child first, so that y picks up x's new height and size
+    x->linkRight(T2);
+    x->update();
+    y->linkLeft(x);
+    y->update();
+
+    return y;
+}
+
+template <typename T, typename Allocator>
+TreeNode<T> *BinaryTree<T, Allocator>::rotateRight(TreeNode<T> *y)
+{
+    TreeNode<T> *x = y->getLeft();
+    TreeNode<T> *T2 = x->getRight();
+
+    y->linkLeft(T2);
+    y->update();
+    x->linkRight(y);
+    x->update();
+
+    return x;
+}
+
+template <typename T, typename Allocator>
+void BinaryTree<T, Allocator>::replaceChild(TreeNode<T> *parent, TreeNode<T> *node, TreeNode<T> *replacement)
+{
+    if (!parent)
+    {
+        root = replacement;
+    }
+    else if (parent->getLeft() == node)
+    {
+        parent->linkLeft(replacement);
+    }
+    else
+    {
+        parent->linkRight(replacement);
+    }
+}
+
+template <typename T, typename Allocator>
+std::vector<TreeNode<T> *> &BinaryTree<T, Allocator>::pathBuffer()
+{
+    // Reused across calls so that an insert or remove does not allocate for its path
+    static thread_local std::vector<TreeNode<T> *> path;
+    path.clear();
+    return path;
+}
+
+template <typename T, typename Allocator>
+void BinaryTree<T, Allocator>::updatePath(const std::vector<TreeNode<T> *> &path, size_t count, int sizeDelta)
+{
+    bool heightsChanging = true;
+    for (size_t i = count; i-- > 0;)
+    {
+        TreeNode<T> *node = path[i];
+        if (heightsChanging)
+        {
+            int oldHeight = node->getHeight();
+            node->update();
+            heightsChanging = node->getHeight() != oldHeight;
+        }
+        else if (sizeDelta == 0)
+        {
+            return;
+        }
+        else
+        {
+            node->setSize(node->getSize() + sizeDelta);
+        }
+    }
+}
+
+template <typename T, typename Allocator>
+void BinaryTree<T, Allocator>::balance()
 {
     if (!root)
         return;
@@ -634,12 +1091,15 @@ void BinaryTree<T>::balance()
         inorder(node->getRight());
     };
     inorder(root);
+    bool wasOrdered = isOrdered;
     clear();
     root = buildBalancedTreeFromValues(values, 0, values.size() - 1);
+    isOrdered = wasOrdered;
+    rebuilt();
 }
 
-template <typename T>
-BinaryTree<T> *BinaryTree<T>::subtree(const T &value) const
+template <typename T, typename Allocator>
+BinaryTree<T, Allocator> *BinaryTree<T, Allocator>::subtree(const T &value) const
 {
     const TreeNode<T> *node = search(value);
     if (!node)
@@ -647,13 +1107,14 @@ BinaryTree<T> *BinaryTree<T>::subtree(const T &value) const
         throw std::runtime_error("Value not found in tree");
     }
 
-    BinaryTree<T> *subtree = new BinaryTree<T>();
-    subtree->root = node->clone();
+    BinaryTree<T, Allocator> *subtree = new BinaryTree<T, Allocator>();
+    subtree->root = subtree->cloneNodes(node);
+    subtree->isOrdered = isOrdered;
     return subtree;
 }
 
-template <typename T>
-bool BinaryTree<T>::operator==(const BinaryTree<T> &other) const
+template <typename T, typename Allocator>
+bool BinaryTree<T, Allocator>::operator==(const BinaryTree<T, Allocator> &other) const
 {
     if (this == &other)
     {
@@ -666,14 +1127,14 @@ bool BinaryTree<T>::operator==(const BinaryTree<T> &other) const
     return *root == *other.root;
 }
 
-template <typename T>
-bool BinaryTree<T>::operator!=(const BinaryTree<T> &other) const
+template <typename T, typename Allocator>
+bool BinaryTree<T, Allocator>::operator!=(const BinaryTree<T, Allocator> &other) const
 {
     return !(*this == other);
 }
 
-template <typename T>
-BinaryTree<T> &BinaryTree<T>::operator=(const BinaryTree<T> &other)
+template <typename T, typename Allocator>
+BinaryTree<T, Allocator> &BinaryTree<T, Allocator>::operator=(const BinaryTree<T, Allocator> &other)
 {
     if (this == &other)
     {
@@ -681,19 +1142,33 @@ BinaryTree<T> &BinaryTree<T>::operator=(const BinaryTree<T> &other)
     }
 
     clear();
-    if (other.root)
-    {
-        root = other.root->clone();
-    }
-    else
+    root = cloneNodes(other.root);
+    isOrdered = other.isOrdered;
+    return *this;
+}
+
+template <typename T, typename Allocator>
+BinaryTree<T, Allocator> &BinaryTree<T, Allocator>::operator=(BinaryTree<T, Allocator> &&other) noexcept
+{
+    if (this == &other)
     {
-        root = nullptr;
+        return *this;
     }
+
+    clear();
+    root = other.root;
+    nodeAllocator = std::move(other.nodeAllocator);
+    isThreaded = other.isThreaded;
+    isOrdered = other.isOrdered;
+    threadedOrder = std::move(other.threadedOrder);
+    other.root = nullptr;
+    other.isThreaded = false;
+    other.isOrdered = true;
     return *this;
 }
 
-template <typename T>
-bool BinaryTree<T>::containsSubtree(const BinaryTree &other) const
+template <typename T, typename Allocator>
+bool BinaryTree<T, Allocator>::containsSubtree(const BinaryTree &other) const
 {
     if (!other.root)
         return true;
@@ -722,8 +1197,8 @@ bool BinaryTree<T>::containsSubtree(const BinaryTree &other) const
     return false;
 }
 
-template <typename T>
-void BinaryTree<T>::makeThreaded(const std::string &traversalOrder)
+template <typename T, typename Allocator>
+void BinaryTree<T, Allocator>::makeThreaded(const std::string &traversalOrder)
 {
     if (!root)
     {
@@ -811,8 +1286,8 @@ void BinaryTree<T>::makeThreaded(const std::string &traversalOrder)
     threadedOrder = traversalOrder;
 }
 
-template <typename T>
-void BinaryTree<T>::traverseThreaded(std::function<void(T)> visit) const
+template <typename T, typename Allocator>
+void BinaryTree<T, Allocator>::traverseThreaded(std::function<void(T)> visit) const
 {
     if (!isThreaded)
         throw std::logic_error("Tree is not threaded");
@@ -876,105 +1351,322 @@ void BinaryTree<T>::traverseThreaded(std::function<void(T)> visit) const
     }
 }
 
-template <typename T>
-void BinaryTree<T>::merge(const BinaryTree<T> &other)
+template <typename T, typename Allocator>
+void BinaryTree<T, Allocator>::merge(const BinaryTree<T, Allocator> &other)
 {
+    if (&other == this)
+    {
+        // Iterators are invalidated by insert, merge a snapshot instead
+        BinaryTree<T, Allocator> copy(other);
+        merge(copy);
+        return;
+    }
+    if (isOrdered && other.isOrdered)
+    {
+        mergeOrdered(other, !allowsDuplicates());
+        return;
+    }
     for (auto it = other.cbegin(); it != other.cend(); ++it)
     {
         this->insert(*it);
     }
 }
 
-template <typename T>
-BinaryTree<T> *BinaryTree<T>::mergeImmutable(const BinaryTree<T> &other) const
+template <typename T, typename Allocator>
+void BinaryTree<T, Allocator>::mergeOrdered(const BinaryTree<T, Allocator> &other, bool unique)
 {
-    BinaryTree<T> *result = new BinaryTree<T>(*this);
+    std::vector<TreeNode<T> *> own;
+    for (auto it = begin(); it != end(); ++it)
+    {
+        own.push_back(it.path.back());
+    }
+
+    // Own nodes are relinked, only the other tree's values need new nodes. On ties our
+    // node goes first, matching insert(), which places an equal value to the right.
+    std::vector<TreeNode<T> *> merged;
+    merged.reserve(own.size());
+    size_t i = 0;
+    auto it = other.cbegin();
+    auto otherEnd = other.cend();
+    while (i < own.size() || it != otherEnd)
+    {
+        if (it == otherEnd || (i < own.size() && !(*it < own[i]->getData())))
+        {
+            merged.push_back(own[i++]);
+            continue;
+        }
+        const T &value = *it;
+        if (!unique || merged.empty() || merged.back()->getData() < value)
+        {
+            merged.push_back(nodeAllocator.create(value));
+        }
+        ++it;
+    }
+
+    isThreaded = false;
+    root = buildBalancedTree(merged, 0, static_cast<int>(merged.size()) - 1);
+    rebuilt();
+}
+
+template <typename T, typename Allocator>
+BinaryTree<T, Allocator> *BinaryTree<T, Allocator>::mergeImmutable(const BinaryTree<T, Allocator> &other) const
+{
+    BinaryTree<T, Allocator> *result = new BinaryTree<T, Allocator>(*this);
     result->merge(other);
     return result;
 }
 
-template <typename T>
-BinaryTree<T> BinaryTree<T>::operator+(const BinaryTree<T> &other) const
+template <typename T, typename Allocator>
+BinaryTree<T, Allocator> BinaryTree<T, Allocator>::operator+(const BinaryTree<T, Allocator> &other) const
 {
-    BinaryTree<T> result(*this);
+    BinaryTree<T, Allocator> result(*this);
     result.merge(other);
     return result;
 }
 
-template <typename T>
-typename BinaryTree<T>::Iterator BinaryTree<T>::begin(std::string order)
+template <typename T, typename Allocator>
+typename BinaryTree<T, Allocator>::Iterator BinaryTree<T, Allocator>::begin(std::string order)
 {
     return Iterator(root, order);
 }
 
-template <typename T>
-typename BinaryTree<T>::Iterator BinaryTree<T>::end(std::string order)
+template <typename T, typename Allocator>
+typename BinaryTree<T, Allocator>::Iterator BinaryTree<T, Allocator>::end(std::string order)
 {
-    Iterator it(nullptr, order);
-    if (root)
-    {
-        it = Iterator(root, order);
-        it.current = it.nodes.size();
-    }
-    return it;
+    return Iterator(root, parseTraversalOrder(order), {});
 }
 
-template <typename T>
-typename BinaryTree<T>::ConstIterator BinaryTree<T>::cbegin(std::string order) const
+template <typename T, typename Allocator>
+typename BinaryTree<T, Allocator>::ConstIterator BinaryTree<T, Allocator>::cbegin(std::string order) const
 {
     return ConstIterator(root, order);
 }
 
-template <typename T>
-typename BinaryTree<T>::ConstIterator BinaryTree<T>::cend(std::string order) const
+template <typename T, typename Allocator>
+typename BinaryTree<T, Allocator>::ConstIterator BinaryTree<T, Allocator>::cend(std::string order) const
 {
-    ConstIterator it(nullptr, order);
-    if (root)
+    return ConstIterator(root, parseTraversalOrder(order), {});
+}
+
+template <typename T, typename Allocator>
+std::vector<typename BinaryTree<T, Allocator>::TreePiece> BinaryTree<T, Allocator>::splitIntoPieces(unsigned threads) const
+{
+    std::vector<TreePiece> pieces;
+    if (!root)
+    {
+        return pieces;
+    }
+    pieces.push_back(TreePiece(root, true));
+    if (threads <= 1)
     {
-        it = ConstIterator(root, order);
-        it.current = it.nodes.size();
+        return pieces;
     }
-    return it;
+
+    // Node sizes are not kept up to date by every kind of insert, so subtrees are split
+    // level by level rather than largest first. A skewed tree just yields uneven
+    // pieces; a chain would only shed one node per level, hence the cap on pieces.
+    size_t wanted = static_cast<size_t>(threads) * piecesPerThread;
+    size_t subtrees = 1;
+    bool split = true;
+    while (split && subtrees < wanted && pieces.size() < 2 * wanted)
+    {
+        split = false;
+        std::vector<TreePiece> next;
+        for (const TreePiece &piece : pieces)
+        {
+            const TreeNode<T> *node = piece.first;
+            const TreeNode<T> *left = node->hasLeftThread() ? nullptr : node->getLeft();
+            const TreeNode<T> *right = node->hasRightThread() ? nullptr : node->getRight();
+            if (!piece.second || (!left && !right) || subtrees >= wanted)
+            {
+                next.push_back(piece);
+                continue;
+            }
+            split = true;
+            --subtrees;
+            if (left)
+            {
+                next.push_back(TreePiece(left, true));
+                ++subtrees;
+            }
+            next.push_back(TreePiece(node, false));
+            if (right)
+            {
+                next.push_back(TreePiece(right, true));
+                ++subtrees;
+            }
+        }
+        pieces.swap(next);
+    }
+    return pieces;
 }
 
-template <typename T>
-BinaryTree<T> BinaryTree<T>::apply(std::function<T(T)> func) const
+template <typename T, typename Allocator>
+template <typename Visit>
+void BinaryTree<T, Allocator>::visitPiece(const TreePiece &piece, Visit visit) const
 {
-    BinaryTree<T> result;
-    for (auto it = cbegin("preorder"); it != cend("preorder"); ++it)
+    if (!piece.second)
     {
-        result.insert(func(*it));
+        visit(piece.first->getData());
+        return;
+    }
+    for (auto it = cbegin(piece.first); it != cend(piece.first); ++it)
+    {
+        visit(*it);
     }
-    return result;
 }
 
-template <typename T>
-BinaryTree<T> BinaryTree<T>::where(std::function<bool(T)> predicate) const
+template <typename T, typename Allocator>
+template <typename Work>
+void BinaryTree<T, Allocator>::runPieces(size_t count, unsigned threads, Work work)
 {
-    BinaryTree<T> result;
-    for (auto it = cbegin(); it != cend(); ++it)
+    if (threads <= 1 || count <= 1)
     {
-        if (predicate(*it))
+        for (size_t i = 0; i < count; ++i)
         {
-            result.insert(*it);
+            work(i);
         }
+        return;
+    }
+
+    std::atomic<size_t> nextPiece(0);
+    std::exception_ptr error;
+    std::mutex errorMutex;
+    auto worker = [&]()
+    {
+        for (size_t i = nextPiece.fetch_add(1); i < count; i = nextPiece.fetch_add(1))
+        {
+            try
+            {
+                work(i);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!error)
+                {
+                    error = std::current_exception();
+                }
+                nextPiece.store(count);
+            }
+        }
+    };
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < threads && t < count; ++t)
+    {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (std::thread &thread : workers)
+    {
+        thread.join();
+    }
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+template <typename T, typename Allocator>
+BinaryTree<T, Allocator> BinaryTree<T, Allocator>::apply(std::function<T(T)> func, unsigned threads) const
+{
+    std::vector<TreePiece> pieces = splitIntoPieces(threads);
+    std::vector<std::vector<T>> mapped(pieces.size());
+    runPieces(pieces.size(), threads, [&](size_t i)
+              { visitPiece(pieces[i], [&](const T &value)
+                           { mapped[i].push_back(func(value)); }); });
+
+    std::vector<T> values;
+    for (std::vector<T> &part : mapped)
+    {
+        values.insert(values.end(), part.begin(), part.end());
+    }
+    // Mapped values come in any order; equivalent ones keep their inorder position
+    std::stable_sort(values.begin(), values.end());
+    BinaryTree<T, Allocator> result;
+    if (!values.empty())
+    {
+        result.root = result.buildBalancedTreeFromValues(values, 0, values.size() - 1);
     }
     return result;
 }
 
-template <typename T>
-T BinaryTree<T>::reduce(std::function<T(T, T)> func, T initial) const
+template <typename T, typename Allocator>
+BinaryTree<T, Allocator> BinaryTree<T, Allocator>::where(std::function<bool(T)> predicate, unsigned threads) const
 {
+    std::vector<TreePiece> pieces = splitIntoPieces(threads);
+    std::vector<std::vector<T>> kept(pieces.size());
+    runPieces(pieces.size(), threads, [&](size_t i)
+              { visitPiece(pieces[i], [&](const T &value)
+                           {
+                               if (predicate(value))
+                               {
+                                   kept[i].push_back(value);
+                               } }); });
+
+    std::vector<T> values;
+    for (std::vector<T> &part : kept)
+    {
+        values.insert(values.end(), part.begin(), part.end());
+    }
+    // The inorder of an ordered tree is already sorted
+    if (!isOrdered)
+    {
+        std::stable_sort(values.begin(), values.end());
+    }
+    BinaryTree<T, Allocator> result;
+    if (!values.empty())
+    {
+        result.root = result.buildBalancedTreeFromValues(values, 0, values.size() - 1);
+    }
+    return result;
+}
+
+template <typename T, typename Allocator>
+T BinaryTree<T, Allocator>::reduce(std::function<T(T, T)> func, T initial, unsigned threads) const
+{
+    if (threads <= 1)
+    {
+        T result = initial;
+        for (auto it = cbegin(); it != cend(); ++it)
+        {
+            result = func(result, *it);
+        }
+        return result;
+    }
+
+    // Each piece is folded from its own first value, so initial is used exactly once;
+    // hasPartial[i] stays 0 while piece i has not given a value. The slots start as
+    // copies of initial only so that T need not be default-constructible.
+    std::vector<TreePiece> pieces = splitIntoPieces(threads);
+    std::vector<T> partial(pieces.size(), initial);
+    std::vector<char> hasPartial(pieces.size(), 0);
+    runPieces(pieces.size(), threads, [&](size_t i)
+              { visitPiece(pieces[i], [&](const T &value)
+                           {
+                               if (hasPartial[i])
+                               {
+                                   partial[i] = func(partial[i], value);
+                               }
+                               else
+                               {
+                                   partial[i] = value;
+                                   hasPartial[i] = 1;
+                               } }); });
+
     T result = initial;
-    for (auto it = cbegin(); it != cend(); ++it)
+    for (size_t i = 0; i < partial.size(); ++i)
     {
-        result = func(result, *it);
+        if (hasPartial[i])
+        {
+            result = func(result, partial[i]);
+        }
     }
     return result;
 }
 
-template <typename T>
-std::string BinaryTree<T>::serialize(const std::string &traversalOrder) const
+template <typename T, typename Allocator>
+std::string BinaryTree<T, Allocator>::serialize(const std::string &traversalOrder) const
 {
     // For level-order traversal (needed for visualization)
     std::vector<T> values;
@@ -1055,8 +1747,8 @@ std::string BinaryTree<T>::serialize(const std::string &traversalOrder) const
     return output;
 }
 
-template <typename T>
-void BinaryTree<T>::deserialize(const std::string &data, const std::string &format)
+template <typename T, typename Allocator>
+void BinaryTree<T, Allocator>::deserialize(const std::string &data, const std::string &format)
 {
     clear();
     std::istringstream iss(data);
@@ -1085,9 +1777,14 @@ void BinaryTree<T>::deserialize(const std::string &data, const std::string &form
     }
     if (format == "inorder" || format == "preorder" || format == "postorder")
     {
+        std::vector<T> values;
         for (auto it = cbegin(format); it != cend(format); ++it)
         {
-            insert(*it);
+            values.push_back(*it);
+        }
+        for (const T &value : values)
+        {
+            insert(value);
         }
     }
     else
@@ -1096,15 +1793,15 @@ void BinaryTree<T>::deserialize(const std::string &data, const std::string &form
     }
 }
 
-template <typename T>
-std::ostream &operator<<(std::ostream &os, const BinaryTree<T> &tree)
+template <typename T, typename Allocator>
+std::ostream &operator<<(std::ostream &os, const BinaryTree<T, Allocator> &tree)
 {
     tree.print(os);
     return os;
 }
 
-template <typename T>
-BinaryTree<T> *BinaryTree<T>::findByPath(const std::string &path) const
+template <typename T, typename Allocator>
+BinaryTree<T, Allocator> *BinaryTree<T, Allocator>::findByPath(const std::string &path) const
 {
     if (!root || path.empty())
         return nullptr;
@@ -1130,26 +1827,21 @@ BinaryTree<T> *BinaryTree<T>::findByPath(const std::string &path) const
         }
     }
 
-    BinaryTree<T> *subtree = new BinaryTree<T>();
-    subtree->root = current->clone();
+    BinaryTree<T, Allocator> *subtree = new BinaryTree<T, Allocator>();
+    subtree->root = subtree->cloneNodes(current);
+    subtree->isOrdered = isOrdered;
 
     return subtree;
 }
 
-template <typename T>
-typename BinaryTree<T>::ConstIterator BinaryTree<T>::cbegin(const TreeNode<T> *node, std::string order) const
+template <typename T, typename Allocator>
+typename BinaryTree<T, Allocator>::ConstIterator BinaryTree<T, Allocator>::cbegin(const TreeNode<T> *node, std::string order) const
 {
     return ConstIterator(node, order);
 }
 
-template <typename T>
-typename BinaryTree<T>::ConstIterator BinaryTree<T>::cend(const TreeNode<T> *node, std::string order) const
+template <typename T, typename Allocator>
+typename BinaryTree<T, Allocator>::ConstIterator BinaryTree<T, Allocator>::cend(const TreeNode<T> *node, std::string order) const
 {
-    ConstIterator it(nullptr, order);
-    if (node)
-    {
-        it = ConstIterator(node, order);
-        it.current = it.nodes.size();
-    }
-    return it;
+    return ConstIterator(node, parseTraversalOrder(order), {});
 }
\ No newline at end of file
@@ -0,0 +1,549 @@
+#include "../inc/concurrentAVLTree.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+
+template <typename T>
+ConcurrentAVLTree<T>::ConcurrentAVLTree() : root(nullptr), count(0), writeSequence(0) {}
+
+template <typename T>
+ConcurrentAVLTree<T>::~ConcurrentAVLTree()
+{
+    destroy(root.load(std::memory_order_relaxed));
+}
+
+template <typename T>
+void ConcurrentAVLTree<T>::destroy(Node *node)
+{
+    if (!node)
+    {
+        return;
+    }
+    destroy(leftOf(node));
+    destroy(rightOf(node));
+    delete node;
+}
+
+template <typename T>
+void ConcurrentAVLTree<T>::beginWrite()
+{
+    writeSequence.store(writeSequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+template <typename T>
+void ConcurrentAVLTree<T>::endWrite()
+{
+    writeSequence.store(writeSequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+template <typename T>
+void ConcurrentAVLTree<T>::beginChange(Node *node)
+{
+    node->version.store(node->version.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+template <typename T>
+void ConcurrentAVLTree<T>::endChange(Node *node)
+{
+    node->version.store(node->version.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+template <typename T>
+void ConcurrentAVLTree<T>::updateHeight(Node *node)
+{
+    node->height = 1 + std::max(heightOf(leftOf(node)), heightOf(rightOf(node)));
+}
+
+template <typename T>
+typename ConcurrentAVLTree<T>::Node *ConcurrentAVLTree<T>::rotateLeft(Node *node)
+{
+    Node *top = rightOf(node);
+    beginChange(node);
+    node->right.store(leftOf(top), std::memory_order_release);
+    top->left.store(node, std::memory_order_release);
+    updateHeight(node);
+    updateHeight(top);
+    return top;
+}
+
+template <typename T>
+typename ConcurrentAVLTree<T>::Node *ConcurrentAVLTree<T>::rotateRight(Node *node)
+{
+    Node *top = leftOf(node);
+    beginChange(node);
+    node->left.store(rightOf(top), std::memory_order_release);
+    top->right.store(node, std::memory_order_release);
+    updateHeight(node);
+    updateHeight(top);
+    return top;
+}
+
+template <typename T>
+void ConcurrentAVLTree<T>::replaceChild(Node *parent, Node *node, Node *replacement)
+{
+    if (!parent)
+    {
+        root.store(replacement, std::memory_order_release);
+    }
+    else if (leftOf(parent) == node)
+    {
+        parent->left.store(replacement, std::memory_order_release);
+    }
+    else
+    {
+        parent->right.store(replacement, std::memory_order_release);
+    }
+}
+
+template <typename T>
+typename ConcurrentAVLTree<T>::Node *ConcurrentAVLTree<T>::rebalance(Node *parent, Node *node)
+{
+    int balance = heightOf(leftOf(node)) - heightOf(rightOf(node));
+    Node *top;
+    if (balance > 1)
+    {
+        Node *child = leftOf(node);
+        if (heightOf(leftOf(child)) < heightOf(rightOf(child)))
+        {
+            node->left.store(rotateLeft(child), std::memory_order_release);
+            endChange(child);
+        }
+        top = rotateRight(node);
+    }
+    else if (balance < -1)
+    {
+        Node *child = rightOf(node);
+        if (heightOf(rightOf(child)) < heightOf(leftOf(child)))
+        {
+            node->right.store(rotateRight(child), std::memory_order_release);
+            endChange(child);
+        }
+        top = rotateLeft(node);
+    }
+    else
+    {
+        return node;
+    }
+    // node stays marked until readers can reach it under its new parent
+    replaceChild(parent, node, top);
+    endChange(node);
+    return top;
+}
+
+template <typename T>
+void ConcurrentAVLTree<T>::retrace(size_t last)
+{
+    for (size_t i = last + 1; i-- > 0;)
+    {
+        Node *node = path[i];
+        int oldHeight = node->height;
+        updateHeight(node);
+        Node *top = rebalance(i > 0 ? path[i - 1] : nullptr, node);
+        // Nothing above changes once a subtree is back at its old height, which after
+        // an insert is always the case after a rotation
+        if (top->height == oldHeight)
+        {
+            break;
+        }
+    }
+}
+
+template <typename T>
+void ConcurrentAVLTree<T>::insert(const T &value)
+{
+    std::lock_guard<std::mutex> lock(writerMutex);
+    path.clear();
+    Node *node = root.load(std::memory_order_relaxed);
+    while (node)
+    {
+        path.push_back(node);
+        if (value < node->data)
+        {
+            node = leftOf(node);
+        }
+        else if (value > node->data)
+        {
+            node = rightOf(node);
+        }
+        else
+        {
+            return;
+        }
+    }
+
+    // A new leaf only grows its parent's subtree, so no version changes for it
+    Node *leaf = new Node(value);
+    beginWrite();
+    if (path.empty())
+    {
+        root.store(leaf, std::memory_order_release);
+    }
+    else if (value < path.back()->data)
+    {
+        path.back()->left.store(leaf, std::memory_order_release);
+    }
+    else
+    {
+        path.back()->right.store(leaf, std::memory_order_release);
+    }
+    count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    if (!path.empty())
+    {
+        retrace(path.size() - 1);
+    }
+    endWrite();
+}
+
+template <typename T>
+void ConcurrentAVLTree<T>::remove(const T &value)
+{
+    std::lock_guard<std::mutex> lock(writerMutex);
+    path.clear();
+    Node *node = root.load(std::memory_order_relaxed);
+    while (node)
+    {
+        if (value < node->data)
+        {
+            path.push_back(node);
+            node = leftOf(node);
+        }
+        else if (value > node->data)
+        {
+            path.push_back(node);
+            node = rightOf(node);
+        }
+        else
+        {
+            break;
+        }
+    }
+    if (!node)
+    {
+        return;
+    }
+
+    beginWrite();
+    // Keys are never changed in place, so a node with two children is replaced by its
+    // successor. Every node between them loses the successor and is marked meanwhile.
+    beginChange(node);
+    Node *parent = path.empty() ? nullptr : path.back();
+    if (leftOf(node) && rightOf(node))
+    {
+        size_t nodeIndex = path.size();
+        path.push_back(node);
+        Node *successor = rightOf(node);
+        while (leftOf(successor))
+        {
+            path.push_back(successor);
+            successor = leftOf(successor);
+        }
+        for (size_t i = nodeIndex + 1; i < path.size(); ++i)
+        {
+            beginChange(path[i]);
+        }
+        if (path.back() != node)
+        {
+            path.back()->left.store(rightOf(successor), std::memory_order_release);
+            successor->right.store(rightOf(node), std::memory_order_release);
+        }
+        successor->left.store(leftOf(node), std::memory_order_release);
+        successor->height = node->height;
+        replaceChild(parent, node, successor);
+        path[nodeIndex] = successor;
+        for (size_t i = nodeIndex + 1; i < path.size(); ++i)
+        {
+            endChange(path[i]);
+        }
+    }
+    else
+    {
+        replaceChild(parent, node, leftOf(node) ? leftOf(node) : rightOf(node));
+    }
+    endChange(node);
+    count.store(count.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+
+    if (!path.empty())
+    {
+        retrace(path.size() - 1);
+    }
+    endWrite();
+    reclaimer.retire(node);
+}
+
+template <typename T>
+void ConcurrentAVLTree<T>::clear()
+{
+    std::lock_guard<std::mutex> lock(writerMutex);
+    Node *top = root.load(std::memory_order_relaxed);
+    if (!top)
+    {
+        return;
+    }
+
+    // Every node leaves the tree, so every node is marked
+    beginWrite();
+    path.clear();
+    path.push_back(top);
+    for (size_t i = 0; i < path.size(); ++i)
+    {
+        beginChange(path[i]);
+        if (leftOf(path[i]))
+        {
+            path.push_back(leftOf(path[i]));
+        }
+        if (rightOf(path[i]))
+        {
+            path.push_back(rightOf(path[i]));
+        }
+    }
+    root.store(nullptr, std::memory_order_release);
+    for (Node *node : path)
+    {
+        endChange(node);
+    }
+    count.store(0, std::memory_order_relaxed);
+    endWrite();
+    for (Node *node : path)
+    {
+        reclaimer.retire(node);
+    }
+}
+
+template <typename T>
+typename ConcurrentAVLTree<T>::SearchResult ConcurrentAVLTree<T>::attemptSearch(const T &value) const
+{
+    Node *node = root.load(std::memory_order_acquire);
+    if (!node)
+    {
+        return SearchResult::Missing;
+    }
+    uint64_t version = node->version.load(std::memory_order_acquire);
+    if (version % 2 != 0 || root.load(std::memory_order_acquire) != node)
+    {
+        return SearchResult::Retry;
+    }
+
+    // Invariant: node was reachable and covered value's key range when version was
+    // read; an unchanged version later means it still does
+    for (;;)
+    {
+        const std::atomic<Node *> *link;
+        if (value < node->data)
+        {
+            link = &node->left;
+        }
+        else if (value > node->data)
+        {
+            link = &node->right;
+        }
+        else
+        {
+            bool equal = node->data == value;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (node->version.load(std::memory_order_relaxed) != version)
+            {
+                return SearchResult::Retry;
+            }
+            return equal ? SearchResult::Found : SearchResult::Missing;
+        }
+
+        Node *child = link->load(std::memory_order_acquire);
+        if (!child)
+        {
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (node->version.load(std::memory_order_relaxed) != version)
+            {
+                return SearchResult::Retry;
+            }
+            return SearchResult::Missing;
+        }
+        uint64_t childVersion = child->version.load(std::memory_order_acquire);
+        if (childVersion % 2 != 0 || link->load(std::memory_order_acquire) != child)
+        {
+            return SearchResult::Retry;
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (node->version.load(std::memory_order_relaxed) != version)
+        {
+            return SearchResult::Retry;
+        }
+        node = child;
+        version = childVersion;
+    }
+}
+
+template <typename T>
+bool ConcurrentAVLTree<T>::hasValue(const T &value) const
+{
+    typename EpochReclaimer<Node>::Guard guard(reclaimer);
+    for (unsigned attempt = 0;; ++attempt)
+    {
+        SearchResult result = attemptSearch(value);
+        if (result != SearchResult::Retry)
+        {
+            return result == SearchResult::Found;
+        }
+        // A writer is in the middle of a rotation on the path; let it finish
+        if (attempt >= 2)
+        {
+            std::this_thread::yield();
+        }
+    }
+}
+
+template <typename T>
+bool ConcurrentAVLTree<T>::writeChanged(uint64_t sequence) const
+{
+    return writeSequence.load(std::memory_order_acquire) != sequence;
+}
+
+template <typename T>
+template <typename Read>
+void ConcurrentAVLTree<T>::readSnapshot(Read read) const
+{
+    {
+        typename EpochReclaimer<Node>::Guard guard(reclaimer);
+        for (int attempt = 0; attempt < snapshotAttempts; ++attempt)
+        {
+            uint64_t sequence = writeSequence.load(std::memory_order_acquire);
+            if (sequence % 2 == 0 && read(root.load(std::memory_order_acquire), sequence))
+            {
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (writeSequence.load(std::memory_order_relaxed) == sequence)
+                {
+                    return;
+                }
+            }
+            std::this_thread::yield();
+        }
+    }
+    std::lock_guard<std::mutex> lock(writerMutex);
+    read(root.load(std::memory_order_relaxed), writeSequence.load(std::memory_order_relaxed));
+}
+
+template <typename T>
+bool ConcurrentAVLTree<T>::collectRange(Node *node, const T &lo, const T &hi, uint64_t sequence, std::vector<T> &out) const
+{
+    // Inorder walk with an explicit stack, skipping subtrees outside [lo, hi]. A walk
+    // that overlaps writes could run for long, so it checks the sequence as it goes.
+    std::vector<Node *> stack;
+    size_t visited = 0;
+    while (node || !stack.empty())
+    {
+        if (++visited % 64 == 0 && writeChanged(sequence))
+        {
+            return false;
+        }
+        if (node)
+        {
+            if (node->data < lo)
+            {
+                node = node->right.load(std::memory_order_acquire);
+                continue;
+            }
+            stack.push_back(node);
+            node = node->left.load(std::memory_order_acquire);
+            continue;
+        }
+        node = stack.back();
+        stack.pop_back();
+        if (hi < node->data)
+        {
+            break;
+        }
+        out.push_back(node->data);
+        node = node->right.load(std::memory_order_acquire);
+    }
+    return true;
+}
+
+template <typename T>
+std::vector<T> ConcurrentAVLTree<T>::range(const T &lo, const T &hi) const
+{
+    std::vector<T> result;
+    readSnapshot([&](Node *top, uint64_t sequence)
+                 {
+                     result.clear();
+                     return collectRange(top, lo, hi, sequence, result); });
+    return result;
+}
+
+template <typename T>
+T ConcurrentAVLTree<T>::getMin() const
+{
+    T result;
+    bool empty = false;
+    readSnapshot([&](Node *node, uint64_t sequence)
+                 {
+                     empty = !node;
+                     for (size_t depth = 1; node; ++depth)
+                     {
+                         Node *next = node->left.load(std::memory_order_acquire);
+                         if (!next)
+                         {
+                             result = node->data;
+                         }
+                         else if (depth % 64 == 0 && writeChanged(sequence))
+                         {
+                             return false;
+                         }
+                         node = next;
+                     }
+                     return true; });
+    if (empty)
+    {
+        throw std::runtime_error("Tree is empty");
+    }
+    return result;
+}
+
+template <typename T>
+T ConcurrentAVLTree<T>::getMax() const
+{
+    T result;
+    bool empty = false;
+    readSnapshot([&](Node *node, uint64_t sequence)
+                 {
+                     empty = !node;
+                     for (size_t depth = 1; node; ++depth)
+                     {
+                         Node *next = node->right.load(std::memory_order_acquire);
+                         if (!next)
+                         {
+                             result = node->data;
+                         }
+                         else if (depth % 64 == 0 && writeChanged(sequence))
+                         {
+                             return false;
+                         }
+                         node = next;
+                     }
+                     return true; });
+    if (empty)
+    {
+        throw std::runtime_error("Tree is empty");
+    }
+    return result;
+}
+
+template <typename T>
+size_t ConcurrentAVLTree<T>::size() const
+{
+    return count.load(std::memory_order_relaxed);
+}
+
+template <typename T>
+bool ConcurrentAVLTree<T>::isEmpty() const
+{
+    return root.load(std::memory_order_acquire) == nullptr;
+}
+
+template <typename T>
+int ConcurrentAVLTree<T>::getHeight() const
+{
+    std::lock_guard<std::mutex> lock(writerMutex);
+    Node *node = root.load(std::memory_order_relaxed);
+    return node ? node->height : throw std::runtime_error("Tree is empty");
+}
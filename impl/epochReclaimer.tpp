@@ -0,0 +1,95 @@
+#include "../inc/epochReclaimer.hpp"
+
+template <typename Node, typename Deleter>
+EpochReclaimer<Node, Deleter>::Slot::Slot()
+{
+    readers[0].store(0, std::memory_order_relaxed);
+    readers[1].store(0, std::memory_order_relaxed);
+}
+
+template <typename Node, typename Deleter>
+EpochReclaimer<Node, Deleter>::EpochReclaimer(size_t batchSize, Deleter deleter)
+    : globalEpoch(0), batchSize(batchSize > 0 ? batchSize : 1), deleter(std::move(deleter)) {}
+
+template <typename Node, typename Deleter>
+EpochReclaimer<Node, Deleter>::~EpochReclaimer()
+{
+    for (std::vector<Node *> &batch : retired)
+    {
+        for (Node *node : batch)
+        {
+            deleter(node);
+        }
+    }
+}
+
+template <typename Node, typename Deleter>
+size_t EpochReclaimer<Node, Deleter>::threadSlot()
+{
+    // Threads take the slots in turn, so that up to slotCount readers never share one
+    static std::atomic<size_t> nextSlot(0);
+    thread_local size_t slot = nextSlot.fetch_add(1, std::memory_order_relaxed) % slotCount;
+    return slot;
+}
+
+template <typename Node, typename Deleter>
+EpochReclaimer<Node, Deleter>::Guard::Guard(const EpochReclaimer &reclaimer)
+{
+    Slot &slot = reclaimer.slots[threadSlot()];
+    for (;;)
+    {
+        uint64_t epoch = reclaimer.globalEpoch.load(std::memory_order_relaxed);
+        counter = &slot.readers[epoch & 1];
+        counter->fetch_add(1, std::memory_order_relaxed);
+        // Pairs with the fence in collect: either collect sees this reader, or this
+        // reader sees the epoch collect moved on to and every unlink before it
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (reclaimer.globalEpoch.load(std::memory_order_acquire) == epoch)
+        {
+            return;
+        }
+        counter->fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+template <typename Node, typename Deleter>
+EpochReclaimer<Node, Deleter>::Guard::~Guard()
+{
+    counter->fetch_sub(1, std::memory_order_release);
+}
+
+template <typename Node, typename Deleter>
+void EpochReclaimer<Node, Deleter>::retire(Node *node)
+{
+    std::vector<Node *> &batch = retired[globalEpoch.load(std::memory_order_relaxed) & 1];
+    batch.push_back(node);
+    if (batch.size() % batchSize == 0)
+    {
+        collect();
+    }
+}
+
+template <typename Node, typename Deleter>
+bool EpochReclaimer<Node, Deleter>::collect()
+{
+    // Only the caller moves the epoch, so it cannot change under us
+    uint64_t epoch = globalEpoch.load(std::memory_order_relaxed);
+    size_t previous = (epoch + 1) & 1;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    for (const Slot &slot : slots)
+    {
+        if (slot.readers[previous].load(std::memory_order_acquire) != 0)
+        {
+            return false;
+        }
+    }
+
+    // Readers of the current epoch entered after the previous batch was unlinked
+    for (Node *node : retired[previous])
+    {
+        deleter(node);
+    }
+    retired[previous].clear();
+    globalEpoch.store(epoch + 1, std::memory_order_seq_cst);
+    return true;
+}
@@ -0,0 +1,241 @@
+#include "../inc/frozenTree.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+namespace frozen_detail
+{
+    // Descendants of slot k that are d levels down sit at k * 2^d .. k * 2^d + 2^d - 1.
+    // With 2^d keys per cache line and slot 0 on a line boundary, a single prefetch
+    // covers that whole level.
+    template <typename T>
+    constexpr size_t prefetchStride(size_t stride = 1)
+    {
+        return stride * 2 * sizeof(T) > 64 ? stride : prefetchStride<T>(stride * 2);
+    }
+}
+
+template <typename T>
+FrozenTree<T>::FrozenTree() : offset(0), count(0)
+{
+    allocate(1);
+}
+
+template <typename T>
+FrozenTree<T>::FrozenTree(std::vector<T> values) : offset(0), count(values.size())
+{
+    if (!std::is_sorted(values.begin(), values.end()))
+    {
+        std::stable_sort(values.begin(), values.end());
+    }
+    allocate(count + 1);
+    size_t next = 0;
+    fill(values, next, 1);
+}
+
+template <typename T>
+FrozenTree<T>::FrozenTree(const FrozenTree &other) : offset(0), count(other.count)
+{
+    // The copy gets its own cache line alignment
+    allocate(count + 1);
+    std::copy(other.keys(), other.keys() + count + 1, keys());
+}
+
+template <typename T>
+FrozenTree<T> &FrozenTree<T>::operator=(const FrozenTree &other)
+{
+    if (this != &other)
+    {
+        FrozenTree copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+template <typename T>
+FrozenTree<T>::FrozenTree(FrozenTree &&other) noexcept
+    : storage(std::move(other.storage)), offset(other.offset), count(other.count)
+{
+    other.offset = 0;
+    other.count = 0;
+}
+
+template <typename T>
+FrozenTree<T> &FrozenTree<T>::operator=(FrozenTree &&other) noexcept
+{
+    if (this != &other)
+    {
+        storage = std::move(other.storage);
+        offset = other.offset;
+        count = other.count;
+        other.storage.clear();
+        other.offset = 0;
+        other.count = 0;
+    }
+    return *this;
+}
+
+template <typename T>
+void FrozenTree<T>::allocate(size_t slots)
+{
+    // Keys that do not divide a line cannot be lined up with it, so they are left as
+    // the vector places them
+    const size_t slotsPerLine = 64 % sizeof(T) == 0 ? 64 / sizeof(T) : 1;
+    storage.clear();
+    storage.resize(slots + slotsPerLine - 1);
+    uintptr_t address = reinterpret_cast<uintptr_t>(storage.data());
+    offset = 64 % sizeof(T) == 0 ? ((64 - address % 64) % 64) / sizeof(T) : 0;
+}
+
+template <typename T>
+void FrozenTree<T>::fill(const std::vector<T> &sorted, size_t &next, size_t k)
+{
+    // In-order walk over the implicit tree hands out the sorted keys left to right
+    if (k > count)
+    {
+        return;
+    }
+    fill(sorted, next, 2 * k);
+    keys()[k] = sorted[next++];
+    fill(sorted, next, 2 * k + 1);
+}
+
+template <typename T>
+size_t FrozenTree<T>::size() const
+{
+    return count;
+}
+
+template <typename T>
+bool FrozenTree<T>::isEmpty() const
+{
+    return count == 0;
+}
+
+template <typename T>
+size_t FrozenTree<T>::descend(const T &value, bool strict) const
+{
+    const T *base = keys();
+    const size_t stride = frozen_detail::prefetchStride<T>();
+    size_t k = 1;
+    while (k <= count)
+    {
+        tree_detail::prefetch(base + std::min(k * stride, count));
+        // The comparison result is the next step, there is no branch on it
+        bool right = strict ? !(value < base[k]) : base[k] < value;
+        k = 2 * k + right;
+    }
+    // k spells the path taken; the answer is the last node where it went left
+    return k >> (tree_detail::trailingOnes(k) + 1);
+}
+
+template <typename T>
+bool FrozenTree<T>::hasValue(const T &value) const
+{
+    // Keys such as Person compare by a coarser key than operator==, so check every
+    // equivalent key from the lower bound on
+    for (size_t k = descend(value, false); k != 0 && !(value < keys()[k]); k = nextIndex(k))
+    {
+        if (keys()[k] == value)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename T>
+typename FrozenTree<T>::ConstIterator FrozenTree<T>::lowerBound(const T &value) const
+{
+    return ConstIterator(this, descend(value, false));
+}
+
+template <typename T>
+typename FrozenTree<T>::ConstIterator FrozenTree<T>::upperBound(const T &value) const
+{
+    return ConstIterator(this, descend(value, true));
+}
+
+template <typename T>
+typename FrozenTree<T>::ConstIterator FrozenTree<T>::cbegin() const
+{
+    return ConstIterator(this, firstIndex());
+}
+
+template <typename T>
+typename FrozenTree<T>::ConstIterator FrozenTree<T>::cend() const
+{
+    return ConstIterator(this, 0);
+}
+
+template <typename T>
+size_t FrozenTree<T>::firstIndex() const
+{
+    if (count == 0)
+    {
+        return 0;
+    }
+    size_t k = 1;
+    while (2 * k <= count)
+    {
+        k = 2 * k;
+    }
+    return k;
+}
+
+template <typename T>
+size_t FrozenTree<T>::nextIndex(size_t k) const
+{
+    if (2 * k + 1 <= count)
+    {
+        k = 2 * k + 1;
+        while (2 * k <= count)
+        {
+            k = 2 * k;
+        }
+        return k;
+    }
+    // Climb while coming from a right child, then once more
+    return k >> (tree_detail::trailingOnes(k) + 1);
+}
+
+template <typename T>
+const T &FrozenTree<T>::ConstIterator::operator*() const
+{
+    if (index == 0)
+    {
+        throw std::out_of_range("FrozenTree iterator dereference out of range");
+    }
+    return tree->keys()[index];
+}
+
+template <typename T>
+typename FrozenTree<T>::ConstIterator &FrozenTree<T>::ConstIterator::operator++()
+{
+    if (index != 0)
+    {
+        index = tree->nextIndex(index);
+    }
+    return *this;
+}
+
+template <typename T>
+typename FrozenTree<T>::ConstIterator FrozenTree<T>::ConstIterator::operator++(int)
+{
+    ConstIterator previous = *this;
+    ++(*this);
+    return previous;
+}
+
+template <typename T>
+bool FrozenTree<T>::ConstIterator::operator!=(const ConstIterator &other) const
+{
+    return index != other.index;
+}
+
+template <typename T>
+bool FrozenTree<T>::ConstIterator::operator==(const ConstIterator &other) const
+{
+    return index == other.index;
+}
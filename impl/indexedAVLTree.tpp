@@ -0,0 +1,395 @@
+#include "../inc/indexedAVLTree.hpp"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+template <typename T>
+IndexedAVLTree<T>::IndexedAVLTree() : keys(1), left(1, 0), right(1, 0), heights(1, -1), root(0), freeList(0), count(0) {}
+
+template <typename T>
+template <typename InputIt>
+IndexedAVLTree<T>::IndexedAVLTree(InputIt first, InputIt last) : IndexedAVLTree()
+{
+    std::vector<T> values(first, last);
+    if (!std::is_sorted(values.begin(), values.end()))
+    {
+        std::stable_sort(values.begin(), values.end());
+    }
+    auto uniqueEnd = std::unique(values.begin(), values.end(), [](const T &a, const T &b)
+                                 { return !(a < b) && !(b < a); });
+    values.erase(uniqueEnd, values.end());
+
+    keys.reserve(values.size() + 1);
+    left.reserve(values.size() + 1);
+    right.reserve(values.size() + 1);
+    heights.reserve(values.size() + 1);
+    root = build(values, 0, values.size());
+}
+
+template <typename T>
+typename IndexedAVLTree<T>::Index IndexedAVLTree<T>::build(const std::vector<T> &sorted, size_t start, size_t end)
+{
+    if (start >= end)
+    {
+        return 0;
+    }
+    size_t mid = start + (end - start) / 2;
+    Index node = createNode(sorted[mid]);
+    Index l = build(sorted, start, mid);
+    Index r = build(sorted, mid + 1, end);
+    left[node] = l;
+    right[node] = r;
+    update(node);
+    return node;
+}
+
+template <typename T>
+typename IndexedAVLTree<T>::Index IndexedAVLTree<T>::createNode(const T &value)
+{
+    ++count;
+    if (freeList != 0)
+    {
+        Index node = freeList;
+        freeList = left[node];
+        keys[node] = value;
+        left[node] = 0;
+        right[node] = 0;
+        heights[node] = 0;
+        return node;
+    }
+
+    if (keys.size() > std::numeric_limits<Index>::max() - 1)
+    {
+        --count;
+        throw std::length_error("IndexedAVLTree is full");
+    }
+    keys.push_back(value);
+    left.push_back(0);
+    right.push_back(0);
+    heights.push_back(0);
+    return static_cast<Index>(keys.size() - 1);
+}
+
+template <typename T>
+void IndexedAVLTree<T>::update(Index node)
+{
+    heights[node] = static_cast<int8_t>(1 + std::max(heights[left[node]], heights[right[node]]));
+}
+
+template <typename T>
+typename IndexedAVLTree<T>::Index IndexedAVLTree<T>::rotateLeft(Index x)
+{
+    Index y = right[x];
+    right[x] = left[y];
+    left[y] = x;
+    update(x);
+    update(y);
+    return y;
+}
+
+template <typename T>
+typename IndexedAVLTree<T>::Index IndexedAVLTree<T>::rotateRight(Index y)
+{
+    Index x = left[y];
+    left[y] = right[x];
+    right[x] = y;
+    update(y);
+    update(x);
+    return x;
+}
+
+template <typename T>
+typename IndexedAVLTree<T>::Index IndexedAVLTree<T>::rebalance(Index node)
+{
+    update(node);
+    int balance = heights[left[node]] - heights[right[node]];
+    if (balance > 1)
+    {
+        Index child = left[node];
+        if (heights[left[child]] < heights[right[child]])
+        {
+            left[node] = rotateLeft(child);
+        }
+        return rotateRight(node);
+    }
+    if (balance < -1)
+    {
+        Index child = right[node];
+        if (heights[right[child]] < heights[left[child]])
+        {
+            right[node] = rotateRight(child);
+        }
+        return rotateLeft(node);
+    }
+    return node;
+}
+
+template <typename T>
+typename IndexedAVLTree<T>::Index IndexedAVLTree<T>::insert(Index node, const T &value)
+{
+    if (node == 0)
+    {
+        return createNode(value);
+    }
+
+    // createNode may reallocate the arrays, so the new child is stored only after the call
+    if (value < keys[node])
+    {
+        Index child = insert(left[node], value);
+        left[node] = child;
+    }
+    else if (value > keys[node])
+    {
+        Index child = insert(right[node], value);
+        right[node] = child;
+    }
+    else
+    {
+        return node;
+    }
+    return rebalance(node);
+}
+
+template <typename T>
+void IndexedAVLTree<T>::insert(const T &value)
+{
+    root = insert(root, value);
+}
+
+template <typename T>
+typename IndexedAVLTree<T>::Index IndexedAVLTree<T>::removeMin(Index node, Index &min)
+{
+    if (left[node] == 0)
+    {
+        min = node;
+        return right[node];
+    }
+    left[node] = removeMin(left[node], min);
+    return rebalance(node);
+}
+
+template <typename T>
+typename IndexedAVLTree<T>::Index IndexedAVLTree<T>::remove(Index node, const T &value, Index &removed)
+{
+    if (node == 0)
+    {
+        return 0;
+    }
+
+    if (value < keys[node])
+    {
+        left[node] = remove(left[node], value, removed);
+    }
+    else if (value > keys[node])
+    {
+        right[node] = remove(right[node], value, removed);
+    }
+    else
+    {
+        removed = node;
+        if (left[node] == 0 || right[node] == 0)
+        {
+            return left[node] ? left[node] : right[node];
+        }
+        // The successor node itself takes this node's place; no key is copied
+        Index successor = 0;
+        Index rest = removeMin(right[node], successor);
+        left[successor] = left[node];
+        right[successor] = rest;
+        node = successor;
+    }
+    return rebalance(node);
+}
+
+template <typename T>
+void IndexedAVLTree<T>::remove(const T &value)
+{
+    Index removed = 0;
+    root = remove(root, value, removed);
+    if (removed != 0)
+    {
+        releaseSlot(removed);
+    }
+}
+
+template <typename T>
+void IndexedAVLTree<T>::releaseSlot(Index slot)
+{
+    left[slot] = freeList;
+    freeList = slot;
+    --count;
+}
+
+template <typename T>
+typename IndexedAVLTree<T>::Index IndexedAVLTree<T>::find(const T &value) const
+{
+    Index node = root;
+    while (node != 0)
+    {
+        if (value < keys[node])
+        {
+            node = left[node];
+        }
+        else if (value > keys[node])
+        {
+            node = right[node];
+        }
+        else
+        {
+            return node;
+        }
+    }
+    return 0;
+}
+
+template <typename T>
+const T *IndexedAVLTree<T>::search(const T &value) const
+{
+    Index node = find(value);
+    return node != 0 && keys[node] == value ? &keys[node] : nullptr;
+}
+
+template <typename T>
+bool IndexedAVLTree<T>::hasValue(const T &value) const
+{
+    return search(value) != nullptr;
+}
+
+template <typename T>
+const T &IndexedAVLTree<T>::getMin() const
+{
+    if (root == 0)
+    {
+        throw std::runtime_error("Tree is empty");
+    }
+    Index node = root;
+    while (left[node] != 0)
+    {
+        node = left[node];
+    }
+    return keys[node];
+}
+
+template <typename T>
+const T &IndexedAVLTree<T>::getMax() const
+{
+    if (root == 0)
+    {
+        throw std::runtime_error("Tree is empty");
+    }
+    Index node = root;
+    while (right[node] != 0)
+    {
+        node = right[node];
+    }
+    return keys[node];
+}
+
+template <typename T>
+int IndexedAVLTree<T>::getHeight() const
+{
+    return root != 0 ? heights[root] : throw std::runtime_error("Tree is empty");
+}
+
+template <typename T>
+size_t IndexedAVLTree<T>::size() const
+{
+    return count;
+}
+
+template <typename T>
+bool IndexedAVLTree<T>::isEmpty() const
+{
+    return root == 0;
+}
+
+template <typename T>
+void IndexedAVLTree<T>::clear()
+{
+    keys.resize(1);
+    left.resize(1);
+    right.resize(1);
+    heights.resize(1);
+    root = 0;
+    freeList = 0;
+    count = 0;
+}
+
+template <typename T>
+typename IndexedAVLTree<T>::ConstIterator IndexedAVLTree<T>::cbegin() const
+{
+    ConstIterator it(this);
+    it.pushLeftSpine(root);
+    return it;
+}
+
+template <typename T>
+typename IndexedAVLTree<T>::ConstIterator IndexedAVLTree<T>::cend() const
+{
+    return ConstIterator(this);
+}
+
+template <typename T>
+void IndexedAVLTree<T>::inorderTraversal(std::ostream &os) const
+{
+    for (auto it = cbegin(); it != cend(); ++it)
+    {
+        os << *it << " ";
+    }
+}
+
+template <typename T>
+void IndexedAVLTree<T>::ConstIterator::pushLeftSpine(Index node)
+{
+    while (node != 0)
+    {
+        path.push_back(node);
+        node = tree->left[node];
+    }
+}
+
+template <typename T>
+const T &IndexedAVLTree<T>::ConstIterator::operator*() const
+{
+    if (path.empty())
+    {
+        throw std::out_of_range("Iterator dereference out of range");
+    }
+    return tree->keys[path.back()];
+}
+
+template <typename T>
+typename IndexedAVLTree<T>::ConstIterator &IndexedAVLTree<T>::ConstIterator::operator++()
+{
+    if (!path.empty())
+    {
+        Index node = path.back();
+        path.pop_back();
+        pushLeftSpine(tree->right[node]);
+    }
+    return *this;
+}
+
+template <typename T>
+typename IndexedAVLTree<T>::ConstIterator IndexedAVLTree<T>::ConstIterator::operator++(int)
+{
+    ConstIterator previous = *this;
+    ++(*this);
+    return previous;
+}
+
+template <typename T>
+bool IndexedAVLTree<T>::ConstIterator::operator==(const ConstIterator &other) const
+{
+    if (path.empty() || other.path.empty())
+    {
+        return path.empty() && other.path.empty();
+    }
+    return path.back() == other.path.back();
+}
+
+template <typename T>
+bool IndexedAVLTree<T>::ConstIterator::operator!=(const ConstIterator &other) const
+{
+    return !(*this == other);
+}
@@ -1,245 +1,272 @@
 #include "../inc/iterators.hpp"
+#include <utility>
 
-template <typename T>
-void BinaryTreeIterator<T>::buildInOrder(NodePtr node)
+template <typename T, typename NodePtr, typename Ref>
+BasicTreeIterator<T, NodePtr, Ref>::BasicTreeIterator(NodePtr root, std::string order) : root(root), order(parseTraversalOrder(order))
 {
-    if (!node)
+    if (root)
     {
-        return;
+        descendFirst(root);
     }
-    buildInOrder(node->getLeft());
-    nodes.push_back(node);
-    buildInOrder(node->getRight());
 }
 
-template <typename T>
-void BinaryTreeIterator<T>::buildPreOrder(NodePtr node)
+template <typename T, typename NodePtr, typename Ref>
+BasicTreeIterator<T, NodePtr, Ref>::BasicTreeIterator(NodePtr root, TraversalOrder order, std::vector<NodePtr> path)
+    : root(root), order(order), path(std::move(path))
 {
-    if (!node)
-    {
-        return;
-    }
-    nodes.push_back(node);
-    buildPreOrder(node->getLeft());
-    buildPreOrder(node->getRight());
 }
 
-template <typename T>
-void BinaryTreeIterator<T>::buildPostOrder(NodePtr node)
+template <typename T, typename NodePtr, typename Ref>
+NodePtr BasicTreeIterator<T, NodePtr, Ref>::leftOf(NodePtr node)
 {
-    if (!node)
-    {
-        return;
-    }
-    buildPostOrder(node->getLeft());
-    buildPostOrder(node->getRight());
-    nodes.push_back(node);
+    return node->hasLeftThread() ? nullptr : node->getLeft();
 }
 
-template <typename T>
-BinaryTreeIterator<T>::BinaryTreeIterator(NodePtr root, std::string order) : current(0)
+template <typename T, typename NodePtr, typename Ref>
+NodePtr BasicTreeIterator<T, NodePtr, Ref>::rightOf(NodePtr node)
 {
-    if (root)
+    return node->hasRightThread() ? nullptr : node->getRight();
+}
+
+template <typename T, typename NodePtr, typename Ref>
+void BasicTreeIterator<T, NodePtr, Ref>::descendFirst(NodePtr node)
+{
+    path.push_back(node);
+    if (order == TraversalOrder::Preorder)
     {
-        if (order == "preorder")
+        return;
+    }
+    while (true)
+    {
+        NodePtr current = path.back();
+        if (leftOf(current))
         {
-            buildPreOrder(root);
+            path.push_back(leftOf(current));
         }
-        else if (order == "postorder")
+        else if (order == TraversalOrder::Postorder && rightOf(current))
         {
-            buildPostOrder(root);
+            path.push_back(rightOf(current));
         }
         else
         {
-            buildInOrder(root);
+            return;
         }
     }
 }
 
-template <typename T>
-T &BinaryTreeIterator<T>::operator*()
+template <typename T, typename NodePtr, typename Ref>
+void BasicTreeIterator<T, NodePtr, Ref>::descendLast(NodePtr node)
 {
-    if (nodes.empty() || current >= nodes.size())
+    path.push_back(node);
+    if (order == TraversalOrder::Postorder)
     {
-        throw std::out_of_range("BinaryTreeIterator dereference out of range");
+        return;
     }
-    return nodes[current]->getData();
-}
-
-template <typename T>
-BinaryTreeIterator<T> &BinaryTreeIterator<T>::operator++()
-{
-    ++current;
-    return *this;
-}
-
-template <typename T>
-BinaryTreeIterator<T> BinaryTreeIterator<T>::operator++(int)
-{
-    BinaryTreeIterator<T> temp = *this;
-    ++current;
-    return temp;
-}
-
-template <typename T>
-BinaryTreeIterator<T> &BinaryTreeIterator<T>::operator--()
-{
-    if (current > 0)
+    while (true)
     {
-        --current;
+        NodePtr current = path.back();
+        if (rightOf(current))
+        {
+            path.push_back(rightOf(current));
+        }
+        else if (order == TraversalOrder::Preorder && leftOf(current))
+        {
+            path.push_back(leftOf(current));
+        }
+        else
+        {
+            return;
+        }
     }
-    return *this;
 }
 
-template <typename T>
-BinaryTreeIterator<T> BinaryTreeIterator<T>::operator--(int)
+template <typename T, typename NodePtr, typename Ref>
+void BasicTreeIterator<T, NodePtr, Ref>::next()
 {
-    BinaryTreeIterator<T> temp = *this;
-    if (current > 0)
-    {
-        --current;
-    }
-    return temp;
-}
+    NodePtr current = path.back();
+    size_t i = path.size() - 1;
 
-template <typename T>
-bool BinaryTreeIterator<T>::operator!=(const BinaryTreeIterator<T> &other) const
-{
-    if (nodes.empty() && other.nodes.empty())
-    {
-        return false;
-    }
-    if (nodes.empty() || other.nodes.empty())
+    switch (order)
     {
-        return true;
-    }
-    return current != other.current;
-}
+    case TraversalOrder::Inorder:
+        if (rightOf(current))
+        {
+            descendFirst(rightOf(current));
+            return;
+        }
+        // Climb until we leave a left subtree, its parent comes next
+        while (i > 0 && rightOf(path[i - 1]) == path[i])
+        {
+            --i;
+        }
+        path.resize(i);
+        return;
 
-template <typename T>
-bool BinaryTreeIterator<T>::operator==(const BinaryTreeIterator<T> &other) const
-{
-    return !(*this != other);
-}
+    case TraversalOrder::Preorder:
+        if (leftOf(current))
+        {
+            path.push_back(leftOf(current));
+            return;
+        }
+        if (rightOf(current))
+        {
+            path.push_back(rightOf(current));
+            return;
+        }
+        // Climb to the nearest ancestor whose right subtree has not been visited yet
+        for (; i > 0; --i)
+        {
+            NodePtr parent = path[i - 1];
+            if (leftOf(parent) == path[i] && rightOf(parent))
+            {
+                path.resize(i);
+                path.push_back(rightOf(parent));
+                return;
+            }
+        }
+        path.clear();
+        return;
 
-template <typename T>
-void ConstBinaryTreeIterator<T>::buildInOrder(ConstNodePtr node)
-{
-    if (!node)
-    {
+    case TraversalOrder::Postorder:
+        if (i > 0)
+        {
+            NodePtr parent = path[i - 1];
+            path.pop_back();
+            if (leftOf(parent) == current && rightOf(parent))
+            {
+                descendFirst(rightOf(parent));
+            }
+            return;
+        }
+        path.clear();
         return;
     }
-    buildInOrder(node->getLeft());
-    nodes.push_back(node);
-    buildInOrder(node->getRight());
 }
 
-template <typename T>
-void ConstBinaryTreeIterator<T>::buildPreOrder(ConstNodePtr node)
+template <typename T, typename NodePtr, typename Ref>
+void BasicTreeIterator<T, NodePtr, Ref>::prev()
 {
-    if (!node)
+    if (path.empty())
     {
+        if (root)
+        {
+            descendLast(root);
+        }
         return;
     }
-    nodes.push_back(node);
-    buildPreOrder(node->getLeft());
-    buildPreOrder(node->getRight());
-}
 
-template <typename T>
-void ConstBinaryTreeIterator<T>::buildPostOrder(ConstNodePtr node)
-{
-    if (!node)
+    NodePtr current = path.back();
+    size_t i = path.size() - 1;
+
+    // Stepping back from the first element keeps the iterator where it is
+    switch (order)
     {
+    case TraversalOrder::Inorder:
+        if (leftOf(current))
+        {
+            descendLast(leftOf(current));
+            return;
+        }
+        while (i > 0 && leftOf(path[i - 1]) == path[i])
+        {
+            --i;
+        }
+        if (i > 0)
+        {
+            path.resize(i);
+        }
         return;
-    }
-    buildPostOrder(node->getLeft());
-    buildPostOrder(node->getRight());
-    nodes.push_back(node);
-}
 
-template <typename T>
-ConstBinaryTreeIterator<T>::ConstBinaryTreeIterator(ConstNodePtr root, std::string order) : current(0)
-{
-    if (root)
-    {
-        if (order == "preorder")
+    case TraversalOrder::Preorder:
+        if (i > 0)
         {
-            buildPreOrder(root);
+            NodePtr parent = path[i - 1];
+            path.pop_back();
+            if (rightOf(parent) == current && leftOf(parent))
+            {
+                descendLast(leftOf(parent));
+            }
         }
-        else if (order == "postorder")
+        return;
+
+    case TraversalOrder::Postorder:
+        if (rightOf(current))
         {
-            buildPostOrder(root);
+            path.push_back(rightOf(current));
+            return;
         }
-        else
+        if (leftOf(current))
         {
-            buildInOrder(root);
+            path.push_back(leftOf(current));
+            return;
         }
+        for (; i > 0; --i)
+        {
+            NodePtr parent = path[i - 1];
+            if (rightOf(parent) == path[i] && leftOf(parent))
+            {
+                path.resize(i);
+                path.push_back(leftOf(parent));
+                return;
+            }
+        }
+        return;
     }
 }
 
-template <typename T>
-const T &ConstBinaryTreeIterator<T>::operator*() const
+template <typename T, typename NodePtr, typename Ref>
+Ref BasicTreeIterator<T, NodePtr, Ref>::operator*() const
 {
-    if (nodes.empty() || current >= nodes.size())
+    if (path.empty())
     {
-        throw std::out_of_range("ConstBinaryTreeIterator dereference out of range");
+        throw std::out_of_range("BinaryTreeIterator dereference out of range");
     }
-    return nodes[current]->getData();
+    return path.back()->getData();
 }
 
-template <typename T>
-ConstBinaryTreeIterator<T> &ConstBinaryTreeIterator<T>::operator++()
+template <typename T, typename NodePtr, typename Ref>
+BasicTreeIterator<T, NodePtr, Ref> &BasicTreeIterator<T, NodePtr, Ref>::operator++()
 {
-    ++current;
+    if (!path.empty())
+    {
+        next();
+    }
     return *this;
 }
 
-template <typename T>
-ConstBinaryTreeIterator<T> ConstBinaryTreeIterator<T>::operator++(int)
+template <typename T, typename NodePtr, typename Ref>
+BasicTreeIterator<T, NodePtr, Ref> BasicTreeIterator<T, NodePtr, Ref>::operator++(int)
 {
-    ConstBinaryTreeIterator<T> temp = *this;
-    ++current;
+    BasicTreeIterator<T, NodePtr, Ref> temp = *this;
+    ++(*this);
     return temp;
 }
 
-template <typename T>
-ConstBinaryTreeIterator<T> &ConstBinaryTreeIterator<T>::operator--()
+template <typename T, typename NodePtr, typename Ref>
+BasicTreeIterator<T, NodePtr, Ref> &BasicTreeIterator<T, NodePtr, Ref>::operator--()
 {
-    if (current > 0)
-    {
-        --current;
-    }
+    prev();
     return *this;
 }
 
-template <typename T>
-ConstBinaryTreeIterator<T> ConstBinaryTreeIterator<T>::operator--(int)
+template <typename T, typename NodePtr, typename Ref>
+BasicTreeIterator<T, NodePtr, Ref> BasicTreeIterator<T, NodePtr, Ref>::operator--(int)
 {
-    ConstBinaryTreeIterator<T> temp = *this;
-    if (current > 0)
-    {
-        --current;
-    }
+    BasicTreeIterator<T, NodePtr, Ref> temp = *this;
+    prev();
     return temp;
 }
 
-template <typename T>
-bool ConstBinaryTreeIterator<T>::operator!=(const ConstBinaryTreeIterator<T> &other) const
+template <typename T, typename NodePtr, typename Ref>
+bool BasicTreeIterator<T, NodePtr, Ref>::operator!=(const BasicTreeIterator<T, NodePtr, Ref> &other) const
 {
-    if (nodes.empty() && other.nodes.empty())
-    {
-        return false;
-    }
-    if (nodes.empty() || other.nodes.empty())
-    {
-        return true;
-    }
-    return current != other.current;
+    NodePtr current = path.empty() ? nullptr : path.back();
+    NodePtr otherCurrent = other.path.empty() ? nullptr : other.path.back();
+    return current != otherCurrent;
 }
 
-template <typename T>
-bool ConstBinaryTreeIterator<T>::operator==(const ConstBinaryTreeIterator<T> &other) const
+template <typename T, typename NodePtr, typename Ref>
+bool BasicTreeIterator<T, NodePtr, Ref>::operator==(const BasicTreeIterator<T, NodePtr, Ref> &other) const
 {
     return !(*this != other);
-}
\ No newline at end of file
+}
@@ -0,0 +1,209 @@
+#include "../inc/nodeAllocator.hpp"
+#include <new>
+
+template <typename T>
+TreeNode<T> *HeapNodeAllocator<T>::create(const T &value)
+{
+    return new TreeNode<T>(value);
+}
+
+template <typename T>
+void HeapNodeAllocator<T>::destroy(TreeNode<T> *node)
+{
+    if (!node)
+    {
+        return;
+    }
+    node->detach();
+    delete node;
+}
+
+template <typename T>
+void HeapNodeAllocator<T>::destroyAll(TreeNode<T> *root)
+{
+    // Iterative so that a degenerate (list-shaped) tree cannot overflow the stack
+    std::vector<TreeNode<T> *> stack;
+    if (root)
+    {
+        stack.push_back(root);
+    }
+    while (!stack.empty())
+    {
+        TreeNode<T> *node = stack.back();
+        stack.pop_back();
+        if (node->getLeft() && !node->hasLeftThread())
+            stack.push_back(node->getLeft());
+        if (node->getRight() && !node->hasRightThread())
+            stack.push_back(node->getRight());
+        destroy(node);
+    }
+}
+
+template <typename T, size_t NodesPerSlab>
+PoolNodeAllocator<T, NodesPerSlab>::PoolNodeAllocator() : freeList(nullptr), usedInLastSlab(NodesPerSlab) {}
+
+template <typename T, size_t NodesPerSlab>
+PoolNodeAllocator<T, NodesPerSlab>::PoolNodeAllocator(PoolNodeAllocator &&other) noexcept
+    : slabs(std::move(other.slabs)), freeList(other.freeList), usedInLastSlab(other.usedInLastSlab)
+{
+    other.slabs.clear();
+    other.freeList = nullptr;
+    other.usedInLastSlab = NodesPerSlab;
+}
+
+template <typename T, size_t NodesPerSlab>
+PoolNodeAllocator<T, NodesPerSlab> &PoolNodeAllocator<T, NodesPerSlab>::operator=(PoolNodeAllocator &&other) noexcept
+{
+    if (this != &other)
+    {
+        releaseSlabs();
+        slabs.swap(other.slabs);
+        freeList = other.freeList;
+        usedInLastSlab = other.usedInLastSlab;
+        other.freeList = nullptr;
+        other.usedInLastSlab = NodesPerSlab;
+    }
+    return *this;
+}
+
+template <typename T, size_t NodesPerSlab>
+PoolNodeAllocator<T, NodesPerSlab>::~PoolNodeAllocator()
+{
+    releaseSlabs();
+}
+
+template <typename T, size_t NodesPerSlab>
+TreeNode<T> *PoolNodeAllocator<T, NodesPerSlab>::create(const T &value)
+{
+    Slot *slot;
+    if (freeList)
+    {
+        slot = freeList;
+        freeList = freeList->next;
+    }
+    else
+    {
+        if (usedInLastSlab == NodesPerSlab)
+        {
+            slabs.push_back(static_cast<Slot *>(::operator new(sizeof(Slot) * NodesPerSlab)));
+            usedInLastSlab = 0;
+        }
+        slot = slabs.back() + usedInLastSlab++;
+    }
+    return new (&slot->storage) TreeNode<T>(value);
+}
+
+template <typename T, size_t NodesPerSlab>
+void PoolNodeAllocator<T, NodesPerSlab>::destroy(TreeNode<T> *node)
+{
+    if (!node)
+    {
+        return;
+    }
+    node->detach();
+    node->~TreeNode<T>();
+    Slot *slot = reinterpret_cast<Slot *>(node);
+    slot->next = freeList;
+    freeList = slot;
+}
+
+template <typename T, size_t NodesPerSlab>
+void PoolNodeAllocator<T, NodesPerSlab>::destroyAll(TreeNode<T> *root)
+{
+    // Payloads with a destructor (std::string, Person) still need one visit per node,
+    // trivially destructible ones are dropped together with the slabs
+    if (!std::is_trivially_destructible<T>::value)
+    {
+        std::vector<TreeNode<T> *> stack;
+        if (root)
+        {
+            stack.push_back(root);
+        }
+        while (!stack.empty())
+        {
+            TreeNode<T> *node = stack.back();
+            stack.pop_back();
+            if (node->getLeft() && !node->hasLeftThread())
+                stack.push_back(node->getLeft());
+            if (node->getRight() && !node->hasRightThread())
+                stack.push_back(node->getRight());
+            node->detach();
+            node->~TreeNode<T>();
+        }
+    }
+    releaseSlabs();
+}
+
+template <typename T, size_t NodesPerSlab>
+size_t PoolNodeAllocator<T, NodesPerSlab>::slabCount() const
+{
+    return slabs.size();
+}
+
+template <typename T, size_t NodesPerSlab>
+void PoolNodeAllocator<T, NodesPerSlab>::releaseSlabs()
+{
+    for (Slot *slab : slabs)
+    {
+        ::operator delete(slab);
+    }
+    slabs.clear();
+    freeList = nullptr;
+    usedInLastSlab = NodesPerSlab;
+}
+
+template <typename T>
+void EpochNodeAllocator<T>::Deleter::operator()(TreeNode<T> *node) const
+{
+    // The links are only dropped now: a reader that still held node may have stepped
+    // on to its children up to the end of its grace period
+    node->detach();
+    delete node;
+}
+
+template <typename T>
+EpochNodeAllocator<T>::EpochNodeAllocator(size_t batchSize) : retired(new Reclaimer(batchSize)) {}
+
+template <typename T>
+TreeNode<T> *EpochNodeAllocator<T>::create(const T &value)
+{
+    return new TreeNode<T>(value);
+}
+
+template <typename T>
+void EpochNodeAllocator<T>::destroy(TreeNode<T> *node)
+{
+    if (node)
+    {
+        Deleter()(node);
+    }
+}
+
+template <typename T>
+void EpochNodeAllocator<T>::retire(TreeNode<T> *node)
+{
+    if (node)
+    {
+        retired->retire(node);
+    }
+}
+
+template <typename T>
+void EpochNodeAllocator<T>::destroyAll(TreeNode<T> *root)
+{
+    std::vector<TreeNode<T> *> stack;
+    if (root)
+    {
+        stack.push_back(root);
+    }
+    while (!stack.empty())
+    {
+        TreeNode<T> *node = stack.back();
+        stack.pop_back();
+        if (node->getLeft() && !node->hasLeftThread())
+            stack.push_back(node->getLeft());
+        if (node->getRight() && !node->hasRightThread())
+            stack.push_back(node->getRight());
+        destroy(node);
+    }
+}
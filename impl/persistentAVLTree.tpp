@@ -0,0 +1,316 @@
+#include "../inc/persistentAVLTree.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+template <typename T>
+PersistentAVLTree<T>::Node::Node(const T &data, NodePtr left, NodePtr right)
+    : data(data), left(std::move(left)), right(std::move(right))
+{
+    height = 1 + std::max(heightOf(this->left), heightOf(this->right));
+    size = 1 + (this->left ? this->left->size : 0) + (this->right ? this->right->size : 0);
+}
+
+template <typename T>
+template <typename InputIt>
+PersistentAVLTree<T>::PersistentAVLTree(InputIt first, InputIt last)
+{
+    std::vector<T> values(first, last);
+    if (!std::is_sorted(values.begin(), values.end()))
+    {
+        std::stable_sort(values.begin(), values.end());
+    }
+    auto uniqueEnd = std::unique(values.begin(), values.end(), [](const T &a, const T &b)
+                                 { return !(a < b) && !(b < a); });
+    values.erase(uniqueEnd, values.end());
+    root = build(values, 0, values.size());
+}
+
+template <typename T>
+typename PersistentAVLTree<T>::NodePtr PersistentAVLTree<T>::build(const std::vector<T> &sorted, size_t start, size_t end)
+{
+    if (start >= end)
+    {
+        return nullptr;
+    }
+    size_t mid = start + (end - start) / 2;
+    return makeNode(sorted[mid], build(sorted, start, mid), build(sorted, mid + 1, end));
+}
+
+template <typename T>
+typename PersistentAVLTree<T>::NodePtr PersistentAVLTree<T>::makeNode(const T &data, NodePtr left, NodePtr right)
+{
+    return std::make_shared<const Node>(data, std::move(left), std::move(right));
+}
+
+template <typename T>
+typename PersistentAVLTree<T>::NodePtr PersistentAVLTree<T>::balance(const T &data, NodePtr left, NodePtr right)
+{
+    // Rotations build the new top and the nodes moved below it; the subtrees that
+    // change parents are shared, not copied
+    int difference = heightOf(left) - heightOf(right);
+    if (difference > 1)
+    {
+        if (heightOf(left->left) >= heightOf(left->right))
+        {
+            return makeNode(left->data, left->left, makeNode(data, left->right, std::move(right)));
+        }
+        const Node &inner = *left->right;
+        return makeNode(inner.data, makeNode(left->data, left->left, inner.left),
+                        makeNode(data, inner.right, std::move(right)));
+    }
+    if (difference < -1)
+    {
+        if (heightOf(right->right) >= heightOf(right->left))
+        {
+            return makeNode(right->data, makeNode(data, std::move(left), right->left), right->right);
+        }
+        const Node &inner = *right->left;
+        return makeNode(inner.data, makeNode(data, std::move(left), inner.left),
+                        makeNode(right->data, inner.right, right->right));
+    }
+    return makeNode(data, std::move(left), std::move(right));
+}
+
+template <typename T>
+typename PersistentAVLTree<T>::NodePtr PersistentAVLTree<T>::insert(const NodePtr &node, const T &value)
+{
+    if (!node)
+    {
+        return makeNode(value, nullptr, nullptr);
+    }
+    if (value < node->data)
+    {
+        NodePtr left = insert(node->left, value);
+        return left == node->left ? node : balance(node->data, std::move(left), node->right);
+    }
+    if (value > node->data)
+    {
+        NodePtr right = insert(node->right, value);
+        return right == node->right ? node : balance(node->data, node->left, std::move(right));
+    }
+    return node;
+}
+
+template <typename T>
+typename PersistentAVLTree<T>::NodePtr PersistentAVLTree<T>::remove(const NodePtr &node, const T &value)
+{
+    if (!node)
+    {
+        return nullptr;
+    }
+    if (value < node->data)
+    {
+        NodePtr left = remove(node->left, value);
+        return left == node->left ? node : balance(node->data, std::move(left), node->right);
+    }
+    if (value > node->data)
+    {
+        NodePtr right = remove(node->right, value);
+        return right == node->right ? node : balance(node->data, node->left, std::move(right));
+    }
+    if (!node->left)
+    {
+        return node->right;
+    }
+    if (!node->right)
+    {
+        return node->left;
+    }
+    // The successor takes the removed key's place in a new node
+    T successor = node->data;
+    NodePtr right = removeMin(node->right, successor);
+    return balance(successor, node->left, std::move(right));
+}
+
+template <typename T>
+typename PersistentAVLTree<T>::NodePtr PersistentAVLTree<T>::removeMin(const NodePtr &node, T &min)
+{
+    if (!node->left)
+    {
+        min = node->data;
+        return node->right;
+    }
+    return balance(node->data, removeMin(node->left, min), node->right);
+}
+
+template <typename T>
+PersistentAVLTree<T> PersistentAVLTree<T>::insert(const T &value) const
+{
+    return PersistentAVLTree(insert(root, value));
+}
+
+template <typename T>
+PersistentAVLTree<T> PersistentAVLTree<T>::remove(const T &value) const
+{
+    return PersistentAVLTree(remove(root, value));
+}
+
+template <typename T>
+const T *PersistentAVLTree<T>::search(const T &value) const
+{
+    const Node *node = root.get();
+    while (node)
+    {
+        if (value < node->data)
+        {
+            node = node->left.get();
+        }
+        else if (value > node->data)
+        {
+            node = node->right.get();
+        }
+        else
+        {
+            return node->data == value ? &node->data : nullptr;
+        }
+    }
+    return nullptr;
+}
+
+template <typename T>
+bool PersistentAVLTree<T>::hasValue(const T &value) const
+{
+    return search(value) != nullptr;
+}
+
+template <typename T>
+const T &PersistentAVLTree<T>::getMin() const
+{
+    if (!root)
+    {
+        throw std::runtime_error("Tree is empty");
+    }
+    const Node *node = root.get();
+    while (node->left)
+    {
+        node = node->left.get();
+    }
+    return node->data;
+}
+
+template <typename T>
+const T &PersistentAVLTree<T>::getMax() const
+{
+    if (!root)
+    {
+        throw std::runtime_error("Tree is empty");
+    }
+    const Node *node = root.get();
+    while (node->right)
+    {
+        node = node->right.get();
+    }
+    return node->data;
+}
+
+template <typename T>
+int PersistentAVLTree<T>::getHeight() const
+{
+    return root ? root->height : throw std::runtime_error("Tree is empty");
+}
+
+template <typename T>
+size_t PersistentAVLTree<T>::size() const
+{
+    return root ? root->size : 0;
+}
+
+template <typename T>
+bool PersistentAVLTree<T>::isEmpty() const
+{
+    return !root;
+}
+
+template <typename T>
+PersistentAVLTree<T> PersistentAVLTree<T>::atomicLoad(const PersistentAVLTree *shared)
+{
+    return PersistentAVLTree(std::atomic_load(&shared->root));
+}
+
+template <typename T>
+void PersistentAVLTree<T>::atomicStore(PersistentAVLTree *shared, PersistentAVLTree version)
+{
+    std::atomic_store(&shared->root, std::move(version.root));
+}
+
+template <typename T>
+typename PersistentAVLTree<T>::ConstIterator PersistentAVLTree<T>::cbegin() const
+{
+    ConstIterator it(root);
+    it.pushLeftSpine(root.get());
+    return it;
+}
+
+template <typename T>
+typename PersistentAVLTree<T>::ConstIterator PersistentAVLTree<T>::cend() const
+{
+    return ConstIterator(nullptr);
+}
+
+template <typename T>
+void PersistentAVLTree<T>::inorderTraversal(std::ostream &os) const
+{
+    for (auto it = cbegin(); it != cend(); ++it)
+    {
+        os << *it << " ";
+    }
+}
+
+template <typename T>
+PersistentAVLTree<T>::ConstIterator::ConstIterator(NodePtr root) : root(std::move(root)) {}
+
+template <typename T>
+void PersistentAVLTree<T>::ConstIterator::pushLeftSpine(const Node *node)
+{
+    while (node)
+    {
+        path.push_back(node);
+        node = node->left.get();
+    }
+}
+
+template <typename T>
+const T &PersistentAVLTree<T>::ConstIterator::operator*() const
+{
+    if (path.empty())
+    {
+        throw std::out_of_range("Iterator dereference out of range");
+    }
+    return path.back()->data;
+}
+
+template <typename T>
+typename PersistentAVLTree<T>::ConstIterator &PersistentAVLTree<T>::ConstIterator::operator++()
+{
+    if (!path.empty())
+    {
+        const Node *node = path.back();
+        path.pop_back();
+        pushLeftSpine(node->right.get());
+    }
+    return *this;
+}
+
+template <typename T>
+typename PersistentAVLTree<T>::ConstIterator PersistentAVLTree<T>::ConstIterator::operator++(int)
+{
+    ConstIterator previous = *this;
+    ++(*this);
+    return previous;
+}
+
+template <typename T>
+bool PersistentAVLTree<T>::ConstIterator::operator==(const ConstIterator &other) const
+{
+    if (path.empty() || other.path.empty())
+    {
+        return path.empty() && other.path.empty();
+    }
+    return path.back() == other.path.back();
+}
+
+template <typename T>
+bool PersistentAVLTree<T>::ConstIterator::operator!=(const ConstIterator &other) const
+{
+    return !(*this == other);
+}
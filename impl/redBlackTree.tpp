@@ -0,0 +1,290 @@
+#include "../inc/redBlackTree.hpp"
+
+template <typename T, typename Allocator>
+void RedBlackTree<T, Allocator>::insert(const T &value)
+{
+    this->removeThreads();
+
+    std::vector<TreeNode<T> *> &path = this->pathBuffer();
+    TreeNode<T> *node = this->root;
+    while (node)
+    {
+        path.push_back(node);
+        if (value < node->getData())
+        {
+            node = node->getLeft();
+        }
+        else if (value > node->getData())
+        {
+            node = node->getRight();
+        }
+        else
+        {
+            return;
+        }
+    }
+
+    TreeNode<T> *leaf = this->nodeAllocator.create(value);
+    if (path.empty())
+    {
+        this->root = leaf;
+        return;
+    }
+    setRed(leaf, true);
+    if (value < path.back()->getData())
+    {
+        path.back()->linkLeft(leaf);
+    }
+    else
+    {
+        path.back()->linkRight(leaf);
+    }
+    fixInsert(path, leaf);
+}
+
+template <typename T, typename Allocator>
+void RedBlackTree<T, Allocator>::fixInsert(std::vector<TreeNode<T> *> &path, TreeNode<T> *node)
+{
+    // path[i - 1] is the parent of node. Heights and sizes are refreshed on the way up,
+    // so everything below path[i - 1] is up to date whenever a rotation happens.
+    size_t i = path.size();
+    while (i > 0)
+    {
+        TreeNode<T> *parent = path[i - 1];
+        parent->update();
+        if (!isRed(parent))
+        {
+            break;
+        }
+
+        // A red parent is never the root, so the grandparent exists
+        TreeNode<T> *grand = path[i - 2];
+        bool parentLeft = grand->getLeft() == parent;
+        TreeNode<T> *uncle = parentLeft ? grand->getRight() : grand->getLeft();
+        if (isRed(uncle))
+        {
+            // Recolour and move the conflict two levels up; no rotation
+            setRed(parent, false);
+            setRed(uncle, false);
+            setRed(grand, true);
+            grand->update();
+            node = grand;
+            i -= 2;
+            continue;
+        }
+
+        TreeNode<T> *top;
+        if (parentLeft)
+        {
+            if (parent->getRight() == node)
+            {
+                grand->linkLeft(rotateLeft(parent));
+            }
+            top = rotateRight(grand);
+        }
+        else
+        {
+            if (parent->getLeft() == node)
+            {
+                grand->linkRight(rotateRight(parent));
+            }
+            top = rotateLeft(grand);
+        }
+        setRed(top, false);
+        setRed(grand, true);
+        this->replaceChild(i > 2 ? path[i - 3] : nullptr, grand, top);
+        i -= 1;
+        break;
+    }
+    // path[i - 1] and everything below it is done
+    this->updatePath(path, i > 0 ? i - 1 : 0, 1);
+    setRed(this->root, false);
+}
+
+template <typename T, typename Allocator>
+void RedBlackTree<T, Allocator>::remove(const T &value)
+{
+    this->removeThreads();
+
+    std::vector<TreeNode<T> *> &path = this->pathBuffer();
+    TreeNode<T> *node = this->root;
+    while (node)
+    {
+        if (value < node->getData())
+        {
+            path.push_back(node);
+            node = node->getLeft();
+        }
+        else if (value > node->getData())
+        {
+            path.push_back(node);
+            node = node->getRight();
+        }
+        else
+        {
+            break;
+        }
+    }
+    if (!node)
+    {
+        return;
+    }
+
+    // As in AVLTree, a node with two children takes its successor's key and the
+    // successor is unlinked instead
+    TreeNode<T> *victim = node;
+    if (node->getLeft() && node->getRight())
+    {
+        path.push_back(node);
+        victim = node->getRight();
+        while (victim->getLeft())
+        {
+            path.push_back(victim);
+            victim = victim->getLeft();
+        }
+        node->setData(victim->getData());
+    }
+
+    TreeNode<T> *parent = path.empty() ? nullptr : path.back();
+    TreeNode<T> *child = victim->getLeft() ? victim->getLeft() : victim->getRight();
+    bool left = parent && parent->getLeft() == victim;
+    bool wasBlack = !isRed(victim);
+    this->replaceChild(parent, victim, child);
+    this->nodeAllocator.retire(victim);
+
+    if (wasBlack && !isRed(child))
+    {
+        fixRemove(path, child, left);
+        return;
+    }
+    // Removing a red node changes no black height; a red child can take the black over
+    if (child)
+    {
+        setRed(child, false);
+    }
+    this->updatePath(path, path.size(), -1);
+}
+
+template <typename T, typename Allocator>
+void RedBlackTree<T, Allocator>::fixRemove(std::vector<TreeNode<T> *> &path, TreeNode<T> *node, bool left)
+{
+    // node is one black short; path[i - 1] is its parent. As in fixInsert, heights and
+    // sizes are refreshed on the way up.
+    size_t i = path.size();
+    while (i > 0 && !isRed(node))
+    {
+        TreeNode<T> *parent = path[i - 1];
+        int oldHeight = parent->getHeight();
+        parent->update();
+        TreeNode<T> *sibling = left ? parent->getRight() : parent->getLeft();
+        if (isRed(sibling))
+        {
+            // Rotate the red sibling above the parent, which leaves a black sibling. The
+            // new top keeps the old height until it is refreshed, so that the refresh can
+            // still tell whether the heights above change.
+            setRed(sibling, false);
+            setRed(parent, true);
+            TreeNode<T> *top = left ? rotateLeft(parent) : rotateRight(parent);
+            top->setHeight(oldHeight);
+            this->replaceChild(i > 1 ? path[i - 2] : nullptr, parent, top);
+            path.insert(path.begin() + (i - 1), top);
+            ++i;
+            sibling = left ? parent->getRight() : parent->getLeft();
+        }
+
+        TreeNode<T> *nearChild = left ? sibling->getLeft() : sibling->getRight();
+        TreeNode<T> *farChild = left ? sibling->getRight() : sibling->getLeft();
+        if (!isRed(nearChild) && !isRed(farChild))
+        {
+            // Take one black off the sibling's side and push the deficit up
+            setRed(sibling, true);
+            node = parent;
+            --i;
+            left = i > 0 && path[i - 1]->getLeft() == node;
+            continue;
+        }
+
+        if (!isRed(farChild))
+        {
+            setRed(nearChild, false);
+            setRed(sibling, true);
+            sibling = left ? rotateRight(sibling) : rotateLeft(sibling);
+            if (left)
+            {
+                parent->linkRight(sibling);
+            }
+            else
+            {
+                parent->linkLeft(sibling);
+            }
+        }
+        setRed(sibling, isRed(parent));
+        setRed(parent, false);
+        setRed(left ? sibling->getRight() : sibling->getLeft(), false);
+        TreeNode<T> *top = left ? rotateLeft(parent) : rotateRight(parent);
+        this->replaceChild(i > 1 ? path[i - 2] : nullptr, parent, top);
+        this->updatePath(path, i - 1, -1);
+        setRed(this->root, false);
+        return;
+    }
+    if (node)
+    {
+        setRed(node, false);
+    }
+    this->updatePath(path, i, -1);
+}
+
+template <typename T, typename Allocator>
+BinaryTree<T, Allocator> *RedBlackTree<T, Allocator>::mergeImmutable(const BinaryTree<T, Allocator> &other) const
+{
+    RedBlackTree<T, Allocator> *result = new RedBlackTree<T, Allocator>(*this);
+    result->merge(other);
+    return result;
+}
+
+template <typename T, typename Allocator>
+void RedBlackTree<T, Allocator>::rebuilt()
+{
+    if (this->root)
+    {
+        colourByDepth(this->root, 0, this->root->getHeight());
+    }
+}
+
+template <typename T, typename Allocator>
+void RedBlackTree<T, Allocator>::colourByDepth(TreeNode<T> *node, int depth, int deepest)
+{
+    if (!node)
+    {
+        return;
+    }
+    setRed(node, depth > 0 && depth == deepest);
+    colourByDepth(node->getLeft(), depth + 1, deepest);
+    colourByDepth(node->getRight(), depth + 1, deepest);
+}
+
+template <typename T, typename Allocator>
+int RedBlackTree<T, Allocator>::blackHeight(const TreeNode<T> *node)
+{
+    if (!node)
+    {
+        return 0;
+    }
+    int left = blackHeight(node->getLeft());
+    int right = blackHeight(node->getRight());
+    if (left == -1 || right == -1 || left != right)
+    {
+        return -1;
+    }
+    if (isRed(node) && (isRed(node->getLeft()) || isRed(node->getRight())))
+    {
+        return -1;
+    }
+    return left + (isRed(node) ? 0 : 1);
+}
+
+template <typename T, typename Allocator>
+bool RedBlackTree<T, Allocator>::isBalanced() const
+{
+    return !isRed(this->root) && blackHeight(this->root) != -1;
+}
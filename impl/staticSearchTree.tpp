@@ -0,0 +1,437 @@
+#include "../inc/staticSearchTree.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__)) && !defined(__EMSCRIPTEN__)
+#define STATIC_SEARCH_TREE_X86 1
+#include <immintrin.h>
+#else
+#define STATIC_SEARCH_TREE_X86 0
+#endif
+
+namespace stree_detail
+{
+    // Fills unused slots and stands for "no key above the query". It must not sort
+    // below any key, so floating types use +infinity rather than their max.
+    template <typename T>
+    constexpr T padValue()
+    {
+        return std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity()
+                                                    : std::numeric_limits<T>::max();
+    }
+
+    // Each Rank policy counts the keys of one node that are below x. The keys of a node
+    // are sorted, so that count is also the slot of the first key not below x.
+    template <typename T>
+    struct ScalarRank
+    {
+        static unsigned rank(const T *block, T x)
+        {
+            unsigned below = 0;
+            for (size_t i = 0; i < StaticSearchTree<T>::BlockSize; ++i)
+            {
+                below += block[i] < x;
+            }
+            return below;
+        }
+    };
+
+    // Only int and double have vector kernels, other types use the scalar loop
+    template <typename T>
+    struct Sse2Rank : ScalarRank<T>
+    {
+    };
+    template <typename T>
+    struct Avx2Rank : ScalarRank<T>
+    {
+    };
+
+    template <typename T>
+    struct HasKernels : std::integral_constant<bool, std::is_same<T, int>::value || std::is_same<T, double>::value>
+    {
+    };
+
+#if STATIC_SEARCH_TREE_X86
+    // The kernels are compiled for their instruction set only and chosen at runtime,
+    // so the rest of the program does not need -mavx2
+    template <>
+    struct Sse2Rank<int>
+    {
+        __attribute__((target("sse2"))) static unsigned rank(const int *block, int x)
+        {
+            __m128i key = _mm_set1_epi32(x);
+            unsigned mask = 0;
+            for (int j = 0; j < 4; ++j)
+            {
+                __m128i keys = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + 4 * j));
+                __m128i below = _mm_cmpgt_epi32(key, keys);
+                mask |= static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(below))) << (4 * j);
+            }
+            return __builtin_popcount(mask);
+        }
+    };
+
+    template <>
+    struct Avx2Rank<int>
+    {
+        __attribute__((target("avx2"))) static unsigned rank(const int *block, int x)
+        {
+            __m256i key = _mm256_set1_epi32(x);
+            __m256i low = _mm256_cmpgt_epi32(key, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block)));
+            __m256i high = _mm256_cmpgt_epi32(key, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + 8)));
+            unsigned mask = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(low))) |
+                            static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(high))) << 8;
+            return __builtin_popcount(mask);
+        }
+    };
+
+    template <>
+    struct Sse2Rank<double>
+    {
+        __attribute__((target("sse2"))) static unsigned rank(const double *block, double x)
+        {
+            __m128d key = _mm_set1_pd(x);
+            unsigned mask = 0;
+            for (int j = 0; j < 4; ++j)
+            {
+                __m128d below = _mm_cmplt_pd(_mm_loadu_pd(block + 2 * j), key);
+                mask |= static_cast<unsigned>(_mm_movemask_pd(below)) << (2 * j);
+            }
+            return __builtin_popcount(mask);
+        }
+    };
+
+    template <>
+    struct Avx2Rank<double>
+    {
+        __attribute__((target("avx2"))) static unsigned rank(const double *block, double x)
+        {
+            __m256d key = _mm256_set1_pd(x);
+            __m256d low = _mm256_cmp_pd(_mm256_loadu_pd(block), key, _CMP_LT_OQ);
+            __m256d high = _mm256_cmp_pd(_mm256_loadu_pd(block + 4), key, _CMP_LT_OQ);
+            unsigned mask = static_cast<unsigned>(_mm256_movemask_pd(low)) |
+                            static_cast<unsigned>(_mm256_movemask_pd(high)) << 4;
+            return __builtin_popcount(mask);
+        }
+    };
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define STATIC_SEARCH_TREE_INLINE __attribute__((always_inline)) inline
+#else
+#define STATIC_SEARCH_TREE_INLINE inline
+#endif
+
+    // The search loops are forced inline into one wrapper per instruction set below,
+    // which lets the compiler inline the matching kernel into the loop as well.
+    // Both return the first key not below the query (padValue if there is none).
+    template <typename T, typename Rank>
+    STATIC_SEARCH_TREE_INLINE T lowerCandidate(const T *base, size_t blockCount, T value)
+    {
+        const size_t B = StaticSearchTree<T>::BlockSize;
+        T candidate = padValue<T>();
+        size_t k = 0;
+        while (k < blockCount)
+        {
+            const T *block = base + k * B;
+            unsigned i = Rank::rank(block, value);
+            if (i < B)
+            {
+                candidate = block[i];
+            }
+            k = k * (B + 1) + i + 1;
+        }
+        return candidate;
+    }
+
+    template <typename T, typename Rank>
+    STATIC_SEARCH_TREE_INLINE void lowerCandidates(const T *base, size_t blockCount, const T *values, size_t n,
+                                                   T *candidates)
+    {
+        const size_t B = StaticSearchTree<T>::BlockSize;
+        const size_t Group = 16;
+        size_t node[Group];
+
+        for (size_t start = 0; start < n; start += Group)
+        {
+            size_t groupSize = std::min(Group, n - start);
+            size_t active = groupSize;
+            for (size_t q = 0; q < groupSize; ++q)
+            {
+                node[q] = 0;
+                candidates[start + q] = padValue<T>();
+            }
+
+            // One level of every query per round; the line each query needs next is
+            // prefetched while the others are being compared
+            while (active > 0)
+            {
+                active = 0;
+                for (size_t q = 0; q < groupSize; ++q)
+                {
+                    if (node[q] >= blockCount)
+                    {
+                        continue;
+                    }
+                    const T *block = base + node[q] * B;
+                    unsigned i = Rank::rank(block, values[start + q]);
+                    if (i < B)
+                    {
+                        candidates[start + q] = block[i];
+                    }
+                    node[q] = node[q] * (B + 1) + i + 1;
+                    if (node[q] < blockCount)
+                    {
+                        tree_detail::prefetch(base + node[q] * B);
+                        ++active;
+                    }
+                }
+            }
+        }
+    }
+
+    template <typename T>
+    T scalarCandidate(const T *base, size_t blockCount, T value)
+    {
+        return lowerCandidate<T, ScalarRank<T>>(base, blockCount, value);
+    }
+
+    template <typename T>
+    void scalarCandidates(const T *base, size_t blockCount, const T *values, size_t n, T *candidates)
+    {
+        lowerCandidates<T, ScalarRank<T>>(base, blockCount, values, n, candidates);
+    }
+
+#if STATIC_SEARCH_TREE_X86
+    template <typename T>
+    __attribute__((target("sse2"))) T sse2Candidate(const T *base, size_t blockCount, T value)
+    {
+        return lowerCandidate<T, Sse2Rank<T>>(base, blockCount, value);
+    }
+
+    template <typename T>
+    __attribute__((target("sse2"))) void sse2Candidates(const T *base, size_t blockCount, const T *values, size_t n,
+                                                        T *candidates)
+    {
+        lowerCandidates<T, Sse2Rank<T>>(base, blockCount, values, n, candidates);
+    }
+
+    template <typename T>
+    __attribute__((target("avx2"))) T avx2Candidate(const T *base, size_t blockCount, T value)
+    {
+        return lowerCandidate<T, Avx2Rank<T>>(base, blockCount, value);
+    }
+
+    template <typename T>
+    __attribute__((target("avx2"))) void avx2Candidates(const T *base, size_t blockCount, const T *values, size_t n,
+                                                        T *candidates)
+    {
+        lowerCandidates<T, Avx2Rank<T>>(base, blockCount, values, n, candidates);
+    }
+#endif
+}
+
+template <typename T>
+SimdLevel StaticSearchTree<T>::supportedSimdLevel()
+{
+#if STATIC_SEARCH_TREE_X86
+    static const SimdLevel detected = []
+    {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+            return SimdLevel::AVX2;
+        if (__builtin_cpu_supports("sse2"))
+            return SimdLevel::SSE2;
+        return SimdLevel::Scalar;
+    }();
+    return stree_detail::HasKernels<T>::value ? detected : SimdLevel::Scalar;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+template <typename T>
+StaticSearchTree<T>::StaticSearchTree()
+    : offset(0), blockCount(0), count(0), padIsKey(false), level(supportedSimdLevel()) {}
+
+template <typename T>
+StaticSearchTree<T>::StaticSearchTree(std::vector<T> values, SimdLevel requested)
+    : offset(0), blockCount(0), count(values.size()), padIsKey(false)
+{
+    SimdLevel supported = supportedSimdLevel();
+    level = requested == SimdLevel::Auto ? supported : std::min(requested, supported);
+
+    // NaN is unordered against every key, so no block order could hold it
+    for (const T &value : values)
+    {
+        if (std::isnan(value))
+        {
+            throw std::invalid_argument("StaticSearchTree keys cannot be NaN");
+        }
+    }
+    if (!std::is_sorted(values.begin(), values.end()))
+    {
+        std::sort(values.begin(), values.end());
+    }
+    padIsKey = !values.empty() && values.back() == stree_detail::padValue<T>();
+
+    allocate((count + BlockSize - 1) / BlockSize);
+    size_t next = 0;
+    fill(values, next, 0);
+}
+
+template <typename T>
+StaticSearchTree<T>::StaticSearchTree(const StaticSearchTree &other)
+    : offset(0), blockCount(0), count(other.count), padIsKey(other.padIsKey), level(other.level)
+{
+    // The copy gets its own cache line alignment
+    allocate(other.blockCount);
+    std::copy(other.blocks(), other.blocks() + blockCount * BlockSize, blocks());
+}
+
+template <typename T>
+StaticSearchTree<T> &StaticSearchTree<T>::operator=(const StaticSearchTree &other)
+{
+    if (this != &other)
+    {
+        StaticSearchTree copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+template <typename T>
+StaticSearchTree<T>::StaticSearchTree(StaticSearchTree &&other) noexcept
+    : storage(std::move(other.storage)), offset(other.offset), blockCount(other.blockCount),
+      count(other.count), padIsKey(other.padIsKey), level(other.level)
+{
+    other.offset = 0;
+    other.blockCount = 0;
+    other.count = 0;
+    other.padIsKey = false;
+}
+
+template <typename T>
+StaticSearchTree<T> &StaticSearchTree<T>::operator=(StaticSearchTree &&other) noexcept
+{
+    if (this != &other)
+    {
+        storage = std::move(other.storage);
+        offset = other.offset;
+        blockCount = other.blockCount;
+        count = other.count;
+        padIsKey = other.padIsKey;
+        level = other.level;
+        other.storage.clear();
+        other.offset = 0;
+        other.blockCount = 0;
+        other.count = 0;
+        other.padIsKey = false;
+    }
+    return *this;
+}
+
+template <typename T>
+void StaticSearchTree<T>::allocate(size_t blocks)
+{
+    const size_t slotsPerLine = 64 / sizeof(T) > 0 ? 64 / sizeof(T) : 1;
+    blockCount = blocks;
+    storage.assign(blocks * BlockSize + slotsPerLine, stree_detail::padValue<T>());
+    uintptr_t address = reinterpret_cast<uintptr_t>(storage.data());
+    offset = ((64 - address % 64) % 64) / sizeof(T);
+}
+
+template <typename T>
+void StaticSearchTree<T>::fill(const std::vector<T> &sorted, size_t &next, size_t k)
+{
+    // In-order over the implicit tree; slots left over at the end keep the padding value
+    if (k >= blockCount)
+    {
+        return;
+    }
+    for (size_t i = 0; i < BlockSize; ++i)
+    {
+        fill(sorted, next, k * (BlockSize + 1) + i + 1);
+        if (next < sorted.size())
+        {
+            blocks()[k * BlockSize + i] = sorted[next++];
+        }
+    }
+    fill(sorted, next, k * (BlockSize + 1) + BlockSize + 1);
+}
+
+template <typename T>
+size_t StaticSearchTree<T>::size() const
+{
+    return count;
+}
+
+template <typename T>
+bool StaticSearchTree<T>::isEmpty() const
+{
+    return count == 0;
+}
+
+template <typename T>
+SimdLevel StaticSearchTree<T>::simdLevel() const
+{
+    return level;
+}
+
+template <typename T>
+bool StaticSearchTree<T>::matches(const T &candidate, const T &value) const
+{
+    // Unused slots hold the padding value, which only counts if it is a key
+    return count > 0 && candidate == value && (value != stree_detail::padValue<T>() || padIsKey);
+}
+
+template <typename T>
+bool StaticSearchTree<T>::hasValue(const T &value) const
+{
+    T candidate;
+    switch (level)
+    {
+#if STATIC_SEARCH_TREE_X86
+    case SimdLevel::AVX2:
+        candidate = stree_detail::avx2Candidate(blocks(), blockCount, value);
+        break;
+    case SimdLevel::SSE2:
+        candidate = stree_detail::sse2Candidate(blocks(), blockCount, value);
+        break;
+#endif
+    default:
+        candidate = stree_detail::scalarCandidate(blocks(), blockCount, value);
+        break;
+    }
+    return matches(candidate, value);
+}
+
+template <typename T>
+std::vector<bool> StaticSearchTree<T>::hasValues(const std::vector<T> &values) const
+{
+    std::vector<T> candidates(values.size());
+    switch (level)
+    {
+#if STATIC_SEARCH_TREE_X86
+    case SimdLevel::AVX2:
+        stree_detail::avx2Candidates(blocks(), blockCount, values.data(), values.size(), candidates.data());
+        break;
+    case SimdLevel::SSE2:
+        stree_detail::sse2Candidates(blocks(), blockCount, values.data(), values.size(), candidates.data());
+        break;
+#endif
+    default:
+        stree_detail::scalarCandidates(blocks(), blockCount, values.data(), values.size(), candidates.data());
+        break;
+    }
+
+    std::vector<bool> found(values.size());
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        found[i] = matches(candidates[i], values[i]);
+    }
+    return found;
+}
@@ -2,16 +2,29 @@
 #include <algorithm>
 #include <stdexcept>
 
+template <typename T>
+uintptr_t TreeNode<T>::linkOf(const TreeNode<T> *node, bool thread)
+{
+    static_assert(alignof(TreeNode<T>) > (threadBit | balanceBit), "TreeNode alignment leaves no room for the link bits");
+    return reinterpret_cast<uintptr_t>(node) | (thread ? threadBit : 0);
+}
+
+template <typename T>
+TreeNode<T> *TreeNode<T>::nodeOf(uintptr_t link)
+{
+    return reinterpret_cast<TreeNode<T> *>(link & ~(threadBit | balanceBit));
+}
+
 template <typename T>
 TreeNode<T>::~TreeNode<T>()
 {
-    if (left && !isLeftThread)
+    if (getLeft() && !hasLeftThread())
     {
-        delete left;
+        delete nodeOf(leftLink);
     }
-    if (right && !isRightThread)
+    if (getRight() && !hasRightThread())
     {
-        delete right;
+        delete nodeOf(rightLink);
     }
 }
 
@@ -27,6 +40,12 @@ void TreeNode<T>::setHeight(int h)
     height = h;
 }
 
+template <typename T>
+size_t TreeNode<T>::getSize() const
+{
+    return size;
+}
+
 template <typename T>
 const T &TreeNode<T>::getData() const
 {
@@ -42,25 +61,25 @@ T &TreeNode<T>::getData()
 template <typename T>
 const TreeNode<T> *TreeNode<T>::getLeft() const
 {
-    return left;
+    return nodeOf(leftLink);
 }
 
 template <typename T>
 TreeNode<T> *TreeNode<T>::getLeft()
 {
-    return left;
+    return nodeOf(leftLink);
 }
 
 template <typename T>
 const TreeNode<T> *TreeNode<T>::getRight() const
 {
-    return right;
+    return nodeOf(rightLink);
 }
 
 template <typename T>
 TreeNode<T> *TreeNode<T>::getRight()
 {
-    return right;
+    return nodeOf(rightLink);
 }
 
 template <typename T>
@@ -72,48 +91,91 @@ void TreeNode<T>::setData(T value)
 template <typename T>
 void TreeNode<T>::setLeft(TreeNode<T> *left)
 {
-    this->left = left;
-    isLeftThread = false;
+    TreeNode<T> *right = getRight();
+    leftLink = linkOf(left, false) | (leftLink & balanceBit);
     height = 1 + std::max(
                      left ? left->height : -1,
                      right ? right->height : -1);
+    size = 1 + (left ? left->size : 0) + (right && !hasRightThread() ? right->size : 0);
 }
 
 template <typename T>
 void TreeNode<T>::setRight(TreeNode<T> *right)
 {
-    this->right = right;
-    isRightThread = false;
+    TreeNode<T> *left = getLeft();
+    rightLink = linkOf(right, false);
     height = 1 + std::max(
                      left ? left->height : -1,
                      right ? right->height : -1);
+    size = 1 + (left && !hasLeftThread() ? left->size : 0) + (right ? right->size : 0);
+}
+
+template <typename T>
+void TreeNode<T>::linkLeft(TreeNode<T> *node)
+{
+    leftLink = linkOf(node, false) | (leftLink & balanceBit);
+}
+
+template <typename T>
+void TreeNode<T>::linkRight(TreeNode<T> *node)
+{
+    rightLink = linkOf(node, false);
+}
+
+template <typename T>
+void TreeNode<T>::update()
+{
+    const TreeNode<T> *left = hasLeftThread() ? nullptr : getLeft();
+    const TreeNode<T> *right = hasRightThread() ? nullptr : getRight();
+    height = 1 + std::max(left ? left->height : -1, right ? right->height : -1);
+    size = 1 + (left ? left->size : 0) + (right ? right->size : 0);
+}
+
+template <typename T>
+void TreeNode<T>::setSize(size_t s)
+{
+    size = s;
+}
+
+template <typename T>
+bool TreeNode<T>::getBalanceBit() const
+{
+    return (leftLink & balanceBit) != 0;
+}
+
+template <typename T>
+void TreeNode<T>::setBalanceBit(bool bit)
+{
+    leftLink = bit ? (leftLink | balanceBit) : (leftLink & ~balanceBit);
 }
 
 template <typename T>
 bool TreeNode<T>::isLeaf() const
 {
-    return left == nullptr && right == nullptr;
+    return getLeft() == nullptr && getRight() == nullptr;
 }
 
 template <typename T>
 bool TreeNode<T>::hasChildren() const
 {
-    return left != nullptr || right != nullptr;
+    return getLeft() != nullptr || getRight() != nullptr;
 }
 
 template <typename T>
 TreeNode<T> *TreeNode<T>::clone() const
 {
     TreeNode *newNode = new TreeNode(data);
-    if (left)
+    if (getLeft())
     {
-        newNode->left = left->clone();
+        newNode->leftLink = linkOf(getLeft()->clone(), false);
     }
-    if (right)
+    if (getRight())
     {
-        newNode->right = right->clone();
+        newNode->rightLink = linkOf(getRight()->clone(), false);
     }
+    newNode->setBalanceBit(getBalanceBit());
     newNode->height = this->height;
+    newNode->size = this->size;
     return newNode;
 }
 
@@ -126,20 +188,22 @@ bool TreeNode<T>::operator==(const TreeNode &other) const
         return false;
     }
 
-    if ((left == nullptr) != (other.left == nullptr))
+    const TreeNode<T> *left = getLeft();
+    const TreeNode<T> *right = getRight();
+    if ((left == nullptr) != (other.getLeft() == nullptr))
     {
         return false;
     }
-    if (left && !(*left == *other.left))
+    if (left && !(*left == *other.getLeft()))
     {
         return false;
     }
 
-    if ((right == nullptr) != (other.right == nullptr))
+    if ((right == nullptr) != (other.getRight() == nullptr))
     {
         return false;
     }
-    if (right && !(*right == *other.right))
+    if (right && !(*right == *other.getRight()))
     {
         return false;
     }
@@ -167,15 +231,16 @@ TreeNode<T> &TreeNode<T>::operator=(const TreeNode &other)
 {
     if (this != &other)
     {
-        TreeNode<T> *newLeft = other.left ? other.left->clone() : nullptr;
-        TreeNode<T> *newRight = other.right ? other.right->clone() : nullptr;
+        TreeNode<T> *newLeft = other.getLeft() ? other.getLeft()->clone() : nullptr;
+        TreeNode<T> *newRight = other.getRight() ? other.getRight()->clone() : nullptr;
 
-        delete left;
-        delete right;
+        delete getLeft();
+        delete getRight();
 
         data = other.data;
-        left = newLeft;
-        right = newRight;
+        leftLink = linkOf(newLeft, false) | (leftLink & balanceBit);
+        rightLink = linkOf(newRight, false);
+        size = 1 + (newLeft ? newLeft->size : 0) + (newRight ? newRight->size : 0);
     }
     return *this;
 }
@@ -183,34 +248,39 @@ TreeNode<T> &TreeNode<T>::operator=(const TreeNode &other)
 template <typename T>
 bool TreeNode<T>::hasLeftThread() const
 {
-    return isLeftThread;
+    return (leftLink & threadBit) != 0;
 }
 
 template <typename T>
 bool TreeNode<T>::hasRightThread() const
 {
-    return isRightThread;
+    return (rightLink & threadBit) != 0;
 }
 
 template <typename T>
 void TreeNode<T>::setLeftThread(TreeNode *node)
 {
-    left = node;
-    isLeftThread = true;
+    leftLink = linkOf(node, true) | (leftLink & balanceBit);
 }
 
 template <typename T>
 void TreeNode<T>::setRightThread(TreeNode *node)
 {
-    right = node;
-    isRightThread = true;
+    rightLink = linkOf(node, true);
 }
 
 template <typename T>
 void TreeNode<T>::clearThreads()
 {
-    isLeftThread = false;
-    isRightThread = false;
+    leftLink &= ~threadBit;
+    rightLink &= ~threadBit;
+}
+
+template <typename T>
+void TreeNode<T>::detach()
+{
+    leftLink &= balanceBit;
+    rightLink = 0;
 }
 
 template <typename T>
@@ -234,12 +304,34 @@ TreeNode<T> *TreeNode<T>::getParent(TreeNode<T> *root) const
     return (current == this) ? parent : nullptr;
 }
 
+template <typename T>
+TreeNode<T> *TreeNode<T>::getMax() const
+{
+    const TreeNode<T> *current = this;
+    while (current->getRight() && !current->hasRightThread())
+    {
+        current = current->getRight();
+    }
+    return const_cast<TreeNode<T> *>(current);
+}
+
+template <typename T>
+TreeNode<T> *TreeNode<T>::getMin() const
+{
+    const TreeNode<T> *current = this;
+    while (current->getLeft() && !current->hasLeftThread())
+    {
+        current = current->getLeft();
+    }
+    return const_cast<TreeNode<T> *>(current);
+}
+
 template <typename T>
 TreeNode<T> *TreeNode<T>::getRightThread() const
 {
-    if (!isRightThread)
+    if (!hasRightThread())
     {
         throw std::logic_error("This node does not have a right thread.");
     }
-    return right;
+    return nodeOf(rightLink);
 }
\ No newline at end of file
@@ -1,31 +1,127 @@
 #pragma once
 #include "binaryTree.hpp"
 
-template <typename T>
-class AVLTree : public BinaryTree<T>
+template <typename T, typename Allocator = HeapNodeAllocator<T>>
+class AVLTree : public BinaryTree<T, Allocator>
 {
 public:
-    AVLTree() : BinaryTree<T>() {}
-    AVLTree(const AVLTree &other) : BinaryTree<T>(other) {}
+    AVLTree() : BinaryTree<T, Allocator>() {}
+    AVLTree(const AVLTree &other) : BinaryTree<T, Allocator>(other) {}
+    AVLTree(AVLTree &&other) noexcept : BinaryTree<T, Allocator>(std::move(other)) {}
+    AVLTree &operator=(const AVLTree &other) = default;
+    AVLTree &operator=(AVLTree &&other) noexcept = default;
+    template <typename InputIt>
+    AVLTree(InputIt first, InputIt last) : BinaryTree<T, Allocator>() { bulkLoad(first, last); }
     ~AVLTree() { this->clear(); }
 
+    // Replaces the contents with [first, last) in O(n) when the range is sorted,
+    // O(n log n) otherwise. Of several equivalent keys only the first is kept, as with
+    // repeated insert(). Returns how many duplicates were dropped.
+    template <typename InputIt>
+    size_t bulkLoad(InputIt first, InputIt last);
+
+    // Adds the keys of [first, last) in any order and returns how many were new. The batch
+    // is sorted and deduplicated, built into a balanced tree and unioned in with join/split
+    // (O(m log(n/m + 1))); keys already present stay as they are. A batch much smaller
+    // than the tree is inserted key by key in sorted order instead.
+    template <typename InputIt>
+    size_t insertBatch(InputIt first, InputIt last);
+
     void insert(const T &value) override;
     void remove(const T &value) override;
+    BinaryTree<T, Allocator> *mergeImmutable(const BinaryTree<T, Allocator> &other) const override;
     bool isBalanced() const override { return true; }
     int getHeight(TreeNode<T> *node) const;
 
+    // Order statistics from the subtree sizes kept in every node, all O(log n).
+    // select(k) is the k-th smallest key counting from 0, rank(value) the number of keys
+    // below value and countRange(lo, hi) the number of keys in [lo, hi].
+    size_t size() const;
+    const T &select(size_t k) const;
+    size_t rank(const T &value) const;
+    size_t countRange(const T &lo, const T &hi) const;
+
+    // Set operations on keys; equivalent keys count as equal and the element of *this
+    // is the one kept. The operands are copied into the result, combining them is then
+    // O(m log(n/m + 1)) for sizes m <= n. With threads > 1 the independent halves of
+    // large subtrees are processed on separate threads (fork-join).
+    AVLTree unionWith(const AVLTree &other, unsigned threads = 1) const;
+    AVLTree intersect(const AVLTree &other, unsigned threads = 1) const;
+    AVLTree difference(const AVLTree &other, unsigned threads = 1) const;
+
+    // In-place union with another AVL tree, optionally on several threads
+    using BinaryTree<T, Allocator>::merge;
+    void merge(const AVLTree &other, unsigned threads);
+
+    // Moves the keys below `key` into `less` and those above it into `greater` (both are
+    // replaced) and leaves this tree empty. Returns whether `key` was present; it is dropped.
+    // O(log n) when nodes can move between allocators (stateless ones), a copy otherwise.
+    bool split(const T &key, AVLTree &less, AVLTree &greater);
+    // Replaces the contents with less + key + greater and empties both operands. Every key
+    // of `less` must be below `key` and every key of `greater` above it.
+    void join(AVLTree &less, const T &key, AVLTree &greater);
+
 private:
-    TreeNode<T> *insert(TreeNode<T> *node, const T &value);
-    TreeNode<T> *remove(TreeNode<T> *node, const T &value);
+    // insert and remove descend once, recording the path, then retrace it bottom-up.
+    // Heights are recomputed and rotations applied only until a subtree keeps its old
+    // height; above that point only the sizes are adjusted.
+    void retrace(std::vector<TreeNode<T> *> &path, bool grew);
+    // Rotates node back into balance if needed and returns the new subtree root
+    TreeNode<T> *rebalance(TreeNode<T> *node);
+    using BinaryTree<T, Allocator>::pathBuffer;
+    using BinaryTree<T, Allocator>::replaceChild;
 
     int getBalance(TreeNode<T> *node) const;
 
-    TreeNode<T> *rotateLeft(TreeNode<T> *x);
-    TreeNode<T> *rotateRight(TreeNode<T> *y);
+    // Sorts values and drops all but the first of equivalent keys; returns how many went
+    static size_t sortUnique(std::vector<T> &values);
+    // insertBatch inserts key by key when the tree has more than this many keys per new one
+    static const size_t batchFallbackRatio = 64;
+
+    using BinaryTree<T, Allocator>::rotateLeft;
+    using BinaryTree<T, Allocator>::rotateRight;
     TreeNode<T> *rotateLeftRight(TreeNode<T> *node);
     TreeNode<T> *rotateRightLeft(TreeNode<T> *node);
 
     void updateRoot(TreeNode<T> *newRoot) { this->root = newRoot; }
+
+    static const TreeNode<T> *leftChild(const TreeNode<T> *node);
+    static const TreeNode<T> *rightChild(const TreeNode<T> *node);
+    static size_t sizeOf(const TreeNode<T> *node);
+    // Number of keys below value, or not above it when inclusive
+    size_t countBelow(const T &value, bool inclusive) const;
+
+    // Node-level primitives; all nodes involved belong to this tree's allocator.
+    // joinNodes links left + key + right where key is a detached node, splitNodes cuts a
+    // tree around key and returns the detached node equivalent to it, if any.
+    TreeNode<T> *joinNodes(TreeNode<T> *left, TreeNode<T> *key, TreeNode<T> *right);
+    TreeNode<T> *joinRight(TreeNode<T> *left, TreeNode<T> *key, TreeNode<T> *right);
+    TreeNode<T> *joinLeft(TreeNode<T> *left, TreeNode<T> *key, TreeNode<T> *right);
+    TreeNode<T> *joinNodes(TreeNode<T> *left, TreeNode<T> *right);
+    TreeNode<T> *splitLast(TreeNode<T> *node, TreeNode<T> *&last);
+    TreeNode<T> *splitNodes(TreeNode<T> *node, const T &key, TreeNode<T> *&less, TreeNode<T> *&greater);
+
+    // Set operations consume both trees; dropped nodes are collected in `garbage` and
+    // freed by the caller once all threads have joined, since allocators are not thread-safe
+    TreeNode<T> *unionNodes(TreeNode<T> *a, TreeNode<T> *b, unsigned threads, std::vector<TreeNode<T> *> &garbage);
+    TreeNode<T> *intersectNodes(TreeNode<T> *a, TreeNode<T> *b, unsigned threads, std::vector<TreeNode<T> *> &garbage);
+    TreeNode<T> *differenceNodes(TreeNode<T> *a, TreeNode<T> *b, unsigned threads, std::vector<TreeNode<T> *> &garbage);
+    using NodeSetOperation = TreeNode<T> *(AVLTree::*)(TreeNode<T> *, TreeNode<T> *, unsigned, std::vector<TreeNode<T> *> &);
+    void combineFrom(const TreeNode<T> *a, const TreeNode<T> *b, NodeSetOperation operation, unsigned threads);
+    TreeNode<T> *cloneParallel(const TreeNode<T> *node, unsigned threads);
+
+    // Subtrees lower than this (about 2^12 nodes) are not worth a thread
+    static const int parallelCutoffHeight = 12;
+    template <typename First, typename Second>
+    static void forkJoin(bool parallel, First first, Second second);
+
+    // Hands the nodes of `from` over to this tree's allocator and empties `from`
+    TreeNode<T> *takeNodes(AVLTree &from);
+    // Installs nodes owned by this tree's allocator as the contents of `to`
+    void placeNodes(AVLTree &to, TreeNode<T> *nodes);
+
+protected:
+    bool allowsDuplicates() const override { return false; }
 };
 
 #include "../impl/AVLTree.tpp"
\ No newline at end of file
@@ -0,0 +1,146 @@
+#pragma once
+
+#include "treeDetail.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// B+-tree with nodes sized in cache lines. Keys live in the leaves, which are chained
+// left to right for iteration; inner nodes only hold separator keys and child
+// pointers. With the default 256-byte nodes an int tree branches about 20 ways at
+// the inner levels and stores about 60 keys per leaf, so 10^7 keys take about 6 levels
+// instead of the ~24 of a balanced binary tree, and each level is a few adjacent
+// cache lines. The interface follows BinaryTree/IndexedAVLTree; as in AVLTree, a
+// key equivalent to one already stored is not inserted.
+template <typename T, size_t NodeBytes = 256>
+class BTree
+{
+    struct Node
+    {
+        uint16_t count; // keys in the node; an inner node has count + 1 children
+        bool leaf;
+
+        // Nodes start on a cache line boundary, which plain new does not promise
+        // before C++17
+        static void *operator new(size_t bytes);
+        static void operator delete(void *node);
+    };
+
+public:
+    // Keys per node that fit into NodeBytes, but never fewer than 4
+    static const size_t leafCapacity =
+        std::max<size_t>(4, (NodeBytes - sizeof(Node) - sizeof(void *)) / sizeof(T));
+    static const size_t innerCapacity =
+        std::max<size_t>(4, (NodeBytes - sizeof(Node) - sizeof(void *)) / (sizeof(T) + sizeof(void *)));
+
+    static_assert(leafCapacity <= UINT16_MAX && innerCapacity <= UINT16_MAX, "BTree node counts are 16-bit");
+
+private:
+    struct alignas(64) Leaf : Node
+    {
+        T keys[leafCapacity];
+        Leaf *next;
+    };
+
+    struct alignas(64) Inner : Node
+    {
+        T keys[innerCapacity];
+        Node *children[innerCapacity + 1];
+    };
+
+public:
+    // Walks the leaf chain; the end iterator has no leaf
+    class ConstIterator
+    {
+        friend class BTree;
+
+    public:
+        const T &operator*() const;
+        ConstIterator &operator++();
+        ConstIterator operator++(int);
+        bool operator!=(const ConstIterator &other) const;
+        bool operator==(const ConstIterator &other) const;
+
+    private:
+        const Leaf *leaf;
+        size_t index;
+
+        ConstIterator(const Leaf *leaf, size_t index) : leaf(leaf), index(index) {}
+    };
+
+    BTree();
+    BTree(const BTree &other);
+    BTree(BTree &&other) noexcept;
+    BTree &operator=(const BTree &other);
+    BTree &operator=(BTree &&other) noexcept;
+    ~BTree();
+
+    void insert(const T &value);
+    void remove(const T &value);
+
+    // Stored key equal to value, or nullptr
+    const T *search(const T &value) const;
+    bool hasValue(const T &value) const;
+
+    const T &getMin() const;
+    const T &getMax() const;
+    // Levels below the root; a tree that is a single leaf has height 0
+    int getHeight() const;
+    size_t size() const;
+    bool isEmpty() const;
+    void clear();
+
+    ConstIterator cbegin() const;
+    ConstIterator cend() const;
+    void inorderTraversal(std::ostream &os = std::cout) const;
+    // JSON like BinaryTree::serialize: "values" holds the keys in order and "levels" the
+    // key lists of the nodes, one array per level from the root down
+    std::string serialize(const std::string &traversalOrder = "inorder") const;
+
+private:
+    Node *root;
+    size_t count;
+
+    static const size_t leafMinimum = leafCapacity / 2;
+    static const size_t innerMinimum = innerCapacity / 2;
+
+    static Leaf *asLeaf(Node *node) { return static_cast<Leaf *>(node); }
+    static const Leaf *asLeaf(const Node *node) { return static_cast<const Leaf *>(node); }
+    static Inner *asInner(Node *node) { return static_cast<Inner *>(node); }
+    static const Inner *asInner(const Node *node) { return static_cast<const Inner *>(node); }
+    static Leaf *makeLeaf();
+    static Inner *makeInner();
+    static size_t minimumOf(const Node *node);
+
+    // Shift the items after pos to make room or close the gap
+    template <typename U>
+    static void insertAt(U *items, size_t count, size_t pos, U item);
+    template <typename U>
+    static void eraseAt(U *items, size_t count, size_t pos);
+
+    // Child to descend into: the number of separators not above value
+    static size_t childIndex(const Inner *inner, const T &value);
+    static size_t lowerIndex(const Leaf *leaf, const T &value);
+    const Leaf *findLeaf(const T &value) const;
+
+    // Inserts below node. When node splits, its new right sibling and the separator
+    // for it are returned through sibling/separator. False if an equivalent key exists.
+    bool insertInto(Node *node, const T &value, T &separator, Node *&sibling);
+    // Removes below node, false if no equivalent key was found. Underfull children are
+    // refilled on the way back up.
+    bool removeFrom(Node *node, const T &value);
+    void refillChild(Inner *parent, size_t i);
+    void borrowFromLeft(Inner *parent, size_t i);
+    void borrowFromRight(Inner *parent, size_t i);
+    // Moves children[i + 1] into children[i] and deletes it
+    void mergeChildren(Inner *parent, size_t i);
+
+    // Copies a subtree; leaves are chained onto lastLeaf in order
+    static Node *cloneNode(const Node *node, Leaf *&lastLeaf);
+    static void destroyNode(Node *node);
+};
+
+#include "../impl/BTree.tpp"
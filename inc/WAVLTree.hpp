@@ -0,0 +1,55 @@
+#pragma once
+#include "binaryTree.hpp"
+
+// Weak AVL tree (Haeupler, Sen, Tarjan): every node has a rank, children sit one or two
+// ranks below their parent and leaves have rank 0. Without deletions it is exactly an
+// AVL tree; deletions only ever rotate once or twice, so updates cost O(1) amortized
+// rotations. Only the rank parity is stored, in the node's balance bit, which is enough
+// to tell a 1-child from a 2-child. Equivalent keys are kept once, as in AVLTree.
+template <typename T, typename Allocator = HeapNodeAllocator<T>>
+class WAVLTree : public BinaryTree<T, Allocator>
+{
+public:
+    WAVLTree() : BinaryTree<T, Allocator>() {}
+    WAVLTree(const WAVLTree &other) : BinaryTree<T, Allocator>(other) {}
+    WAVLTree(WAVLTree &&other) noexcept : BinaryTree<T, Allocator>(std::move(other)) {}
+    WAVLTree &operator=(const WAVLTree &other) = default;
+    WAVLTree &operator=(WAVLTree &&other) noexcept = default;
+    ~WAVLTree() { this->clear(); }
+
+    void insert(const T &value) override;
+    void remove(const T &value) override;
+    BinaryTree<T, Allocator> *mergeImmutable(const BinaryTree<T, Allocator> &other) const override;
+    // Ranks are implied by the parities and kept valid by every update; the height is
+    // at most 2 log2(n + 1), and 1.44 log2(n + 2) as long as nothing was removed.
+    // Checks that the parities give every node one rank, that leaves have rank 0, and
+    // the height bound.
+    bool isBalanced() const override;
+
+protected:
+    bool allowsDuplicates() const override { return false; }
+    // A midpoint-built tree is an AVL tree, so rank = height is a valid choice
+    void rebuilt() override;
+
+private:
+    using BinaryTree<T, Allocator>::rotateLeft;
+    using BinaryTree<T, Allocator>::rotateRight;
+
+    // A missing child has rank -1, which is odd
+    static bool oddRank(const TreeNode<T> *node) { return !node || node->getBalanceBit(); }
+    // Promoting or demoting by one flips the parity
+    static void flipRank(TreeNode<T> *node) { node->setBalanceBit(!node->getBalanceBit()); }
+
+    // Promotes and rotates upwards after a leaf was hung below path.back()
+    void fixInsert(std::vector<TreeNode<T> *> &path, TreeNode<T> *node);
+    // Demotes and rotates upwards after node replaced a removed child of path.back()
+    // on the side given by left
+    void fixRemove(std::vector<TreeNode<T> *> &path, TreeNode<T> *node, bool left);
+
+    static void rankByHeight(TreeNode<T> *node);
+    // Rank of node recovered from the parities below it, or -2 if its children imply
+    // different ranks (a rank difference of 0 or 3) or a leaf is not at rank 0
+    static int checkedRank(const TreeNode<T> *node);
+};
+
+#include "../impl/WAVLTree.tpp"
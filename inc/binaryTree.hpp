@@ -2,24 +2,41 @@
 
 #include "treeNode.hpp"
 #include "iterators.hpp"
+#include "nodeAllocator.hpp"
+#include "treeDetail.hpp"
+#include "frozenTree.hpp"
+#include "staticSearchTree.hpp"
 #include <iostream>
 #include <vector>
 #include <functional>
+#include <utility>
 
-template <typename T>
+// Allocator decides where TreeNode<T> objects live: HeapNodeAllocator uses a separate
+// new/delete per node, PoolNodeAllocator carves them out of slabs owned by the tree.
+template <typename T, typename Allocator = HeapNodeAllocator<T>>
 class BinaryTree
 {
 protected:
     TreeNode<T> *root;
+    Allocator nodeAllocator;
     bool isThreaded = false;
+    // True while every node satisfies left <= node <= right under operator<, i.e. the
+    // tree was only built through insert(value), an AVL insert, balance() or bulkLoad.
+    // The last two may put a key equivalent to the node into its left subtree.
+    // Lookups then descend in O(height).
+    bool isOrdered = true;
 
 public:
     BinaryTree();
     BinaryTree(const BinaryTree &other);
-    ~BinaryTree();
+    // Takes over the nodes (and the allocator holding them) in O(1); other is left empty
+    BinaryTree(BinaryTree &&other) noexcept;
+    virtual ~BinaryTree();
 
     const TreeNode<T> *getRoot() const;
     TreeNode<T> *getRoot();
+    // The allocator holding the nodes, e.g. to take an EpochNodeAllocator's Guard
+    const Allocator &getAllocator() const;
 
     const TreeNode<T> *getMaxNode() const;
     TreeNode<T> *getMaxNode();
@@ -47,6 +64,11 @@ public:
     void print(std::ostream &os = std::cout) const;
 
     bool hasValue(const T &value) const;
+    // One answer per key, in order. On an ordered tree up to batchLanes descents are
+    // interleaved and each prefetches its next node, so their cache misses overlap;
+    // a finished lane picks up the next key right away.
+    std::vector<bool> hasValues(const std::vector<T> &values) const;
+    std::vector<const TreeNode<T> *> searchBatch(const std::vector<T> &values) const;
 
     void balance();
     TreeNode<T> *buildBalancedTree(std::vector<TreeNode<T> *> &nodes, int start, int end);
@@ -66,7 +88,7 @@ public:
     void postorderTraversal(std::ostream &os = std::cout) const;
     void postorderTraversal(const TreeNode<T> *node, std::ostream &os = std::cout) const;
 
-    BinaryTree<T> *subtree(const T &value) const;
+    BinaryTree<T, Allocator> *subtree(const T &value) const;
     bool containsSubtree(const BinaryTree &sub) const;
 
     int getHeight() const;
@@ -74,13 +96,20 @@ public:
 
     void clear();
 
-    bool operator==(const BinaryTree<T> &other) const;
-    bool operator!=(const BinaryTree<T> &other) const;
-    BinaryTree<T> &operator=(const BinaryTree<T> &other);
-
-    BinaryTree<T> apply(std::function<T(T)> func) const;
-    BinaryTree<T> where(std::function<bool(T)> predicate) const;
-    T reduce(std::function<T(T, T)> func, T initial) const;
+    bool operator==(const BinaryTree<T, Allocator> &other) const;
+    bool operator!=(const BinaryTree<T, Allocator> &other) const;
+    BinaryTree<T, Allocator> &operator=(const BinaryTree<T, Allocator> &other);
+    BinaryTree<T, Allocator> &operator=(BinaryTree<T, Allocator> &&other) noexcept;
+
+    // The results are built balanced from their sorted values in one pass. With
+    // threads > 1 the tree is cut into subtrees that up to `threads` threads work
+    // through, so func and predicate must be safe to call concurrently.
+    BinaryTree<T, Allocator> apply(std::function<T(T)> func, unsigned threads = 1) const;
+    BinaryTree<T, Allocator> where(std::function<bool(T)> predicate, unsigned threads = 1) const;
+    // Folds the values in inorder, starting from initial. Passing threads > 1 declares
+    // func associative: subtrees are folded on their own and the partial results
+    // combined with func in order, so it need not be commutative.
+    T reduce(std::function<T(T, T)> func, T initial, unsigned threads = 1) const;
 
     void makeThreaded(const std::string &traversalOrder = "inorder");
     void traverseThreaded(std::function<void(T)> visit = [](const T &val)
@@ -89,13 +118,14 @@ public:
     std::string serialize(const std::string &traversalOrder = "inorder") const;
     void deserialize(const std::string &data, const std::string &format = "default");
 
-    BinaryTree<T> *findByPath(const std::string &path) const;
+    BinaryTree<T, Allocator> *findByPath(const std::string &path) const;
 
-    BinaryTree<T> *mergeImmutable(const BinaryTree<T> &other) const;
-    void merge(const BinaryTree<T> &other);
+    // When both trees are ordered, merging flattens them, merges the two sorted
+    // sequences and rebuilds a balanced tree in O(n + m)
+    virtual BinaryTree<T, Allocator> *mergeImmutable(const BinaryTree<T, Allocator> &other) const;
+    virtual void merge(const BinaryTree<T, Allocator> &other);
 
-    BinaryTree<T> operator+(const BinaryTree<T> &other) const;
-    friend std::ostream &operator<<(std::ostream &os, const BinaryTree<T> &tree);
+    BinaryTree<T, Allocator> operator+(const BinaryTree<T, Allocator> &other) const;
 
 public:
     using Iterator = BinaryTreeIterator<T>;
@@ -109,8 +139,71 @@ public:
     ConstIterator cbegin(const TreeNode<T> *node, std::string order = "inorder") const;
     ConstIterator cend(const TreeNode<T> *node, std::string order = "inorder") const;
 
+    // Range queries for ordered trees (std::logic_error otherwise). The bounds are
+    // inorder iterators positioned in O(height) that walk on lazily to cend().
+    ConstIterator lowerBound(const T &value) const; // first key not below value
+    ConstIterator upperBound(const T &value) const; // first key above value
+    std::pair<ConstIterator, ConstIterator> equalRange(const T &value) const;
+    // Calls visitor on every key in [lo, hi] in ascending order, O(height + k)
+    void forEachInRange(const T &lo, const T &hi, std::function<void(const T &)> visitor) const;
+
+    // Read-only array snapshot for lookup-heavy use; later changes to the tree are not
+    // reflected in it. Keys of an unordered tree are sorted while freezing.
+    FrozenTree<T> freeze() const;
+    // Same for arithmetic T, laid out as a static B-tree searched with SSE/AVX2 where
+    // the CPU has them (see StaticSearchTree)
+    StaticSearchTree<T> freezeSimd(SimdLevel level = SimdLevel::Auto) const;
+
 protected:
     TreeNode<T> *buildBalancedTreeFromValues(const std::vector<T> &values, int start, int end);
+    const TreeNode<T> *orderedSearch(const T &value) const;
+    // Same descent, also reporting the parent of the node found (nullptr for the root)
+    const TreeNode<T> *orderedSearch(const T &value, const TreeNode<T> *&parent) const;
+    // Ordered trees remove along the search path in O(height); unordered ones swap the
+    // target with the last node in level order, found in the same single pass
+    void removeOrdered(const T &value);
+    void removeUnordered(const T &value);
+    // Puts replacement where node hangs below parent (or at the root)
+    void unlink(TreeNode<T> *parent, TreeNode<T> *node, TreeNode<T> *replacement);
+    TreeNode<T> *cloneNodes(const TreeNode<T> *node);
+    // Frees a detached subtree node by node; unlike destroyAll() it leaves the rest of
+    // the allocator's nodes alone
+    void destroyNodes(TreeNode<T> *node);
+    // Turns thread links back into null children
+    void removeThreads();
+    void mergeOrdered(const BinaryTree<T, Allocator> &other, bool unique);
+    ConstIterator boundOf(const T &value, bool strict) const;
+    // Pieces for parallel traversals: whole subtrees, and single nodes (second is
+    // false) split off above them, that together hold every node once, in inorder
+    using TreePiece = std::pair<const TreeNode<T> *, bool>;
+    std::vector<TreePiece> splitIntoPieces(unsigned threads) const;
+    // Calls visit on every value of the piece, in inorder
+    template <typename Visit>
+    void visitPiece(const TreePiece &piece, Visit visit) const;
+    // Runs work(i) for every i < count on up to `threads` threads, which take the next
+    // i as they finish one; the first exception thrown is rethrown here
+    template <typename Work>
+    static void runPieces(size_t count, unsigned threads, Work work);
+    // A tree cut for threads threads has about piecesPerThread pieces per thread
+    static const unsigned piecesPerThread = 4;
+    static const size_t batchLanes = 16;
+    // Whether insert() keeps equivalent keys; AVLTree drops them
+    virtual bool allowsDuplicates() const { return true; }
+    // Called after balance() or an ordered merge rebuilt the tree by midpoint splits.
+    // Trees that keep balance state in their nodes (colours, ranks) restore it here.
+    virtual void rebuilt() {}
+
+    // Shared by the self-balancing trees. A rotation relinks and recomputes height and
+    // size of the two nodes involved, child first, and returns the new subtree root.
+    static TreeNode<T> *rotateLeft(TreeNode<T> *x);
+    static TreeNode<T> *rotateRight(TreeNode<T> *y);
+    // Hangs replacement where node hangs below parent (or at the root); links only
+    void replaceChild(TreeNode<T> *parent, TreeNode<T> *node, TreeNode<T> *replacement);
+    // Per-thread scratch vector for the root-to-node path of an insert or remove
+    static std::vector<TreeNode<T> *> &pathBuffer();
+    // Refreshes path[count - 1] up to path[0] after a change below them: heights are
+    // recomputed until one comes out unchanged, above that only sizeDelta is added
+    static void updatePath(const std::vector<TreeNode<T> *> &path, size_t count, int sizeDelta);
 
 private:
     std::string threadedOrder;
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include "epochReclaimer.hpp"
+
+// AVL tree that many threads can read while others write. Writers take a mutex and
+// rebalance bottom-up as AVLTree does; readers never lock. A lookup descends
+// optimistically in the style of Bronson et al.: every node carries a version that a
+// writer makes odd while the node's subtree loses keys (it is rotated down or
+// unlinked) and advances when it is done. The reader checks hand over hand that the
+// parent did not change while it read the child link and restarts from the root if it
+// did. Range, min and max reads are checked against a tree-wide write sequence instead
+// and fall back to the writer mutex when writes keep overlapping them.
+//
+// Unlinked nodes may still be in use by readers, so writers retire them to an
+// EpochReclaimer that frees them in batches once the readers that could hold them are
+// gone. As in AVLTree, a key equivalent to one already stored is not inserted.
+template <typename T>
+class ConcurrentAVLTree
+{
+public:
+    ConcurrentAVLTree();
+    ConcurrentAVLTree(const ConcurrentAVLTree &) = delete;
+    ConcurrentAVLTree &operator=(const ConcurrentAVLTree &) = delete;
+    // No reader or writer may still be running
+    ~ConcurrentAVLTree();
+
+    // Writers; concurrent calls are serialized
+    void insert(const T &value);
+    void remove(const T &value);
+    void clear();
+
+    // Readers; safe alongside writers and each other
+    bool hasValue(const T &value) const;
+    // Keys in [lo, hi] in order, as they were at one moment during the call
+    std::vector<T> range(const T &lo, const T &hi) const;
+    T getMin() const;
+    T getMax() const;
+    size_t size() const;
+    bool isEmpty() const;
+    // Takes the writer mutex
+    int getHeight() const;
+
+private:
+    struct Node
+    {
+        const T data;
+        std::atomic<Node *> left;
+        std::atomic<Node *> right;
+        std::atomic<uint64_t> version; // odd while a writer shrinks this subtree
+        int height;                    // only read and written under the writer mutex
+
+        explicit Node(const T &data) : data(data), left(nullptr), right(nullptr), version(0), height(0) {}
+    };
+
+    enum class SearchResult
+    {
+        Found,
+        Missing,
+        Retry
+    };
+
+    std::atomic<Node *> root;
+    std::atomic<size_t> count;
+    std::atomic<uint64_t> writeSequence; // odd while a write is changing the tree
+    mutable std::mutex writerMutex;
+    EpochReclaimer<Node> reclaimer; // unlinked nodes readers may still hold
+    std::vector<Node *> path;       // writer scratch for the root-to-node path
+
+    // Optimistic snapshot reads give up and lock after this many overlapping writes
+    static const int snapshotAttempts = 4;
+
+    SearchResult attemptSearch(const T &value) const;
+    // Runs read(root, sequence) until no write overlapped it, then under the writer
+    // mutex. read may return false to give up early once writeChanged(sequence).
+    template <typename Read>
+    void readSnapshot(Read read) const;
+    bool writeChanged(uint64_t sequence) const;
+    bool collectRange(Node *node, const T &lo, const T &hi, uint64_t sequence, std::vector<T> &out) const;
+
+    void beginWrite();
+    void endWrite();
+
+    static Node *leftOf(const Node *node) { return node->left.load(std::memory_order_relaxed); }
+    static Node *rightOf(const Node *node) { return node->right.load(std::memory_order_relaxed); }
+    static int heightOf(const Node *node) { return node ? node->height : -1; }
+    static void updateHeight(Node *node);
+    // Marks node as shrinking until endChange; readers that see it restart
+    static void beginChange(Node *node);
+    static void endChange(Node *node);
+
+    // The node moved down is left marked; the caller ends the change once the new top
+    // is linked in
+    static Node *rotateLeft(Node *node);
+    static Node *rotateRight(Node *node);
+    void replaceChild(Node *parent, Node *node, Node *replacement);
+    // Restores the AVL balance of node, whose parent is given, and returns the new top
+    Node *rebalance(Node *parent, Node *node);
+    // Refreshes path[last]..path[0] after an insert or remove below path[last]
+    void retrace(size_t last);
+
+    static void destroy(Node *node);
+};
+
+#include "../impl/concurrentAVLTree.tpp"
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "treeDetail.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Epoch-based reclamation for nodes that lock-free readers may still hold after a
+// writer unlinked them. Readers hold a Guard while they traverse; writers retire
+// unlinked nodes instead of freeing them. The epoch only moves on once every reader
+// that entered under the previous epoch has left, and a retired node is freed two
+// epochs after the one it was retired in, when no reader can still reach it.
+//
+// Readers count themselves in one of a few cache-line sized slots, picked per thread,
+// and in the half of it that matches the parity of the epoch they entered under. So
+// readers write no counter shared by all of them, a reader never waits, and readers
+// that keep overlapping do not hold frees back forever as long as each of them leaves.
+//
+// Guards may be taken by any number of threads at once. retire and collect must be
+// serialized by the caller, e.g. by the writer mutex of the structure using them.
+template <typename Node, typename Deleter = std::default_delete<Node>>
+class EpochReclaimer
+{
+    struct alignas(64) Slot
+    {
+        std::atomic<size_t> readers[2];
+
+        Slot();
+    };
+
+public:
+    // Keeps the nodes seen while it lives from being freed
+    class Guard
+    {
+    public:
+        explicit Guard(const EpochReclaimer &reclaimer);
+        Guard(const Guard &) = delete;
+        Guard &operator=(const Guard &) = delete;
+        ~Guard();
+
+    private:
+        std::atomic<size_t> *counter;
+    };
+
+    // Retiring every batchSize-th node tries to free the older batch
+    explicit EpochReclaimer(size_t batchSize = 64, Deleter deleter = Deleter());
+    EpochReclaimer(const EpochReclaimer &) = delete;
+    EpochReclaimer &operator=(const EpochReclaimer &) = delete;
+    // Frees every retired node; no guard may be held any more
+    ~EpochReclaimer();
+
+    // The slots stay on their own cache lines when a reclaimer is allocated on its own
+    static void *operator new(size_t bytes) { return tree_detail::cacheAlignedNew(bytes); }
+    static void operator delete(void *reclaimer) { tree_detail::cacheAlignedDelete(reclaimer); }
+
+    // node must already be unreachable for readers that enter from now on
+    void retire(Node *node);
+    // Frees the nodes retired before the current epoch and moves the epoch on, unless
+    // a reader from the previous epoch is still inside. Returns whether it did.
+    bool collect();
+
+    size_t pending() const { return retired[0].size() + retired[1].size(); }
+    uint64_t epoch() const { return globalEpoch.load(std::memory_order_relaxed); }
+
+private:
+    static const size_t slotCount = 16;
+
+    mutable Slot slots[slotCount];
+    std::atomic<uint64_t> globalEpoch;
+    std::vector<Node *> retired[2]; // by the parity of the epoch they were retired in
+    size_t batchSize;
+    Deleter deleter;
+
+    static size_t threadSlot();
+};
+
+#include "../impl/epochReclaimer.tpp"
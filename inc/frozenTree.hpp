@@ -0,0 +1,67 @@
+#pragma once
+
+#include "treeDetail.hpp"
+#include <cstddef>
+#include <vector>
+
+// Immutable snapshot of an ordered tree, produced by BinaryTree::freeze(). The keys are
+// stored in one array in Eytzinger (BFS) order: the children of slot k are 2k and 2k+1,
+// slot 0 is unused. A lookup is a branch-free descent over that array that prefetches
+// the cache line holding the descendants a few levels further down.
+template <typename T>
+class FrozenTree
+{
+public:
+    // Walks the snapshot in ascending order; the end iterator has index 0
+    class ConstIterator
+    {
+        friend class FrozenTree;
+
+    public:
+        const T &operator*() const;
+        ConstIterator &operator++();
+        ConstIterator operator++(int);
+        bool operator!=(const ConstIterator &other) const;
+        bool operator==(const ConstIterator &other) const;
+
+    private:
+        const FrozenTree *tree;
+        size_t index;
+
+        ConstIterator(const FrozenTree *tree, size_t index) : tree(tree), index(index) {}
+    };
+
+    FrozenTree();
+    // Builds the layout from the keys in any order; they are sorted first if needed
+    explicit FrozenTree(std::vector<T> values);
+    FrozenTree(const FrozenTree &other);
+    FrozenTree &operator=(const FrozenTree &other);
+    // other is left empty
+    FrozenTree(FrozenTree &&other) noexcept;
+    FrozenTree &operator=(FrozenTree &&other) noexcept;
+
+    size_t size() const;
+    bool isEmpty() const;
+
+    bool hasValue(const T &value) const;
+    ConstIterator lowerBound(const T &value) const; // first key not below value
+    ConstIterator upperBound(const T &value) const; // first key above value
+
+    ConstIterator cbegin() const;
+    ConstIterator cend() const;
+
+private:
+    std::vector<T> storage;
+    size_t offset; // slot 0 of storage on a cache line boundary
+    size_t count;
+
+    const T *keys() const { return storage.data() + offset; }
+    T *keys() { return storage.data() + offset; }
+    void allocate(size_t slots);
+    void fill(const std::vector<T> &sorted, size_t &next, size_t k);
+    size_t descend(const T &value, bool strict) const;
+    size_t firstIndex() const;
+    size_t nextIndex(size_t k) const;
+};
+
+#include "../impl/frozenTree.tpp"
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <type_traits>
+#include <vector>
+
+// AVL tree for trivially copyable keys that keeps its nodes in parallel arrays (struct
+// of arrays) instead of heap nodes: keys, left/right child indices and heights. Index 0
+// is a sentinel meaning "no child" with height -1. Freed slots are chained through
+// `left` into a free list and reused by later inserts, as in PoolNodeAllocator. A
+// descent only touches the key and link arrays, and copying the tree copies four flat
+// arrays. As in AVLTree, a key equivalent to one already stored is not inserted.
+template <typename T>
+class IndexedAVLTree
+{
+    static_assert(std::is_trivially_copyable<T>::value, "IndexedAVLTree needs a trivially copyable key type");
+
+public:
+    using Index = uint32_t;
+
+    // Inorder walk with an explicit stack of indices; the end iterator has an empty stack
+    class ConstIterator
+    {
+        friend class IndexedAVLTree;
+
+    public:
+        const T &operator*() const;
+        ConstIterator &operator++();
+        ConstIterator operator++(int);
+        bool operator!=(const ConstIterator &other) const;
+        bool operator==(const ConstIterator &other) const;
+
+    private:
+        const IndexedAVLTree *tree;
+        std::vector<Index> path;
+
+        explicit ConstIterator(const IndexedAVLTree *tree) : tree(tree) {}
+        void pushLeftSpine(Index node);
+    };
+
+    IndexedAVLTree();
+    // Sorts the range if needed and builds a balanced tree in one pass
+    template <typename InputIt>
+    IndexedAVLTree(InputIt first, InputIt last);
+
+    void insert(const T &value);
+    void remove(const T &value);
+
+    // Stored key equal to value, or nullptr
+    const T *search(const T &value) const;
+    bool hasValue(const T &value) const;
+
+    const T &getMin() const;
+    const T &getMax() const;
+    int getHeight() const;
+    size_t size() const;
+    bool isEmpty() const;
+    void clear();
+
+    ConstIterator cbegin() const;
+    ConstIterator cend() const;
+    void inorderTraversal(std::ostream &os = std::cout) const;
+
+private:
+    std::vector<T> keys;
+    std::vector<Index> left;
+    std::vector<Index> right;
+    std::vector<int8_t> heights; // AVL height stays below 1.45 log2(n + 2)
+    Index root;
+    Index freeList; // first free slot, 0 if none
+    size_t count;
+
+    Index find(const T &value) const;
+    Index createNode(const T &value);
+    Index build(const std::vector<T> &sorted, size_t start, size_t end);
+
+    void update(Index node);
+    Index rotateLeft(Index x);
+    Index rotateRight(Index y);
+    Index rebalance(Index node);
+
+    Index insert(Index node, const T &value);
+    // Unlinks the node equivalent to value and reports its slot in `removed`
+    Index remove(Index node, const T &value, Index &removed);
+    Index removeMin(Index node, Index &min);
+    // Puts a slot that is no longer linked on the free list
+    void releaseSlot(Index slot);
+};
+
+#include "../impl/indexedAVLTree.tpp"
@@ -2,63 +2,79 @@
 
 #include <vector>
 #include <cstddef>
+#include <string>
+#include <stdexcept>
 #include "treeNode.hpp"
 
-template <typename T>
+template <typename T, typename Allocator>
 class BinaryTree;
 
-template <typename T>
-class BinaryTreeIterator
+enum class TraversalOrder
 {
-    friend class BinaryTree<T>;
-
-public:
-    using NodePtr = TreeNode<T> *;
-
-    BinaryTreeIterator(NodePtr root, std::string order = "inorder");
-
-    T &operator*();
-    BinaryTreeIterator &operator++();
-    BinaryTreeIterator operator++(int);
-    BinaryTreeIterator &operator--();
-    BinaryTreeIterator operator--(int);
-    bool operator!=(const BinaryTreeIterator &other) const;
-    bool operator==(const BinaryTreeIterator &other) const;
-
-private:
-    std::vector<NodePtr> nodes;
-    size_t current;
-
-    void buildInOrder(NodePtr node);
-    void buildPreOrder(NodePtr node);
-    void buildPostOrder(NodePtr node);
+    Inorder,
+    Preorder,
+    Postorder
 };
 
-template <typename T>
-class ConstBinaryTreeIterator
+inline TraversalOrder parseTraversalOrder(const std::string &order)
+{
+    if (order == "preorder")
+    {
+        return TraversalOrder::Preorder;
+    }
+    if (order == "postorder")
+    {
+        return TraversalOrder::Postorder;
+    }
+    return TraversalOrder::Inorder;
+}
+
+// Iterators walk the tree lazily. They keep the path from the root to the current node
+// (O(height) memory), an empty path is the end() sentinel. Thread links are not followed.
+// Modifying the tree invalidates its iterators. NodePtr and Ref are TreeNode<T> * and
+// T & for the mutable iterator, their const counterparts for the const one.
+template <typename T, typename NodePtrType, typename Ref>
+class BasicTreeIterator
 {
-    friend class BinaryTree<T>;
+    template <typename, typename>
+    friend class BinaryTree;
 
 public:
+    // The pointer the iterator walks with, and the const node pointer under the name
+    // ConstBinaryTreeIterator has always offered
+    using NodePtr = NodePtrType;
     using ConstNodePtr = const TreeNode<T> *;
 
-    ConstBinaryTreeIterator(ConstNodePtr root, std::string order = "inorder");
+    BasicTreeIterator(NodePtr root, std::string order = "inorder");
 
-    const T &operator*() const;
-    ConstBinaryTreeIterator &operator++();
-    ConstBinaryTreeIterator operator++(int);
-    ConstBinaryTreeIterator &operator--();
-    ConstBinaryTreeIterator operator--(int);
-    bool operator!=(const ConstBinaryTreeIterator &other) const;
-    bool operator==(const ConstBinaryTreeIterator &other) const;
+    Ref operator*() const;
+    BasicTreeIterator &operator++();
+    BasicTreeIterator operator++(int);
+    BasicTreeIterator &operator--();
+    BasicTreeIterator operator--(int);
+    bool operator!=(const BasicTreeIterator &other) const;
+    bool operator==(const BasicTreeIterator &other) const;
 
 private:
-    std::vector<ConstNodePtr> nodes;
-    size_t current;
+    NodePtr root;
+    TraversalOrder order;
+    std::vector<NodePtr> path;
+
+    BasicTreeIterator(NodePtr root, TraversalOrder order, std::vector<NodePtr> path);
+
+    static NodePtr leftOf(NodePtr node);
+    static NodePtr rightOf(NodePtr node);
 
-    void buildInOrder(ConstNodePtr node);
-    void buildPreOrder(ConstNodePtr node);
-    void buildPostOrder(ConstNodePtr node);
+    void descendFirst(NodePtr node);
+    void descendLast(NodePtr node);
+    void next();
+    void prev();
 };
 
-#include "../impl/iterators.tpp"
\ No newline at end of file
+template <typename T>
+using BinaryTreeIterator = BasicTreeIterator<T, TreeNode<T> *, T &>;
+
+template <typename T>
+using ConstBinaryTreeIterator = BasicTreeIterator<T, const TreeNode<T> *, const T &>;
+
+#include "../impl/iterators.tpp"
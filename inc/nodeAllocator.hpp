@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+#include "treeNode.hpp"
+#include "epochReclaimer.hpp"
+
+// Node allocators used by BinaryTree/AVLTree. A tree owns its allocator and routes
+// every node it creates or frees through it:
+//   create(value)     - construct a detached node
+//   destroy(node)     - free one node, its children are left alone
+//   retire(node)      - free a node remove() just unlinked; readers outside the tree
+//                       may still hold it, so an allocator may defer the free
+//   destroyAll(root)  - free a whole tree; called from clear() and the destructor
+
+template <typename T>
+class HeapNodeAllocator
+{
+public:
+    TreeNode<T> *create(const T &value);
+    void destroy(TreeNode<T> *node);
+    void retire(TreeNode<T> *node) { destroy(node); }
+    void destroyAll(TreeNode<T> *root);
+};
+
+// Hands out nodes from slabs of NodesPerSlab slots. Freed nodes go to a free list and
+// are reused; destroyAll() returns the slabs in bulk instead of freeing node by node.
+// Nodes may only be linked with nodes of the same pool, and a pool is not thread-safe.
+template <typename T, size_t NodesPerSlab = 4096>
+class PoolNodeAllocator
+{
+public:
+    PoolNodeAllocator();
+    PoolNodeAllocator(const PoolNodeAllocator &) = delete;
+    PoolNodeAllocator &operator=(const PoolNodeAllocator &) = delete;
+    // The slabs change hands, so nodes created by other stay valid and belong to the
+    // new owner; other is left empty. Assignment releases this pool's slabs first.
+    PoolNodeAllocator(PoolNodeAllocator &&other) noexcept;
+    PoolNodeAllocator &operator=(PoolNodeAllocator &&other) noexcept;
+    ~PoolNodeAllocator();
+
+    TreeNode<T> *create(const T &value);
+    void destroy(TreeNode<T> *node);
+    void retire(TreeNode<T> *node) { destroy(node); }
+    void destroyAll(TreeNode<T> *root);
+
+    size_t slabCount() const;
+
+private:
+    union Slot
+    {
+        Slot *next;
+        typename std::aligned_storage<sizeof(TreeNode<T>), alignof(TreeNode<T>)>::type storage;
+    };
+
+    std::vector<Slot *> slabs;
+    Slot *freeList;
+    size_t usedInLastSlab;
+
+    void releaseSlabs();
+};
+
+// Heap nodes whose removal goes through an EpochReclaimer: retire() hands the node
+// to it, and it is freed once no reader that could have reached it holds a Guard.
+// Readers take a Guard on reclaimer() for as long as they hold nodes of the tree. The
+// tree's writers still have to be serialized and must not overlap with readers for
+// anything but remove(); destroy() and destroyAll() free at once, so clear() and the
+// destructor need the readers gone.
+template <typename T>
+class EpochNodeAllocator
+{
+    struct Deleter
+    {
+        void operator()(TreeNode<T> *node) const;
+    };
+
+public:
+    using Reclaimer = EpochReclaimer<TreeNode<T>, Deleter>;
+
+    explicit EpochNodeAllocator(size_t batchSize = 64);
+
+    TreeNode<T> *create(const T &value);
+    void destroy(TreeNode<T> *node);
+    void retire(TreeNode<T> *node);
+    void destroyAll(TreeNode<T> *root);
+
+    Reclaimer &reclaimer() const { return *retired; }
+
+private:
+    // Behind a pointer so that the allocator, and the tree holding it, can be moved
+    std::unique_ptr<Reclaimer> retired;
+};
+
+#include "../impl/nodeAllocator.tpp"
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+// Persistent AVL tree: a tree value never changes. insert and remove return a new
+// version that copies only the nodes on the path to the changed key (O(log n) of
+// them) and shares every other node with the old version. Nodes are reference counted
+// through shared_ptr, so a version and the nodes only it uses are freed when its last
+// copy goes. Copying a version is O(1), which makes it a cheap snapshot: a reader
+// keeps using its copy while writers derive new versions. As in AVLTree, a key
+// equivalent to one already stored is not inserted.
+template <typename T>
+class PersistentAVLTree
+{
+    struct Node;
+    using NodePtr = std::shared_ptr<const Node>;
+
+    struct Node
+    {
+        T data;
+        NodePtr left;
+        NodePtr right;
+        int height;
+        size_t size;
+
+        Node(const T &data, NodePtr left, NodePtr right);
+    };
+
+public:
+    // Inorder walk with an explicit stack; it holds on to the version it walks
+    class ConstIterator
+    {
+        friend class PersistentAVLTree;
+
+    public:
+        const T &operator*() const;
+        ConstIterator &operator++();
+        ConstIterator operator++(int);
+        bool operator!=(const ConstIterator &other) const;
+        bool operator==(const ConstIterator &other) const;
+
+    private:
+        NodePtr root;
+        std::vector<const Node *> path;
+
+        explicit ConstIterator(NodePtr root);
+        void pushLeftSpine(const Node *node);
+    };
+
+    PersistentAVLTree() = default;
+    // Sorts the range if needed and builds a balanced tree in one pass
+    template <typename InputIt>
+    PersistentAVLTree(InputIt first, InputIt last);
+
+    // New versions; this one is left as it is
+    PersistentAVLTree insert(const T &value) const;
+    PersistentAVLTree remove(const T &value) const;
+
+    // Stored key equal to value, or nullptr; valid while this version lives
+    const T *search(const T &value) const;
+    bool hasValue(const T &value) const;
+
+    const T &getMin() const;
+    const T &getMax() const;
+    int getHeight() const;
+    size_t size() const;
+    bool isEmpty() const;
+    // True if both are the same version or one was derived from the other without
+    // any change
+    bool sharesRootWith(const PersistentAVLTree &other) const { return root == other.root; }
+
+    ConstIterator cbegin() const;
+    ConstIterator cend() const;
+    void inorderTraversal(std::ostream &os = std::cout) const;
+
+    // Reading and replacing a version shared between threads, e.g. the current one
+    // that writers publish and readers take snapshots of
+    static PersistentAVLTree atomicLoad(const PersistentAVLTree *shared);
+    static void atomicStore(PersistentAVLTree *shared, PersistentAVLTree version);
+
+private:
+    NodePtr root;
+
+    explicit PersistentAVLTree(NodePtr root) : root(std::move(root)) {}
+
+    static int heightOf(const NodePtr &node) { return node ? node->height : -1; }
+    static NodePtr makeNode(const T &data, NodePtr left, NodePtr right);
+    // A new node for data over left and right, rotated if they differ in height by 2
+    static NodePtr balance(const T &data, NodePtr left, NodePtr right);
+    static NodePtr build(const std::vector<T> &sorted, size_t start, size_t end);
+
+    // Return node itself when nothing changed, so that an unchanged tree keeps its root
+    static NodePtr insert(const NodePtr &node, const T &value);
+    static NodePtr remove(const NodePtr &node, const T &value);
+    static NodePtr removeMin(const NodePtr &node, T &min);
+};
+
+#include "../impl/persistentAVLTree.tpp"
@@ -0,0 +1,51 @@
+#pragma once
+#include "binaryTree.hpp"
+
+// Red-black tree over the same nodes and interface as AVLTree. The colour is the node's
+// balance bit (set = red). Updates rebalance bottom-up along the recorded search path
+// and rotate at most twice per insert and three times per remove; most updates only
+// recolour. Heights and sizes are still refreshed along the path so getHeight() and
+// the size-based queries keep working. As in AVLTree, equivalent keys are kept once.
+template <typename T, typename Allocator = HeapNodeAllocator<T>>
+class RedBlackTree : public BinaryTree<T, Allocator>
+{
+public:
+    RedBlackTree() : BinaryTree<T, Allocator>() {}
+    RedBlackTree(const RedBlackTree &other) : BinaryTree<T, Allocator>(other) {}
+    RedBlackTree(RedBlackTree &&other) noexcept : BinaryTree<T, Allocator>(std::move(other)) {}
+    RedBlackTree &operator=(const RedBlackTree &other) = default;
+    RedBlackTree &operator=(RedBlackTree &&other) noexcept = default;
+    ~RedBlackTree() { this->clear(); }
+
+    void insert(const T &value) override;
+    void remove(const T &value) override;
+    BinaryTree<T, Allocator> *mergeImmutable(const BinaryTree<T, Allocator> &other) const override;
+    // Checks the red-black rules instead of the AVL height condition: a black root, no
+    // red node with a red child and the same number of black nodes on every path
+    bool isBalanced() const override;
+
+protected:
+    bool allowsDuplicates() const override { return false; }
+    // A midpoint-built tree has all its empty links on two adjacent levels, so colouring
+    // the deepest level red and everything else black is valid
+    void rebuilt() override;
+
+private:
+    using BinaryTree<T, Allocator>::rotateLeft;
+    using BinaryTree<T, Allocator>::rotateRight;
+
+    static bool isRed(const TreeNode<T> *node) { return node && node->getBalanceBit(); }
+    static void setRed(TreeNode<T> *node, bool red) { node->setBalanceBit(red); }
+
+    // Restores the rules after a red leaf was hung below path.back()
+    void fixInsert(std::vector<TreeNode<T> *> &path, TreeNode<T> *node);
+    // Restores the black height after a black node was removed below path.back();
+    // node took its place (possibly nullptr) on the side given by left
+    void fixRemove(std::vector<TreeNode<T> *> &path, TreeNode<T> *node, bool left);
+
+    void colourByDepth(TreeNode<T> *node, int depth, int deepest);
+    // Black height of a valid subtree, -1 if the rules are broken inside it
+    static int blackHeight(const TreeNode<T> *node);
+};
+
+#include "../impl/redBlackTree.tpp"
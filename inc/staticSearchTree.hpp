@@ -0,0 +1,69 @@
+#pragma once
+
+#include "treeDetail.hpp"
+#include <cstddef>
+#include <vector>
+#include <type_traits>
+
+// Instruction sets StaticSearchTree can compare keys with. Auto picks the best one the
+// CPU supports; asking for more than that falls back to what is available.
+enum class SimdLevel
+{
+    Auto,
+    Scalar,
+    SSE2,
+    AVX2
+};
+
+// Static B-tree ("S-tree") over the keys of a tree, for arithmetic T. Every node is one
+// 64-byte cache line of sorted keys, node k has children k * (B + 1) + i + 1 for
+// i = 0..B, and the nodes sit in one array in BFS order. A lookup reads one line per
+// level and finds its position in the line with a SIMD compare and a popcount:
+// SSE2/AVX2 for int and double on x86, plain comparisons for other types and targets
+// (WebAssembly included).
+template <typename T>
+class StaticSearchTree
+{
+    static_assert(std::is_arithmetic<T>::value, "StaticSearchTree needs an arithmetic key type");
+
+public:
+    // Keys per node
+    static const size_t BlockSize = sizeof(T) >= 64 ? 1 : 64 / sizeof(T);
+
+    StaticSearchTree();
+    // Builds from the keys in any order; they are sorted first if needed. Throws
+    // std::invalid_argument on a NaN key.
+    explicit StaticSearchTree(std::vector<T> values, SimdLevel level = SimdLevel::Auto);
+    StaticSearchTree(const StaticSearchTree &other);
+    StaticSearchTree &operator=(const StaticSearchTree &other);
+    // other is left empty
+    StaticSearchTree(StaticSearchTree &&other) noexcept;
+    StaticSearchTree &operator=(StaticSearchTree &&other) noexcept;
+
+    size_t size() const;
+    bool isEmpty() const;
+    SimdLevel simdLevel() const;
+    static SimdLevel supportedSimdLevel();
+
+    bool hasValue(const T &value) const;
+    // One answer per query. The queries are walked down the tree in groups, level by
+    // level, so the memory accesses of a group overlap.
+    std::vector<bool> hasValues(const std::vector<T> &values) const;
+
+private:
+    std::vector<T> storage;
+    size_t offset;     // first slot of storage on a cache line boundary
+    size_t blockCount;
+    size_t count;
+    bool padIsKey;     // the padding value (numeric max, +inf for floats) is also a real key
+    SimdLevel level;
+
+    const T *blocks() const { return storage.data() + offset; }
+    T *blocks() { return storage.data() + offset; }
+    void allocate(size_t blocks);
+    void fill(const std::vector<T> &sorted, size_t &next, size_t k);
+
+    bool matches(const T &candidate, const T &value) const;
+};
+
+#include "../impl/staticSearchTree.tpp"
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+// Small low-level helpers shared by the tree implementations
+namespace tree_detail
+{
+    // Hint that address will be read soon; a no-op where the compiler has no builtin
+    inline void prefetch(const void *address)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(address);
+#else
+        (void)address;
+#endif
+    }
+
+    // Number of consecutive 1 bits at the low end of k
+    inline unsigned trailingOnes(size_t k)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned>(__builtin_ctzll(~static_cast<unsigned long long>(k)));
+#else
+        unsigned ones = 0;
+        while (k & 1)
+        {
+            k >>= 1;
+            ++ones;
+        }
+        return ones;
+#endif
+    }
+
+    // Storage starting on a cache line boundary, which plain new does not promise for
+    // over-aligned types before C++17. The raw pointer is kept just below the block.
+    inline void *cacheAlignedNew(size_t bytes)
+    {
+        void *raw = ::operator new(bytes + 64 + sizeof(void *));
+        uintptr_t aligned = (reinterpret_cast<uintptr_t>(raw) + sizeof(void *) + 63) & ~uintptr_t(63);
+        reinterpret_cast<void **>(aligned)[-1] = raw;
+        return reinterpret_cast<void *>(aligned);
+    }
+
+    inline void cacheAlignedDelete(void *block)
+    {
+        if (block)
+        {
+            ::operator delete(static_cast<void **>(block)[-1]);
+        }
+    }
+}
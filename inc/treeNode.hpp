@@ -1,21 +1,36 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+
 template <typename T>
 class TreeNode
 {
 private:
     T data;
-    TreeNode<T> *left;
-    TreeNode<T> *right;
+    // Next to data so that small keys share its 8-byte word
+    int height = 0;
 
-    bool isLeftThread;
-    bool isRightThread;
+    // Child links. Bit 0 marks a thread (an inorder neighbour instead of a child); nodes
+    // are at least pointer-aligned, so the bit is free and no flag bytes are needed.
+    // TreeNode<int> is 32 bytes instead of 40 this way. Bit 1 of the left link is a
+    // spare balance bit for trees that need one flag per node (red-black colour, WAVL
+    // rank parity); relinking keeps it.
+    uintptr_t leftLink;
+    uintptr_t rightLink;
 
-    int height = 0;
+    // Number of nodes in the subtree rooted here, kept up to date by setLeft/setRight
+    // like height; thread links are not counted
+    size_t size = 1;
+
+    static const uintptr_t threadBit = 1;
+    static const uintptr_t balanceBit = 2;
+    static uintptr_t linkOf(const TreeNode<T> *node, bool thread);
+    static TreeNode<T> *nodeOf(uintptr_t link);
 
 public:
-    TreeNode() : data(T()), left(nullptr), right(nullptr), isLeftThread(false), isRightThread(false), height(0) {}
-    TreeNode(T value) : data(value), left(nullptr), right(nullptr), isLeftThread(false), isRightThread(false), height(0) {}
+    TreeNode() : data(T()), height(0), leftLink(0), rightLink(0), size(1) {}
+    TreeNode(T value) : data(value), height(0), leftLink(0), rightLink(0), size(1) {}
 
     ~TreeNode();
 
@@ -24,6 +39,8 @@ public:
     const int getHeight() const;
     void setHeight(int h);
 
+    size_t getSize() const;
+
     const T &getData() const;
     T &getData();
 
@@ -39,6 +56,16 @@ public:
     void setData(T value);
     void setLeft(TreeNode<T> *node);
     void setRight(TreeNode<T> *node);
+    // Relink without touching height and size, for callers that fix those up themselves
+    // (AVL retracing, which can stop recomputing heights part way up)
+    void linkLeft(TreeNode<T> *node);
+    void linkRight(TreeNode<T> *node);
+    // Recomputes height and size from the children
+    void update();
+    void setSize(size_t s);
+
+    bool getBalanceBit() const;
+    void setBalanceBit(bool bit);
 
     bool isLeaf() const;
     bool hasChildren() const;
@@ -57,6 +84,9 @@ public:
     void setLeftThread(TreeNode<T> *node);
     void setRightThread(TreeNode<T> *node);
     void clearThreads();
+
+    // Forget both links without deleting what they point to
+    void detach();
 };
 
 #include "../impl/treeNode.tpp"
\ No newline at end of file
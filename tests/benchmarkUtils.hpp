@@ -0,0 +1,124 @@
+#pragma once
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Helpers shared by the backend comparison benchmarks
+
+// Opens tests/<filename> for a benchmark's CSV output; reports and returns false if
+// it cannot be created
+inline bool open_results_file(std::ofstream &ofs, const std::string &filename)
+{
+    ofs.open("../tests/" + filename);
+    if (!ofs.is_open())
+    {
+        std::cerr << "Failed to open file: tests/" << filename << std::endl;
+        return false;
+    }
+    std::cout << "File opened successfully: tests/" << filename << std::endl;
+    return true;
+}
+
+// n random positive keys and `queries` lookups of which every other one is a key
+inline void random_workload(std::mt19937 &rng, size_t n, size_t queries, std::vector<int> &data,
+                            std::vector<int> &probes)
+{
+    std::uniform_int_distribution<int> dist(1, 2e9);
+    data.resize(n);
+    for (size_t i = 0; i < n; ++i)
+        data[i] = dist(rng);
+    std::uniform_int_distribution<size_t> pick(0, n - 1);
+    probes.resize(queries);
+    for (size_t i = 0; i < queries; ++i)
+        probes[i] = (i % 2 == 0) ? data[pick(rng)] : -static_cast<int>(i) - 1;
+}
+
+// Comma-separated integers, e.g. the thread counts of "threads=1,2,4"
+inline std::vector<int> parse_list(const std::string &text)
+{
+    std::vector<int> values;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ','))
+        values.push_back(std::atoi(item.c_str()));
+    return values;
+}
+
+// Hands the value of every name=value argument to the option of that name; reports an
+// unknown argument and returns false
+inline bool parse_arguments(int argc, char **argv,
+                            const std::map<std::string, std::function<void(const std::string &)>> &options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        size_t eq = arg.find('=');
+        auto option = eq == std::string::npos ? options.end() : options.find(arg.substr(0, eq));
+        if (option == options.end())
+        {
+            std::cerr << "Unknown argument: " << arg << std::endl;
+            return false;
+        }
+        option->second(arg.substr(eq + 1));
+    }
+    return true;
+}
+
+struct BackendTimes
+{
+    double insert, search, iterate, copy, remove;
+};
+
+// Times the same workload on a tree backend: n random inserts, `queries` lookups
+// (half hits), a full inorder walk, a copy and removing every other key
+template <typename Tree>
+BackendTimes measure_backend(const std::vector<int> &data, const std::vector<int> &probes)
+{
+    BackendTimes times;
+    Tree tree;
+    auto t1 = std::chrono::high_resolution_clock::now();
+    for (int x : data)
+        tree.insert(x);
+    auto t2 = std::chrono::high_resolution_clock::now();
+    times.insert = std::chrono::duration<double>(t2 - t1).count();
+
+    size_t found = 0;
+    t1 = std::chrono::high_resolution_clock::now();
+    for (int x : probes)
+        found += tree.hasValue(x) ? 1 : 0;
+    t2 = std::chrono::high_resolution_clock::now();
+    times.search = std::chrono::duration<double>(t2 - t1).count();
+    if (found < probes.size() / 2)
+        std::cerr << "Lookup mismatch: " << found << " hits of " << probes.size() / 2 << std::endl;
+
+    long long sum = 0;
+    t1 = std::chrono::high_resolution_clock::now();
+    for (auto it = tree.cbegin(); it != tree.cend(); ++it)
+        sum += *it;
+    t2 = std::chrono::high_resolution_clock::now();
+    times.iterate = std::chrono::duration<double>(t2 - t1).count();
+    if (sum == 0)
+        std::cerr << "Empty walk" << std::endl;
+
+    t1 = std::chrono::high_resolution_clock::now();
+    {
+        Tree copy(tree);
+        t2 = std::chrono::high_resolution_clock::now();
+    }
+    times.copy = std::chrono::duration<double>(t2 - t1).count();
+
+    t1 = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < data.size(); i += 2)
+        tree.remove(data[i]);
+    t2 = std::chrono::high_resolution_clock::now();
+    times.remove = std::chrono::duration<double>(t2 - t1).count();
+    return times;
+}
@@ -148,6 +148,7 @@ if __name__ == "__main__":
     files_to_process = [
         ("performance_insert_improved.csv", "Insert Performance"),
         ("performance_search.csv", "Search Performance"),
+        ("performance_sorted_search.csv", "Sorted Search Performance"),
         ("performance_sorted_insert.csv", "Sorted Insert Performance"),
         ("large_sorted_performance.csv", "Large Sorted Performance"),
         ("medium_sorted_performance.csv", "Medium Sorted Performance"),
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "../inc/treeNode.hpp"
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <type_traits>
+#include <vector>
+
+// Helpers shared by the tree test suites
+
+// The keys of any tree or snapshot in the order its const iterator yields them
+template <typename Container>
+std::vector<typename std::decay<decltype(*std::declval<const Container &>().cbegin())>::type>
+valuesOf(const Container &container)
+{
+    std::vector<typename std::decay<decltype(*container.cbegin())>::type> values;
+    for (auto it = container.cbegin(); it != container.cend(); ++it)
+        values.push_back(*it);
+    return values;
+}
+
+// Height of the subtree if every node below stores its true height and subtree size and
+// the keys ascend strictly from left to right, else -100. Heights of sibling subtrees
+// may differ by at most maxSkew, so 1 also checks the AVL balance.
+template <typename T>
+int checkedHeight(const TreeNode<T> *node, int maxSkew = INT_MAX)
+{
+    if (!node)
+        return -1;
+    int left = checkedHeight(node->getLeft(), maxSkew);
+    int right = checkedHeight(node->getRight(), maxSkew);
+    if (left == -100 || right == -100 || std::abs(left - right) > maxSkew)
+        return -100;
+    size_t size = 1 + (node->getLeft() ? node->getLeft()->getSize() : 0) +
+                  (node->getRight() ? node->getRight()->getSize() : 0);
+    if (node->getSize() != size || node->getHeight() != 1 + std::max(left, right))
+        return -100;
+    if ((node->getLeft() && !(node->getLeft()->getData() < node->getData())) ||
+        (node->getRight() && !(node->getData() < node->getRight()->getData())))
+        return -100;
+    return node->getHeight();
+}
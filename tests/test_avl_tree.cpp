@@ -2,12 +2,14 @@
 #include "../inc/AVLTree.hpp"
 #include "../types/complex.hpp"
 #include "../types/person.hpp"
+#include "testUtils.hpp"
 #include <string>
 #include <set>
 #include <algorithm>
 #include <random>
 #include <chrono>
 #include <vector>
+#include <iterator>
 
 TEST(AVLTreeInt, InsertAndHasValue)
 {
@@ -65,6 +67,25 @@ TEST(AVLTreeInt, MinMax)
     EXPECT_EQ(tree.getMax(), 20);
 }
 
+TEST(AVLTreeInt, MinMaxTrackUpdates)
+{
+    AVLTree<int> tree;
+    for (int i = 50; i >= 1; --i)
+    {
+        tree.insert(i);
+        EXPECT_EQ(tree.getMin(), i);
+        EXPECT_EQ(tree.getMax(), 50);
+    }
+    for (int i = 1; i < 50; ++i)
+    {
+        tree.remove(i);
+        EXPECT_EQ(tree.getMin(), i + 1);
+    }
+    const AVLTree<int> &constTree = tree;
+    EXPECT_EQ(constTree.getMin(), 50);
+    EXPECT_EQ(constTree.getMaxNode(), constTree.getMinNode());
+}
+
 TEST(AVLTreeInt, IsBalancedAlways)
 {
     AVLTree<int> tree;
@@ -124,6 +145,38 @@ TEST(AVLTreeInt, MergeAndOperatorPlus)
         EXPECT_TRUE(t1.hasValue(i));
 }
 
+TEST(AVLTreeInt, MergeOverlappingRebalances)
+{
+    AVLTree<int> t1, t2;
+    for (int i = 0; i < 500; ++i)
+        t1.insert(i);
+    for (int i = 250; i < 1000; ++i)
+        t2.insert(i);
+
+    BinaryTree<int> *merged = t1.mergeImmutable(t2);
+    ASSERT_NE(dynamic_cast<AVLTree<int> *>(merged), nullptr);
+    t1.merge(t2);
+
+    std::vector<int> expected;
+    for (int i = 0; i < 1000; ++i)
+        expected.push_back(i);
+    for (const BinaryTree<int> *tree : {static_cast<const BinaryTree<int> *>(&t1), static_cast<const BinaryTree<int> *>(merged)})
+    {
+        std::vector<int> values;
+        for (auto it = tree->cbegin(); it != tree->cend(); ++it)
+            values.push_back(*it);
+        EXPECT_EQ(values, expected);
+        EXPECT_TRUE(tree->isBalancedHelper(tree->getRoot()) != -1);
+    }
+    EXPECT_EQ(t1.getHeight(t1.getRoot()), 9);
+
+    // The merged tree keeps working as an AVL tree
+    for (int i = 0; i < 1000; i += 2)
+        t1.remove(i);
+    EXPECT_TRUE(t1.isBalancedHelper(t1.getRoot()) != -1);
+    delete merged;
+}
+
 TEST(AVLTreeInt, WhereApplyReduce)
 {
     AVLTree<int> tree;
@@ -345,3 +398,494 @@ TEST(AVLTreeBalance, SequentialInsertions)
         EXPECT_TRUE(tree.hasValue(i));
     }
 }
+
+// Bulk loading
+TEST(AVLTreeBulkLoad, SortedInput)
+{
+    std::vector<int> values;
+    for (int i = 0; i < 1000; ++i)
+        values.push_back(i * 2);
+    AVLTree<int> tree(values.begin(), values.end());
+    EXPECT_NE(checkedHeight(tree.getRoot(), 1), -100);
+    for (int i = 0; i < 1000; ++i)
+    {
+        EXPECT_TRUE(tree.hasValue(i * 2));
+        EXPECT_FALSE(tree.hasValue(i * 2 + 1));
+    }
+
+    // The result keeps working as a normal AVL tree
+    for (int i = 0; i < 1000; ++i)
+        tree.insert(i * 2 + 1);
+    for (int i = 0; i < 2000; i += 3)
+        tree.remove(i);
+    EXPECT_NE(checkedHeight(tree.getRoot(), 1), -100);
+}
+
+TEST(AVLTreeBulkLoad, UnsortedInputWithDuplicates)
+{
+    std::vector<int> values = {5, 3, 9, 3, 1, 5, 7, 9, 9};
+    AVLTree<int> tree;
+    tree.insert(100);
+    EXPECT_EQ(tree.bulkLoad(values.begin(), values.end()), 4u);
+    EXPECT_FALSE(tree.hasValue(100));
+    EXPECT_NE(checkedHeight(tree.getRoot(), 1), -100);
+
+    std::vector<int> inorder;
+    for (auto it = tree.cbegin(); it != tree.cend(); ++it)
+        inorder.push_back(*it);
+    EXPECT_EQ(inorder, std::vector<int>({1, 3, 5, 7, 9}));
+}
+
+TEST(AVLTreeBulkLoad, EquivalentKeysKeepFirst)
+{
+    std::vector<Person> people = {Person("Bob", 30), Person("Alice", 25), Person("Carol", 30)};
+    AVLTree<Person> tree(people.begin(), people.end());
+    EXPECT_TRUE(tree.hasValue(Person("Bob", 30)));
+    EXPECT_FALSE(tree.hasValue(Person("Carol", 30)));
+    EXPECT_TRUE(tree.isBalanced());
+}
+
+// AVL tree backed by a node pool
+TEST(AVLTreePool, InsertRemoveSearch)
+{
+    AVLTree<int, PoolNodeAllocator<int>> tree;
+    for (int i = 0; i < 10000; ++i)
+        tree.insert(i);
+    EXPECT_TRUE(tree.isBalanced());
+    for (int i = 0; i < 10000; i += 2)
+        tree.remove(i);
+    for (int i = 0; i < 10000; ++i)
+        EXPECT_EQ(tree.hasValue(i), i % 2 == 1);
+    EXPECT_EQ(tree.getMin(), 1);
+    EXPECT_EQ(tree.getMax(), 9999);
+}
+
+TEST(AVLTreePool, ClearAndReuse)
+{
+    AVLTree<std::string, PoolNodeAllocator<std::string, 16>> tree;
+    for (int i = 0; i < 100; ++i)
+        tree.insert("str" + std::to_string(i));
+    tree.clear();
+    EXPECT_TRUE(tree.isEmpty());
+    EXPECT_FALSE(tree.hasValue("str1"));
+    for (int i = 0; i < 50; ++i)
+        tree.insert("key" + std::to_string(i));
+    for (int i = 0; i < 50; ++i)
+        EXPECT_TRUE(tree.hasValue("key" + std::to_string(i)));
+}
+
+TEST(AVLTreePool, CopyUsesOwnPool)
+{
+    AVLTree<int, PoolNodeAllocator<int>> original;
+    for (int i = 0; i < 100; ++i)
+        original.insert(i);
+    AVLTree<int, PoolNodeAllocator<int>> copy(original);
+    original.clear();
+    for (int i = 0; i < 100; ++i)
+        EXPECT_TRUE(copy.hasValue(i));
+    EXPECT_TRUE(copy.isBalanced());
+}
+
+TEST(AVLTreePool, MoveKeepsBalance)
+{
+    AVLTree<int, PoolNodeAllocator<int>> original;
+    for (int i = 0; i < 100; ++i)
+        original.insert(i);
+    AVLTree<int, PoolNodeAllocator<int>> moved(std::move(original));
+    EXPECT_TRUE(original.isEmpty());
+    EXPECT_TRUE(moved.isBalanced());
+
+    AVLTree<int, PoolNodeAllocator<int>> assigned;
+    assigned.insert(-1);
+    assigned = std::move(moved);
+    for (int i = 100; i < 200; ++i)
+        assigned.insert(i);
+    assigned.remove(50);
+    EXPECT_TRUE(assigned.isBalanced());
+    EXPECT_FALSE(assigned.hasValue(-1));
+    EXPECT_FALSE(assigned.hasValue(50));
+    EXPECT_TRUE(assigned.hasValue(199));
+}
+
+// Join/split based set operations
+TEST(AVLTreeSetOps, MatchStdSet)
+{
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> dist(0, 5000);
+    for (size_t sizeB : {0u, 1u, 10u, 300u, 3000u})
+    {
+        std::set<int> a, b;
+        while (a.size() < 1000)
+            a.insert(dist(rng));
+        while (b.size() < sizeB)
+            b.insert(dist(rng));
+        AVLTree<int> ta(a.begin(), a.end());
+        AVLTree<int> tb(b.begin(), b.end());
+
+        std::vector<int> expected;
+        std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+        AVLTree<int> u = ta.unionWith(tb);
+        EXPECT_NE(checkedHeight(u.getRoot(), 1), -100);
+        EXPECT_EQ(valuesOf(u), expected);
+
+        expected.clear();
+        std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+        AVLTree<int> i = tb.intersect(ta);
+        EXPECT_NE(checkedHeight(i.getRoot(), 1), -100);
+        EXPECT_EQ(valuesOf(i), expected);
+
+        expected.clear();
+        std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+        AVLTree<int> d = ta.difference(tb);
+        EXPECT_NE(checkedHeight(d.getRoot(), 1), -100);
+        EXPECT_EQ(valuesOf(d), expected);
+
+        // Operands are left untouched
+        EXPECT_EQ(valuesOf(ta), std::vector<int>(a.begin(), a.end()));
+        EXPECT_EQ(valuesOf(tb), std::vector<int>(b.begin(), b.end()));
+    }
+}
+
+TEST(AVLTreeSetOps, SelfOperations)
+{
+    AVLTree<int> tree;
+    for (int i = 0; i < 100; ++i)
+        tree.insert(i);
+    EXPECT_EQ(valuesOf(tree.unionWith(tree)), valuesOf(tree));
+    EXPECT_EQ(valuesOf(tree.intersect(tree)), valuesOf(tree));
+    EXPECT_TRUE(tree.difference(tree).isEmpty());
+}
+
+TEST(AVLTreeSetOps, PersonKeepsLeftElement)
+{
+    AVLTree<Person> a, b;
+    a.insert(Person("Alice", 25));
+    a.insert(Person("Bob", 30));
+    b.insert(Person("Carol", 30));
+    b.insert(Person("Dave", 40));
+
+    AVLTree<Person> u = a.unionWith(b);
+    EXPECT_TRUE(u.hasValue(Person("Bob", 30)));
+    EXPECT_FALSE(u.hasValue(Person("Carol", 30)));
+    EXPECT_TRUE(u.hasValue(Person("Dave", 40)));
+
+    AVLTree<Person> i = b.intersect(a);
+    EXPECT_TRUE(i.hasValue(Person("Carol", 30)));
+    EXPECT_FALSE(i.hasValue(Person("Alice", 25)));
+
+    AVLTree<Person> d = a.difference(b);
+    EXPECT_TRUE(d.hasValue(Person("Alice", 25)));
+    EXPECT_FALSE(d.hasValue(Person("Bob", 30)));
+}
+
+TEST(AVLTreeSetOps, Complex)
+{
+    AVLTree<Complex> a, b;
+    for (int i = 1; i <= 6; ++i)
+        a.insert(Complex(i, 0));
+    for (int i = 4; i <= 9; ++i)
+        b.insert(Complex(0, i));
+
+    AVLTree<Complex> u = a.unionWith(b);
+    EXPECT_TRUE(u.hasValue(Complex(1, 0)));
+    EXPECT_TRUE(u.hasValue(Complex(9, 0)) || u.hasValue(Complex(0, 9)));
+    EXPECT_EQ(a.intersect(b).getMin(), Complex(4, 0));
+    EXPECT_EQ(a.difference(b).getMax(), Complex(3, 0));
+}
+
+TEST(AVLTreeSetOps, SplitAndJoin)
+{
+    AVLTree<int> tree, less, greater;
+    for (int i = 0; i < 1000; ++i)
+        tree.insert(i);
+
+    EXPECT_TRUE(tree.split(400, less, greater));
+    EXPECT_TRUE(tree.isEmpty());
+    EXPECT_NE(checkedHeight(less.getRoot(), 1), -100);
+    EXPECT_NE(checkedHeight(greater.getRoot(), 1), -100);
+    EXPECT_EQ(less.getMax(), 399);
+    EXPECT_EQ(greater.getMin(), 401);
+    EXPECT_FALSE(greater.hasValue(400));
+
+    tree.join(less, 400, greater);
+    EXPECT_TRUE(less.isEmpty());
+    EXPECT_TRUE(greater.isEmpty());
+    EXPECT_NE(checkedHeight(tree.getRoot(), 1), -100);
+    EXPECT_EQ(valuesOf(tree).size(), 1000u);
+
+    // Lopsided join, and splitting into the tree itself
+    for (int i = 2000; i < 2003; ++i)
+        greater.insert(i);
+    tree.join(tree, 1500, greater);
+    EXPECT_NE(checkedHeight(tree.getRoot(), 1), -100);
+    EXPECT_EQ(tree.getMax(), 2002);
+    EXPECT_FALSE(tree.split(1700, tree, greater));
+    EXPECT_EQ(tree.getMax(), 1500);
+    EXPECT_EQ(greater.getMin(), 2000);
+
+    EXPECT_THROW(tree.join(less, 3000, greater), std::invalid_argument);
+    EXPECT_THROW(tree.split(1, less, less), std::invalid_argument);
+}
+
+TEST(AVLTreeSetOps, PoolTrees)
+{
+    AVLTree<int, PoolNodeAllocator<int>> a, b, less, greater;
+    for (int i = 0; i < 500; ++i)
+        a.insert(i * 2);
+    for (int i = 0; i < 500; ++i)
+        b.insert(i * 3);
+
+    AVLTree<int, PoolNodeAllocator<int>> i = a.intersect(b);
+    EXPECT_TRUE(i.hasValue(6));
+    EXPECT_FALSE(i.hasValue(4));
+
+    a.split(500, less, greater);
+    EXPECT_TRUE(a.isEmpty());
+    a.insert(-1);
+    EXPECT_EQ(less.getMax(), 498);
+    EXPECT_EQ(greater.getMin(), 502);
+    a.join(less, 500, greater);
+    EXPECT_TRUE(a.hasValue(500));
+    EXPECT_FALSE(a.hasValue(-1));
+    EXPECT_EQ(a.getMax(), 998);
+}
+
+TEST(AVLTreeSetOps, ParallelMatchesSequential)
+{
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> dist(0, 400000);
+    std::vector<int> a(100000), b(100000);
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        a[i] = dist(rng);
+        b[i] = dist(rng);
+    }
+    AVLTree<int> ta(a.begin(), a.end());
+    AVLTree<int> tb(b.begin(), b.end());
+
+    for (unsigned threads : {2u, 3u, 8u})
+    {
+        AVLTree<int> u = ta.unionWith(tb, threads);
+        EXPECT_NE(checkedHeight(u.getRoot(), 1), -100);
+        EXPECT_EQ(valuesOf(u), valuesOf(ta.unionWith(tb)));
+        AVLTree<int> i = ta.intersect(tb, threads);
+        EXPECT_NE(checkedHeight(i.getRoot(), 1), -100);
+        EXPECT_EQ(valuesOf(i), valuesOf(ta.intersect(tb)));
+        AVLTree<int> d = ta.difference(tb, threads);
+        EXPECT_NE(checkedHeight(d.getRoot(), 1), -100);
+        EXPECT_EQ(valuesOf(d), valuesOf(ta.difference(tb)));
+
+        AVLTree<int> merged(ta);
+        merged.merge(tb, threads);
+        EXPECT_EQ(valuesOf(merged), valuesOf(u));
+    }
+
+    AVLTree<int, PoolNodeAllocator<int>> pa(a.begin(), a.end());
+    AVLTree<int, PoolNodeAllocator<int>> pb(b.begin(), b.end());
+    pa.merge(pb, 4);
+    std::vector<int> pooled;
+    for (auto it = pa.cbegin(); it != pa.cend(); ++it)
+        pooled.push_back(*it);
+    EXPECT_EQ(pooled, valuesOf(ta.unionWith(tb)));
+}
+
+// Order statistics
+static size_t checkedSize(const TreeNode<int> *node)
+{
+    if (!node)
+        return 0;
+    size_t size = 1 + checkedSize(node->getLeft()) + checkedSize(node->getRight());
+    EXPECT_EQ(node->getSize(), size);
+    return size;
+}
+
+TEST(AVLTreeOrderStatistics, SelectRankCountRange)
+{
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<int> dist(0, 20000);
+    AVLTree<int> tree;
+    std::set<int> reference;
+    for (int i = 0; i < 5000; ++i)
+    {
+        int x = dist(rng);
+        tree.insert(x);
+        reference.insert(x);
+    }
+    for (int i = 0; i < 2000; ++i)
+    {
+        int x = dist(rng);
+        tree.remove(x);
+        reference.erase(x);
+    }
+    checkedSize(tree.getRoot());
+    ASSERT_EQ(tree.size(), reference.size());
+
+    std::vector<int> sorted(reference.begin(), reference.end());
+    for (size_t k = 0; k < sorted.size(); k += 7)
+    {
+        EXPECT_EQ(tree.select(k), sorted[k]);
+        EXPECT_EQ(tree.rank(sorted[k]), k);
+    }
+    EXPECT_THROW(tree.select(sorted.size()), std::out_of_range);
+
+    for (int i = 0; i < 200; ++i)
+    {
+        int lo = dist(rng), hi = dist(rng);
+        size_t expected = lo > hi ? 0 : std::distance(reference.lower_bound(lo), reference.upper_bound(hi));
+        EXPECT_EQ(tree.countRange(lo, hi), expected);
+    }
+}
+
+TEST(AVLTreeOrderStatistics, SizesSurviveBulkOperations)
+{
+    std::vector<int> a, b;
+    for (int i = 0; i < 3000; ++i)
+    {
+        a.push_back(i * 2);
+        b.push_back(i * 3);
+    }
+    AVLTree<int> ta(a.begin(), a.end());
+    AVLTree<int> tb(b.begin(), b.end());
+    checkedSize(ta.getRoot());
+
+    AVLTree<int> u = ta.unionWith(tb);
+    checkedSize(u.getRoot());
+    EXPECT_EQ(u.size(), 3000u + 3000u - 1000u);
+    EXPECT_EQ(u.select(u.size() - 1), 8997);
+    EXPECT_EQ(u.rank(7), 5u);
+
+    ta.merge(tb);
+    checkedSize(ta.getRoot());
+    EXPECT_EQ(ta.size(), u.size());
+
+    AVLTree<int> less, greater;
+    u.split(3000, less, greater);
+    checkedSize(less.getRoot());
+    checkedSize(greater.getRoot());
+    EXPECT_EQ(less.size(), less.rank(3000));
+}
+
+// Range queries
+TEST(AVLTreeRange, BoundsMatchStdSet)
+{
+    AVLTree<int> tree;
+    std::set<int> reference;
+    for (int i = 0; i < 2000; i += 3)
+    {
+        tree.insert(i);
+        reference.insert(i);
+    }
+
+    for (int x = -5; x < 2010; x += 7)
+    {
+        auto lower = tree.lowerBound(x);
+        auto upper = tree.upperBound(x);
+        if (reference.lower_bound(x) == reference.end())
+            EXPECT_TRUE(lower == tree.cend());
+        else
+            EXPECT_EQ(*lower, *reference.lower_bound(x));
+        if (reference.upper_bound(x) == reference.end())
+            EXPECT_TRUE(upper == tree.cend());
+        else
+            EXPECT_EQ(*upper, *reference.upper_bound(x));
+    }
+
+    // Bounds are ordinary iterators: walking on from one reaches the end
+    std::vector<int> tail;
+    for (auto it = tree.lowerBound(1990); it != tree.cend(); ++it)
+        tail.push_back(*it);
+    EXPECT_EQ(tail, std::vector<int>({1992, 1995, 1998}));
+}
+
+TEST(AVLTreeRange, ForEachInRange)
+{
+    AVLTree<int> tree;
+    for (int i = 0; i < 1000; ++i)
+        tree.insert(i * 2);
+
+    std::vector<int> visited;
+    tree.forEachInRange(101, 111, [&](const int &x)
+                        { visited.push_back(x); });
+    EXPECT_EQ(visited, std::vector<int>({102, 104, 106, 108, 110}));
+
+    visited.clear();
+    tree.forEachInRange(50, 40, [&](const int &x)
+                        { visited.push_back(x); });
+    EXPECT_TRUE(visited.empty());
+    tree.forEachInRange(1990, 5000, [&](const int &x)
+                        { visited.push_back(x); });
+    EXPECT_EQ(visited, std::vector<int>({1990, 1992, 1994, 1996, 1998}));
+}
+
+TEST(AVLTreeRange, EqualRangeOfEquivalentKey)
+{
+    AVLTree<Person> tree;
+    tree.insert(Person("Alice", 25));
+    tree.insert(Person("Bob", 30));
+    tree.insert(Person("Charlie", 20));
+
+    auto range = tree.equalRange(Person("Someone", 30));
+    ASSERT_TRUE(range.first != range.second);
+    EXPECT_EQ((*range.first).getName(), "Bob");
+    EXPECT_TRUE(++range.first == range.second);
+
+    range = tree.equalRange(Person("Nobody", 27));
+    EXPECT_TRUE(range.first == range.second);
+}
+
+TEST(AVLTreeBatch, SearchBatchMatchesSearch)
+{
+    AVLTree<int> tree;
+    std::vector<int> probes;
+    for (int i = 0; i < 3000; ++i)
+        tree.insert(i * 2);
+    for (int i = -5; i < 6100; i += 3)
+        probes.push_back(i);
+
+    std::vector<const TreeNode<int> *> nodes = tree.searchBatch(probes);
+    std::vector<bool> found = tree.hasValues(probes);
+    ASSERT_EQ(nodes.size(), probes.size());
+    ASSERT_EQ(found.size(), probes.size());
+    for (size_t i = 0; i < probes.size(); ++i)
+    {
+        EXPECT_EQ(nodes[i], tree.search(probes[i]));
+        EXPECT_EQ(found[i], probes[i] >= 0 && probes[i] < 6000 && probes[i] % 2 == 0);
+    }
+
+    EXPECT_TRUE(tree.hasValues({}).empty());
+    EXPECT_EQ(AVLTree<int>().hasValues({1, 2}), std::vector<bool>({false, false}));
+}
+
+// Batched insert
+TEST(AVLTreeBatch, InsertBatchMatchesStdSet)
+{
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> dist(0, 20000);
+    AVLTree<int> tree;
+    std::set<int> reference;
+    // Batches both large and small relative to the tree, so both paths are taken
+    for (size_t batchSize : {5000u, 3u, 2000u, 10u, 1u, 0u})
+    {
+        std::vector<int> batch;
+        for (size_t i = 0; i < batchSize; ++i)
+            batch.push_back(dist(rng));
+        size_t before = reference.size();
+        reference.insert(batch.begin(), batch.end());
+        EXPECT_EQ(tree.insertBatch(batch.begin(), batch.end()), reference.size() - before);
+        EXPECT_NE(checkedHeight(tree.getRoot(), 1), -100);
+        EXPECT_EQ(checkedSize(tree.getRoot()), reference.size());
+        EXPECT_EQ(valuesOf(tree), std::vector<int>(reference.begin(), reference.end()));
+    }
+}
+
+TEST(AVLTreeBatch, InsertBatchKeepsExistingEquivalent)
+{
+    AVLTree<Person> tree;
+    tree.insert(Person("Bob", 30));
+    std::vector<Person> batch = {Person("Carol", 30), Person("Alice", 25), Person("Dave", 25)};
+    EXPECT_EQ(tree.insertBatch(batch.begin(), batch.end()), 1u);
+    EXPECT_TRUE(tree.hasValue(Person("Bob", 30)));
+    EXPECT_TRUE(tree.hasValue(Person("Alice", 25)));
+    EXPECT_FALSE(tree.hasValue(Person("Carol", 30)));
+    EXPECT_FALSE(tree.hasValue(Person("Dave", 25)));
+}
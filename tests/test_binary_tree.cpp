@@ -2,6 +2,7 @@
 #include "../inc/binaryTree.hpp"
 #include "../types/complex.hpp"
 #include "../types/person.hpp"
+#include "testUtils.hpp"
 #include <string>
 #include <sstream>
 #include <set>
@@ -9,6 +10,7 @@
 #include <random>
 #include <chrono>
 #include <vector>
+#include <type_traits>
 
 TEST(BinaryTreeInt, InsertAndHasValue)
 {
@@ -135,6 +137,31 @@ TEST(BinaryTreeInt, MergeAndOperatorPlus)
         EXPECT_TRUE(t3.hasValue(i));
 }
 
+TEST(BinaryTreeInt, MergeKeepsDuplicatesAndOrder)
+{
+    BinaryTree<int> ordered, other, levelOrder;
+    for (int i = 0; i < 10; ++i)
+        ordered.insert(i);
+    for (int i = 5; i < 15; ++i)
+        other.insert(i);
+    levelOrder.insert(100);
+    levelOrder.insert(50, levelOrder.getRoot());
+
+    BinaryTree<int> sum = ordered + other;
+    std::vector<int> values;
+    for (auto it = sum.cbegin(); it != sum.cend(); ++it)
+        values.push_back(*it);
+    std::vector<int> expected = {0, 1, 2, 3, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 11, 12, 13, 14};
+    EXPECT_EQ(values, expected);
+    EXPECT_TRUE(sum.isBalanced());
+
+    // An unordered tree is merged value by value
+    ordered.merge(levelOrder);
+    EXPECT_TRUE(ordered.hasValue(50));
+    EXPECT_TRUE(ordered.hasValue(100));
+    EXPECT_EQ(ordered.getMax(), 100);
+}
+
 TEST(BinaryTreeInt, WhereApplyReduce)
 {
     BinaryTree<int> tree;
@@ -292,6 +319,182 @@ TEST(BinaryTreePerson, MinMax)
     EXPECT_EQ(tree.getMax().getAge(), 35);
 }
 
+TEST(BinaryTreePerson, SearchEquivalentKeys)
+{
+    BinaryTree<Person> tree;
+    tree.insert(Person("Alice", 25));
+    tree.insert(Person("Bob", 25));
+    tree.insert(Person("Charlie", 25));
+    tree.insert(Person("Dave", 20));
+
+    EXPECT_TRUE(tree.hasValue(Person("Bob", 25)));
+    EXPECT_TRUE(tree.hasValue(Person("Charlie", 25)));
+    EXPECT_FALSE(tree.hasValue(Person("Eve", 25)));
+
+    // balance() may place equivalent keys on both sides of a node
+    tree.balance();
+    EXPECT_TRUE(tree.hasValue(Person("Alice", 25)));
+    EXPECT_TRUE(tree.hasValue(Person("Bob", 25)));
+    EXPECT_TRUE(tree.hasValue(Person("Charlie", 25)));
+}
+
+TEST(BinaryTreeInt, SearchUnorderedTree)
+{
+    BinaryTree<int> tree;
+    tree.insert(1);
+    for (int i = 10; i > 1; --i)
+        tree.insert(i, tree.getRoot());
+    for (int i = 1; i <= 10; ++i)
+        EXPECT_TRUE(tree.hasValue(i));
+    EXPECT_FALSE(tree.hasValue(11));
+    EXPECT_EQ(tree.getMin(), 1);
+    EXPECT_EQ(tree.getMax(), 10);
+
+    // Removal swaps in the last node of the level order, wherever the target is
+    for (int i : {1, 5, 10, 2})
+    {
+        tree.remove(i);
+        EXPECT_FALSE(tree.hasValue(i));
+    }
+    for (int i : {3, 4, 6, 7, 8, 9})
+        EXPECT_TRUE(tree.hasValue(i));
+    EXPECT_THROW(tree.remove(42), std::runtime_error);
+    for (int i : {3, 4, 6, 7, 8, 9})
+        tree.remove(i);
+    EXPECT_TRUE(tree.isEmpty());
+}
+
+TEST(BinaryTreeInt, RemoveKeepsOrder)
+{
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<int> dist(0, 300);
+    BinaryTree<int> tree;
+    std::multiset<int> reference;
+    for (int i = 0; i < 1000; ++i)
+    {
+        int x = dist(rng);
+        tree.insert(x);
+        reference.insert(x);
+    }
+    for (int i = 0; i < 700; ++i)
+    {
+        int x = dist(rng);
+        if (reference.count(x))
+        {
+            tree.remove(x);
+            reference.erase(reference.find(x));
+        }
+    }
+
+    // Still ordered: range queries work and the inorder walk is sorted
+    std::vector<int> inorder;
+    tree.forEachInRange(0, 300, [&](const int &x)
+                        { inorder.push_back(x); });
+    EXPECT_EQ(inorder, std::vector<int>(reference.begin(), reference.end()));
+}
+
+TEST(BinaryTreePerson, RemoveExactAmongEquivalent)
+{
+    BinaryTree<Person> tree;
+    tree.insert(Person("Bob", 30));
+    tree.insert(Person("Alice", 25));
+    tree.insert(Person("Carol", 30));
+    tree.insert(Person("Dave", 30));
+    tree.insert(Person("Eve", 35));
+    tree.balance();
+
+    tree.remove(Person("Carol", 30));
+    EXPECT_FALSE(tree.hasValue(Person("Carol", 30)));
+    EXPECT_TRUE(tree.hasValue(Person("Bob", 30)));
+    EXPECT_TRUE(tree.hasValue(Person("Dave", 30)));
+    tree.remove(Person("Bob", 30));
+    EXPECT_TRUE(tree.hasValue(Person("Dave", 30)));
+    EXPECT_EQ(tree.getMin(), Person("Alice", 25));
+}
+
+TEST(BinaryTreeInt, RemoveFromThreadedTree)
+{
+    BinaryTree<int> tree;
+    for (int x : {4, 2, 6, 1, 3, 5, 7})
+        tree.insert(x);
+    tree.makeThreaded();
+    tree.remove(4);
+    tree.remove(1);
+    std::vector<int> inorder;
+    for (auto it = tree.cbegin(); it != tree.cend(); ++it)
+        inorder.push_back(*it);
+    EXPECT_EQ(inorder, std::vector<int>({2, 3, 5, 6, 7}));
+}
+
+TEST(BinaryTreePool, BasicOperations)
+{
+    BinaryTree<Person, PoolNodeAllocator<Person>> tree;
+    tree.insert(Person("Alice", 25));
+    tree.insert(Person("Bob", 30));
+    tree.insert(Person("Charlie", 35));
+
+    EXPECT_TRUE(tree.hasValue(Person("Bob", 30)));
+    tree.remove(Person("Bob", 30));
+    EXPECT_FALSE(tree.hasValue(Person("Bob", 30)));
+
+    BinaryTree<Person, PoolNodeAllocator<Person>> *sub = tree.subtree(Person("Alice", 25));
+    EXPECT_TRUE(sub->hasValue(Person("Alice", 25)));
+    delete sub;
+
+    auto older = tree.where([](Person p)
+                            { return p.getAge() > 30; });
+    EXPECT_TRUE(older.hasValue(Person("Charlie", 35)));
+    EXPECT_FALSE(older.hasValue(Person("Alice", 25)));
+}
+
+TEST(BinaryTreeMove, ConstructAndAssignTakeTheNodes)
+{
+    BinaryTree<int> tree;
+    for (int i = 0; i < 50; ++i)
+        tree.insert(i);
+    const TreeNode<int> *root = tree.getRoot();
+
+    BinaryTree<int> moved(std::move(tree));
+    EXPECT_EQ(moved.getRoot(), root);
+    EXPECT_TRUE(tree.isEmpty());
+    for (int i = 0; i < 50; ++i)
+        EXPECT_TRUE(moved.hasValue(i));
+
+    // The moved-from tree is empty but usable
+    tree.insert(7);
+    EXPECT_TRUE(tree.hasValue(7));
+
+    BinaryTree<int> target;
+    target.insert(100);
+    target = std::move(moved);
+    EXPECT_EQ(target.getRoot(), root);
+    EXPECT_TRUE(moved.isEmpty());
+    EXPECT_FALSE(target.hasValue(100));
+    target = std::move(target);
+    EXPECT_TRUE(target.hasValue(49));
+}
+
+TEST(BinaryTreeMove, PoolMovesWithTheNodes)
+{
+    BinaryTree<Person, PoolNodeAllocator<Person>> tree;
+    tree.insert(Person("Alice", 25));
+    tree.insert(Person("Bob", 30));
+
+    BinaryTree<Person, PoolNodeAllocator<Person>> moved(std::move(tree));
+    tree.insert(Person("Charlie", 35));
+    EXPECT_TRUE(moved.hasValue(Person("Alice", 25)));
+    EXPECT_FALSE(moved.hasValue(Person("Charlie", 35)));
+
+    // where builds its result locally; returning and assigning it must not copy
+    BinaryTree<Person, PoolNodeAllocator<Person>> older;
+    older = moved.where([](Person p)
+                        { return p.getAge() >= 30; });
+    moved.clear();
+    EXPECT_TRUE(older.hasValue(Person("Bob", 30)));
+    EXPECT_FALSE(older.hasValue(Person("Alice", 25)));
+    EXPECT_TRUE(tree.hasValue(Person("Charlie", 35)));
+}
+
 // Edge cases
 TEST(BinaryTreeEdgeCases, EmptyTree)
 {
@@ -393,3 +596,233 @@ TEST(BinaryTreeIterators, DifferentTraversalOrders)
     EXPECT_EQ(inorder, preorder);
     EXPECT_EQ(preorder, postorder);
 }
+
+static void collectOrder(const TreeNode<int> *node, const std::string &order, std::vector<int> &out)
+{
+    if (!node)
+        return;
+    if (order == "preorder")
+        out.push_back(node->getData());
+    collectOrder(node->getLeft(), order, out);
+    if (order == "inorder")
+        out.push_back(node->getData());
+    collectOrder(node->getRight(), order, out);
+    if (order == "postorder")
+        out.push_back(node->getData());
+}
+
+TEST(BinaryTreeIterators, ForwardAndBackwardMatchRecursiveOrder)
+{
+    BinaryTree<int> tree;
+    std::mt19937 rng(7);
+    for (int i = 0; i < 200; ++i)
+        tree.insert(static_cast<int>(rng() % 1000));
+
+    for (std::string order : {"inorder", "preorder", "postorder"})
+    {
+        std::vector<int> expected;
+        collectOrder(tree.getRoot(), order, expected);
+
+        std::vector<int> forward;
+        for (auto it = tree.cbegin(order); it != tree.cend(order); ++it)
+            forward.push_back(*it);
+        EXPECT_EQ(forward, expected) << order;
+
+        std::vector<int> backward;
+        auto it = tree.end(order);
+        while (it != tree.begin(order))
+        {
+            --it;
+            backward.push_back(*it);
+        }
+        std::reverse(backward.begin(), backward.end());
+        EXPECT_EQ(backward, expected) << order;
+    }
+}
+
+TEST(BinaryTreeIterators, NodePointerTypes)
+{
+    static_assert(std::is_same<BinaryTree<int>::Iterator::NodePtr, TreeNode<int> *>::value, "");
+    static_assert(std::is_same<BinaryTree<int>::ConstIterator::ConstNodePtr, const TreeNode<int> *>::value, "");
+    static_assert(std::is_same<BinaryTree<int>::ConstIterator::NodePtr, const TreeNode<int> *>::value, "");
+    SUCCEED();
+}
+
+TEST(BinaryTreeIterators, DecrementAtBeginStays)
+{
+    BinaryTree<int> tree;
+    tree.insert(2);
+    tree.insert(1);
+    tree.insert(3);
+
+    auto it = tree.begin();
+    --it;
+    EXPECT_EQ(*it, 1);
+    ++it;
+    ++it;
+    ++it;
+    EXPECT_EQ(it, tree.end());
+    EXPECT_THROW(*it, std::out_of_range);
+    it--;
+    EXPECT_EQ(*it, 3);
+}
+
+TEST(BinaryTreeIterators, DegenerateTreeDoesNotRecurse)
+{
+    BinaryTree<int> tree;
+    const int N = 200000;
+    tree.insert(0);
+    TreeNode<int> *tail = tree.getRoot();
+    for (int i = 1; i < N; ++i)
+    {
+        tail->setRight(new TreeNode<int>(i));
+        tail = tail->getRight();
+    }
+
+    int visited = tree.reduce([](int acc, int)
+                              { return acc + 1; }, 0);
+    EXPECT_EQ(visited, N);
+    int count = 0;
+    for (auto it = tree.cbegin("postorder"); it != tree.cend("postorder"); ++it)
+        ++count;
+    EXPECT_EQ(count, N);
+}
+
+TEST(BinaryTreeInt, RangeQueriesWithDuplicates)
+{
+    BinaryTree<int> tree;
+    for (int x : {5, 3, 8, 5, 1, 5, 9})
+        tree.insert(x);
+
+    auto range = tree.equalRange(5);
+    int count = 0;
+    for (auto it = range.first; it != range.second; ++it, ++count)
+        EXPECT_EQ(*it, 5);
+    EXPECT_EQ(count, 3);
+
+    std::vector<int> visited;
+    tree.forEachInRange(2, 8, [&](const int &x)
+                        { visited.push_back(x); });
+    EXPECT_EQ(visited, std::vector<int>({3, 5, 5, 5, 8}));
+
+    BinaryTree<int> unordered;
+    unordered.insert(1, unordered.getRoot());
+    unordered.insert(2, unordered.getRoot());
+    EXPECT_THROW(unordered.lowerBound(1), std::logic_error);
+}
+
+TEST(BinaryTreePerson, SearchBatchWithEquivalentKeys)
+{
+    BinaryTree<Person> ordered;
+    for (const Person &p : {Person("Bob", 30), Person("Alice", 25), Person("Carol", 30), Person("Dave", 40)})
+        ordered.insert(p);
+    ordered.balance();
+    std::vector<Person> probes = {Person("Carol", 30), Person("Bob", 30), Person("Eve", 30), Person("Dave", 40)};
+    EXPECT_EQ(ordered.hasValues(probes), std::vector<bool>({true, true, false, true}));
+
+    BinaryTree<int> unordered;
+    unordered.insert(5);
+    for (int x : {9, 1, 7})
+        unordered.insert(x, unordered.getRoot());
+    std::vector<const TreeNode<int> *> nodes = unordered.searchBatch({7, 2, 5});
+    EXPECT_EQ(nodes[0], unordered.search(7));
+    EXPECT_EQ(nodes[1], nullptr);
+    EXPECT_EQ(nodes[2], unordered.getRoot());
+}
+
+// Parallel functional operations
+TEST(BinaryTreeParallel, MatchesSequentialResults)
+{
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<int> dist(-5000, 5000);
+    BinaryTree<int> ordered;
+    BinaryTree<int> unordered;
+    for (int i = 0; i < 20000; ++i)
+    {
+        int x = dist(rng);
+        ordered.insert(x);
+        unordered.insert(x, unordered.getRoot());
+    }
+    std::vector<int> values = valuesOf(ordered);
+
+    std::vector<int> squares;
+    std::vector<int> odd;
+    for (int x : values)
+    {
+        squares.push_back(x * x % 1000);
+        if (x % 2 != 0)
+            odd.push_back(x);
+    }
+    std::sort(squares.begin(), squares.end());
+    long long sum = 0;
+    for (int x : values)
+        sum += x;
+
+    for (const BinaryTree<int> *tree : {&ordered, &unordered})
+    {
+        for (unsigned threads : {1u, 2u, 3u, 8u})
+        {
+            BinaryTree<int> mapped = tree->apply([](int x)
+                                                 { return x * x % 1000; }, threads);
+            EXPECT_EQ(valuesOf(mapped), squares);
+            EXPECT_TRUE(mapped.isBalanced());
+            BinaryTree<int> filtered = tree->where([](int x)
+                                                   { return x % 2 != 0; }, threads);
+            EXPECT_EQ(valuesOf(filtered), odd);
+            EXPECT_TRUE(filtered.isBalanced());
+            EXPECT_EQ(tree->reduce([](int a, int b)
+                                   { return a + b; }, 7, threads),
+                      sum + 7);
+        }
+    }
+}
+
+TEST(BinaryTreeParallel, ReduceKeepsOrderForNonCommutativeOperator)
+{
+    // Concatenation is associative but not commutative
+    BinaryTree<std::string> tree;
+    std::string expected = ">";
+    for (char c = 'a'; c <= 'z'; ++c)
+        expected += c;
+    std::vector<int> order(26);
+    for (int i = 0; i < 26; ++i)
+        order[i] = i;
+    std::shuffle(order.begin(), order.end(), std::mt19937(9));
+    for (int i : order)
+        tree.insert(std::string(1, static_cast<char>('a' + i)));
+
+    for (unsigned threads : {1u, 2u, 4u, 16u})
+        EXPECT_EQ(tree.reduce([](std::string a, std::string b)
+                              { return a + b; }, ">", threads),
+                  expected);
+}
+
+TEST(BinaryTreeParallel, DegenerateTreeAndErrors)
+{
+    // Sorted inserts give a chain; where used to rebuild it by inserting in order
+    BinaryTree<int> chain;
+    for (int i = 0; i < 3000; ++i)
+        chain.insert(i);
+    BinaryTree<int> kept = chain.where([](int x)
+                                       { return x % 3 == 0; }, 4);
+    EXPECT_EQ(kept.getRoot()->getData(), 1497);
+    EXPECT_LE(kept.getHeight(), 10);
+    EXPECT_EQ(chain.reduce([](int a, int b)
+                           { return a + b; }, 0, 4),
+              3000 * 2999 / 2);
+
+    EXPECT_THROW(chain.apply([](int x) -> int
+                             {
+                                 if (x == 2000)
+                                     throw std::runtime_error("bad value");
+                                 return x; }, 4),
+                 std::runtime_error);
+
+    BinaryTree<int> empty;
+    EXPECT_TRUE(empty.where([](int)
+                            { return true; }, 4)
+                    .isEmpty());
+    EXPECT_EQ(empty.reduce([](int a, int b)
+                           { return a + b; }, 3, 4),
+              3);
+}
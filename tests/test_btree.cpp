@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+#include "../inc/BTree.hpp"
+#include "../inc/AVLTree.hpp"
+#include "../types/complex.hpp"
+#include "testUtils.hpp"
+#include <vector>
+#include <set>
+#include <random>
+#include <sstream>
+
+// Random inserts and removes checked against std::set after every step that changes
+// the size, with full comparisons now and then
+template <typename Tree>
+static void checkAgainstSet(unsigned seed, int range, int rounds)
+{
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> dist(0, range);
+    Tree tree;
+    std::set<int> reference;
+
+    for (int round = 0; round < rounds; ++round)
+    {
+        int x = dist(rng);
+        if (rng() % 3 == 0)
+        {
+            tree.remove(x);
+            reference.erase(x);
+        }
+        else
+        {
+            tree.insert(x);
+            reference.insert(x);
+        }
+        ASSERT_EQ(tree.size(), reference.size());
+        if (round % 500 == 0)
+        {
+            ASSERT_EQ(valuesOf(tree), std::vector<int>(reference.begin(), reference.end()));
+        }
+    }
+
+    EXPECT_EQ(valuesOf(tree), std::vector<int>(reference.begin(), reference.end()));
+    EXPECT_EQ(tree.getMin(), *reference.begin());
+    EXPECT_EQ(tree.getMax(), *reference.rbegin());
+    for (int x = -1; x <= range + 1; ++x)
+        EXPECT_EQ(tree.hasValue(x), reference.count(x) == 1);
+
+    for (int x : std::vector<int>(reference.begin(), reference.end()))
+        tree.remove(x);
+    EXPECT_TRUE(tree.isEmpty());
+    EXPECT_EQ(tree.size(), 0u);
+    EXPECT_TRUE(tree.cbegin() == tree.cend());
+}
+
+TEST(BTree, EmptyTree)
+{
+    BTree<int> tree;
+    EXPECT_TRUE(tree.isEmpty());
+    EXPECT_EQ(tree.size(), 0u);
+    EXPECT_FALSE(tree.hasValue(1));
+    EXPECT_TRUE(tree.cbegin() == tree.cend());
+    EXPECT_THROW(tree.getMin(), std::runtime_error);
+    EXPECT_THROW(tree.getMax(), std::runtime_error);
+    EXPECT_THROW(tree.getHeight(), std::runtime_error);
+    EXPECT_THROW(*tree.cbegin(), std::out_of_range);
+    tree.remove(1);
+    EXPECT_TRUE(tree.isEmpty());
+}
+
+TEST(BTree, MatchesStdSet)
+{
+    checkAgainstSet<BTree<int>>(11, 3000, 20000);
+}
+
+TEST(BTree, SmallNodesSplitAndMergeDeep)
+{
+    // 16-byte nodes hold 4 keys, so a few thousand keys need many levels and every
+    // borrow and merge case runs often
+    static_assert(BTree<int, 16>::leafCapacity == 4 && BTree<int, 16>::innerCapacity == 4,
+                  "minimum node size");
+    checkAgainstSet<BTree<int, 16>>(5, 2000, 20000);
+    checkAgainstSet<BTree<int, 64>>(7, 5000, 20000);
+}
+
+TEST(BTree, HeightStaysLogarithmic)
+{
+    BTree<int, 16> small;
+    BTree<int> wide;
+    AVLTree<int> avl;
+    for (int i = 0; i < 100000; ++i)
+    {
+        small.insert(i);
+        wide.insert(i);
+        avl.insert(i);
+    }
+    // Every node but the root is at least half full, so a node of 4 keys branches at
+    // least 3 ways
+    EXPECT_LE(small.getHeight(), 11);
+    EXPECT_LE(wide.getHeight(), 4);
+    EXPECT_LT(wide.getHeight(), avl.getRoot()->getHeight());
+    EXPECT_EQ(valuesOf(wide), valuesOf(avl));
+}
+
+TEST(BTree, CopyIsIndependent)
+{
+    BTree<int, 16> tree;
+    for (int x : {5, 3, 9, 3, 1, 7, 5, 11, 2, 8})
+        tree.insert(x);
+    EXPECT_EQ(valuesOf(tree), std::vector<int>({1, 2, 3, 5, 7, 8, 9, 11}));
+
+    BTree<int, 16> copy = tree;
+    copy.remove(5);
+    copy.insert(4);
+    EXPECT_TRUE(tree.hasValue(5));
+    EXPECT_FALSE(tree.hasValue(4));
+    EXPECT_EQ(valuesOf(copy), std::vector<int>({1, 2, 3, 4, 7, 8, 9, 11}));
+
+    tree = copy;
+    copy.clear();
+    EXPECT_EQ(valuesOf(tree), std::vector<int>({1, 2, 3, 4, 7, 8, 9, 11}));
+
+    std::ostringstream os;
+    tree.inorderTraversal(os);
+    EXPECT_EQ(os.str(), "1 2 3 4 7 8 9 11 ");
+}
+
+TEST(BTree, Serialize)
+{
+    BTree<int, 16> tree;
+    for (int x = 1; x <= 5; ++x)
+        tree.insert(x);
+    EXPECT_EQ(tree.getHeight(), 1);
+    EXPECT_EQ(tree.serialize(),
+              "{\n"
+              "  \"type\": \"b_tree\",\n"
+              "  \"traversal\": \"inorder\",\n"
+              "  \"values\": [\"1\", \"2\", \"3\", \"4\", \"5\"],\n"
+              "  \"levels\": [[[\"3\"]], [[\"1\", \"2\"], [\"3\", \"4\", \"5\"]]],\n"
+              "  \"size\": 5\n"
+              "}");
+
+    BTree<int> empty;
+    EXPECT_NE(empty.serialize().find("\"levels\": []"), std::string::npos);
+}
+
+TEST(BTree, EquivalentComplexKeys)
+{
+    // Complex orders by magnitude, so 3+4i and 5 are equivalent but not equal
+    BTree<Complex> tree;
+    tree.insert(Complex(3, 4));
+    tree.insert(Complex(5, 0));
+    tree.insert(Complex(1, 0));
+    EXPECT_EQ(tree.size(), 2u);
+    EXPECT_TRUE(tree.hasValue(Complex(3, 4)));
+    EXPECT_FALSE(tree.hasValue(Complex(5, 0)));
+    EXPECT_EQ(tree.search(Complex(5, 0)), nullptr);
+    tree.remove(Complex(0, 5));
+    EXPECT_EQ(tree.size(), 1u);
+    EXPECT_TRUE(tree.hasValue(Complex(1, 0)));
+}
@@ -0,0 +1,50 @@
+#include "../inc/AVLTree.hpp"
+#include "../inc/BTree.hpp"
+#include "benchmarkUtils.hpp"
+#include <fstream>
+#include <vector>
+#include <random>
+#include <iostream>
+#include <iomanip>
+
+// AVLTree against the cache-line B+-tree on random int keys
+static void btree_performance_test(const std::string &filename, size_t max_size, size_t step, size_t queries)
+{
+    std::ofstream ofs;
+    if (!open_results_file(ofs, filename))
+        return;
+
+    ofs << "size,avltree_insert,btree_insert,avltree_search,btree_search,avltree_iterate,btree_iterate,"
+           "avltree_copy,btree_copy,avltree_remove,btree_remove\n";
+    std::mt19937 rng(42);
+
+    for (size_t n = step; n <= max_size; n += step)
+    {
+        std::vector<int> data, probes;
+        random_workload(rng, n, queries, data, probes);
+
+        BackendTimes avl = measure_backend<AVLTree<int>>(data, probes);
+        BackendTimes btree = measure_backend<BTree<int>>(data, probes);
+
+        ofs << n << "," << std::fixed << std::setprecision(6)
+            << avl.insert << "," << btree.insert << ","
+            << avl.search << "," << btree.search << ","
+            << avl.iterate << "," << btree.iterate << ","
+            << avl.copy << "," << btree.copy << ","
+            << avl.remove << "," << btree.remove << "\n";
+        std::cout << "Size: " << n
+                  << ", insert: " << avl.insert << "s / " << btree.insert << "s"
+                  << ", search: " << avl.search << "s / " << btree.search << "s"
+                  << ", iterate: " << avl.iterate << "s / " << btree.iterate << "s"
+                  << ", copy: " << avl.copy << "s / " << btree.copy << "s"
+                  << ", remove: " << avl.remove << "s / " << btree.remove << "s" << std::endl;
+    }
+    ofs.close();
+    std::cout << "Data successfully written to: tests/" << filename << std::endl;
+}
+
+int main()
+{
+    btree_performance_test("btree_performance.csv", 10000000, 2000000, 2000000);
+    return 0;
+}
@@ -0,0 +1,261 @@
+#include "../inc/AVLTree.hpp"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <vector>
+#include <random>
+#include <iostream>
+#include <iomanip>
+
+// Builds an AVL tree from n keys once with repeated insert and once with bulkLoad
+static void bulk_load_performance_test(const std::string &filename, size_t max_size, size_t step)
+{
+    std::ofstream ofs("../tests/" + filename);
+    if (!ofs.is_open())
+    {
+        std::cerr << "Failed to open file: tests/" << filename << std::endl;
+        return;
+    }
+    std::cout << "File opened successfully: tests/" << filename << std::endl;
+
+    ofs << "size,avltree_insert,avltree_bulk_load_sorted,avltree_bulk_load_unsorted\n";
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> dist(1, 1e9);
+
+    for (size_t n = step; n <= max_size; n += step)
+    {
+        std::vector<int> data(n);
+        for (size_t i = 0; i < n; ++i)
+            data[i] = dist(rng);
+        std::vector<int> sorted = data;
+        std::sort(sorted.begin(), sorted.end());
+
+        AVLTree<int> inserted;
+        auto t1 = std::chrono::high_resolution_clock::now();
+        for (int x : sorted)
+            inserted.insert(x);
+        auto t2 = std::chrono::high_resolution_clock::now();
+        double insert_time = std::chrono::duration<double>(t2 - t1).count();
+
+        AVLTree<int> loaded;
+        t1 = std::chrono::high_resolution_clock::now();
+        loaded.bulkLoad(sorted.begin(), sorted.end());
+        t2 = std::chrono::high_resolution_clock::now();
+        double sorted_time = std::chrono::duration<double>(t2 - t1).count();
+
+        t1 = std::chrono::high_resolution_clock::now();
+        loaded.bulkLoad(data.begin(), data.end());
+        t2 = std::chrono::high_resolution_clock::now();
+        double unsorted_time = std::chrono::duration<double>(t2 - t1).count();
+
+        ofs << n << "," << std::fixed << std::setprecision(6)
+            << insert_time << "," << sorted_time << "," << unsorted_time << "\n";
+        std::cout << "Size: " << n
+                  << ", insert: " << insert_time << "s"
+                  << ", bulk load (sorted): " << sorted_time << "s"
+                  << ", bulk load (unsorted): " << unsorted_time << "s" << std::endl;
+    }
+    ofs.close();
+    std::cout << "Data successfully written to: tests/" << filename << std::endl;
+}
+
+// Merges two random AVL trees of n keys each, the old way (insert every key of the
+// other tree) against the linear flatten-merge-rebuild path
+static void merge_performance_test(const std::string &filename, size_t max_size, size_t step)
+{
+    std::ofstream ofs("../tests/" + filename);
+    if (!ofs.is_open())
+    {
+        std::cerr << "Failed to open file: tests/" << filename << std::endl;
+        return;
+    }
+    std::cout << "File opened successfully: tests/" << filename << std::endl;
+
+    ofs << "size,avltree_merge_insert,avltree_merge_linear,avltree_merge_immutable_insert,avltree_merge_immutable_linear\n";
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> dist(1, 1e9);
+
+    for (size_t n = step; n <= max_size; n += step)
+    {
+        std::vector<int> a(n), b(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            a[i] = dist(rng);
+            b[i] = dist(rng);
+        }
+        AVLTree<int> left(a.begin(), a.end());
+        AVLTree<int> right(b.begin(), b.end());
+
+        AVLTree<int> target(left);
+        auto t1 = std::chrono::high_resolution_clock::now();
+        for (auto it = right.cbegin(); it != right.cend(); ++it)
+            target.insert(*it);
+        auto t2 = std::chrono::high_resolution_clock::now();
+        double insert_time = std::chrono::duration<double>(t2 - t1).count();
+
+        target = left;
+        t1 = std::chrono::high_resolution_clock::now();
+        target.merge(right);
+        t2 = std::chrono::high_resolution_clock::now();
+        double linear_time = std::chrono::duration<double>(t2 - t1).count();
+
+        t1 = std::chrono::high_resolution_clock::now();
+        AVLTree<int> *copy = new AVLTree<int>(left);
+        for (auto it = right.cbegin(); it != right.cend(); ++it)
+            copy->insert(*it);
+        t2 = std::chrono::high_resolution_clock::now();
+        double immutable_insert_time = std::chrono::duration<double>(t2 - t1).count();
+        delete copy;
+
+        t1 = std::chrono::high_resolution_clock::now();
+        BinaryTree<int> *merged = left.mergeImmutable(right);
+        t2 = std::chrono::high_resolution_clock::now();
+        double immutable_linear_time = std::chrono::duration<double>(t2 - t1).count();
+        delete merged;
+
+        ofs << n << "," << std::fixed << std::setprecision(6) << insert_time << "," << linear_time << ","
+            << immutable_insert_time << "," << immutable_linear_time << "\n";
+        std::cout << "Size: " << n
+                  << ", merge by insert: " << insert_time << "s"
+                  << ", linear merge: " << linear_time << "s"
+                  << ", immutable by insert: " << immutable_insert_time << "s"
+                  << ", immutable linear: " << immutable_linear_time << "s" << std::endl;
+    }
+    ofs.close();
+    std::cout << "Data successfully written to: tests/" << filename << std::endl;
+}
+
+// Union/intersection/difference of two random AVL trees of n keys each: element-wise
+// insert/search/remove against the join/split based operations
+static void set_ops_performance_test(const std::string &filename, size_t max_size, size_t step)
+{
+    std::ofstream ofs("../tests/" + filename);
+    if (!ofs.is_open())
+    {
+        std::cerr << "Failed to open file: tests/" << filename << std::endl;
+        return;
+    }
+    std::cout << "File opened successfully: tests/" << filename << std::endl;
+
+    ofs << "size,union_insert,union_join,intersect_search,intersect_join,difference_remove,difference_join\n";
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> dist(1, 2 * static_cast<int>(max_size));
+
+    for (size_t n = step; n <= max_size; n += step)
+    {
+        std::vector<int> a(n), b(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            a[i] = dist(rng);
+            b[i] = dist(rng);
+        }
+        AVLTree<int> left(a.begin(), a.end());
+        AVLTree<int> right(b.begin(), b.end());
+
+        auto t1 = std::chrono::high_resolution_clock::now();
+        AVLTree<int> naive(left);
+        for (auto it = right.cbegin(); it != right.cend(); ++it)
+            naive.insert(*it);
+        auto t2 = std::chrono::high_resolution_clock::now();
+        double union_insert = std::chrono::duration<double>(t2 - t1).count();
+
+        t1 = std::chrono::high_resolution_clock::now();
+        AVLTree<int> joined = left.unionWith(right);
+        t2 = std::chrono::high_resolution_clock::now();
+        double union_join = std::chrono::duration<double>(t2 - t1).count();
+
+        t1 = std::chrono::high_resolution_clock::now();
+        AVLTree<int> common;
+        for (auto it = left.cbegin(); it != left.cend(); ++it)
+            if (right.hasValue(*it))
+                common.insert(*it);
+        t2 = std::chrono::high_resolution_clock::now();
+        double intersect_search = std::chrono::duration<double>(t2 - t1).count();
+
+        t1 = std::chrono::high_resolution_clock::now();
+        AVLTree<int> intersected = left.intersect(right);
+        t2 = std::chrono::high_resolution_clock::now();
+        double intersect_join = std::chrono::duration<double>(t2 - t1).count();
+
+        t1 = std::chrono::high_resolution_clock::now();
+        AVLTree<int> rest(left);
+        for (auto it = right.cbegin(); it != right.cend(); ++it)
+            rest.remove(*it);
+        t2 = std::chrono::high_resolution_clock::now();
+        double difference_remove = std::chrono::duration<double>(t2 - t1).count();
+
+        t1 = std::chrono::high_resolution_clock::now();
+        AVLTree<int> diff = left.difference(right);
+        t2 = std::chrono::high_resolution_clock::now();
+        double difference_join = std::chrono::duration<double>(t2 - t1).count();
+
+        ofs << n << "," << std::fixed << std::setprecision(6) << union_insert << "," << union_join << ","
+            << intersect_search << "," << intersect_join << "," << difference_remove << "," << difference_join << "\n";
+        std::cout << "Size: " << n
+                  << ", union: " << union_insert << "s / " << union_join << "s"
+                  << ", intersect: " << intersect_search << "s / " << intersect_join << "s"
+                  << ", difference: " << difference_remove << "s / " << difference_join << "s" << std::endl;
+    }
+    ofs.close();
+    std::cout << "Data successfully written to: tests/" << filename << std::endl;
+}
+
+// Adds batches of random keys to a tree of base_size keys, with a loop of insert calls
+// and with insertBatch
+static void batch_insert_performance_test(const std::string &filename, size_t base_size,
+                                          const std::vector<size_t> &batch_sizes)
+{
+    std::ofstream ofs("../tests/" + filename);
+    if (!ofs.is_open())
+    {
+        std::cerr << "Failed to open file: tests/" << filename << std::endl;
+        return;
+    }
+    std::cout << "File opened successfully: tests/" << filename << std::endl;
+
+    ofs << "batch_size,avltree_insert_loop,avltree_insert_batch\n";
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> dist(1, 1e9);
+    std::vector<int> base(base_size);
+    for (size_t i = 0; i < base_size; ++i)
+        base[i] = dist(rng);
+    AVLTree<int> original(base.begin(), base.end());
+
+    for (size_t m : batch_sizes)
+    {
+        std::vector<int> batch(m);
+        for (size_t i = 0; i < m; ++i)
+            batch[i] = dist(rng);
+
+        AVLTree<int> looped(original);
+        auto t1 = std::chrono::high_resolution_clock::now();
+        for (int x : batch)
+            looped.insert(x);
+        auto t2 = std::chrono::high_resolution_clock::now();
+        double loop_time = std::chrono::duration<double>(t2 - t1).count();
+
+        AVLTree<int> batched(original);
+        t1 = std::chrono::high_resolution_clock::now();
+        batched.insertBatch(batch.begin(), batch.end());
+        t2 = std::chrono::high_resolution_clock::now();
+        double batch_time = std::chrono::duration<double>(t2 - t1).count();
+
+        if (looped.size() != batched.size())
+            std::cerr << "Batch insert mismatch: " << batched.size() << " of " << looped.size() << std::endl;
+
+        ofs << m << "," << std::fixed << std::setprecision(6) << loop_time << "," << batch_time << "\n";
+        std::cout << "Batch: " << m << ", insert loop: " << loop_time << "s"
+                  << ", insertBatch: " << batch_time << "s" << std::endl;
+    }
+    ofs.close();
+    std::cout << "Data successfully written to: tests/" << filename << std::endl;
+}
+
+int main()
+{
+    bulk_load_performance_test("bulk_load_performance.csv", 5000000, 500000);
+    merge_performance_test("merge_performance.csv", 2000000, 200000);
+    set_ops_performance_test("set_ops_performance.csv", 1000000, 100000);
+    batch_insert_performance_test("batch_insert_performance.csv", 1000000, {1000, 10000, 30000, 100000, 300000, 1000000});
+    return 0;
+}
@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+#include "../inc/concurrentAVLTree.hpp"
+#include <atomic>
+#include <cmath>
+#include <random>
+#include <set>
+#include <thread>
+#include <vector>
+
+TEST(ConcurrentAVLTree, EmptyTree)
+{
+    ConcurrentAVLTree<int> tree;
+    EXPECT_TRUE(tree.isEmpty());
+    EXPECT_EQ(tree.size(), 0u);
+    EXPECT_THROW(tree.getHeight(), std::runtime_error);
+    EXPECT_FALSE(tree.hasValue(1));
+    EXPECT_TRUE(tree.range(0, 10).empty());
+    EXPECT_THROW(tree.getMin(), std::runtime_error);
+    EXPECT_THROW(tree.getMax(), std::runtime_error);
+    tree.remove(1);
+    tree.insert(1);
+    EXPECT_EQ(tree.getHeight(), 0);
+    tree.clear();
+    EXPECT_TRUE(tree.isEmpty());
+}
+
+TEST(ConcurrentAVLTree, MatchesStdSet)
+{
+    std::mt19937 rng(13);
+    std::uniform_int_distribution<int> dist(0, 3000);
+    ConcurrentAVLTree<int> tree;
+    std::set<int> reference;
+
+    for (int round = 0; round < 20000; ++round)
+    {
+        int x = dist(rng);
+        if (rng() % 3 == 0)
+        {
+            tree.remove(x);
+            reference.erase(x);
+        }
+        else
+        {
+            tree.insert(x);
+            reference.insert(x);
+        }
+    }
+
+    ASSERT_EQ(tree.size(), reference.size());
+    EXPECT_EQ(tree.range(-1, 3001), std::vector<int>(reference.begin(), reference.end()));
+    EXPECT_EQ(tree.range(100, 200), std::vector<int>(reference.lower_bound(100), reference.upper_bound(200)));
+    EXPECT_LE(tree.getHeight(), 1.45 * std::log2(reference.size() + 2));
+    EXPECT_EQ(tree.getMin(), *reference.begin());
+    EXPECT_EQ(tree.getMax(), *reference.rbegin());
+    for (int x = -1; x <= 3001; ++x)
+        EXPECT_EQ(tree.hasValue(x), reference.count(x) == 1);
+
+    for (int x : std::vector<int>(reference.begin(), reference.end()))
+        tree.remove(x);
+    EXPECT_TRUE(tree.isEmpty());
+    EXPECT_EQ(tree.size(), 0u);
+
+    tree.insert(5);
+    tree.insert(1);
+    tree.clear();
+    EXPECT_TRUE(tree.isEmpty());
+    EXPECT_FALSE(tree.hasValue(5));
+}
+
+TEST(ConcurrentAVLTree, ReadersSeeStableKeysWhileWritersChurn)
+{
+    // Even keys are inserted up front and never touched again; two writers churn the
+    // odd keys, each its own half of them. Readers must always find every even key,
+    // never a key outside the range, and get sorted ranges holding all the even keys.
+    const int limit = 4000;
+    ConcurrentAVLTree<int> tree;
+    for (int x = 0; x < limit; x += 2)
+        tree.insert(x);
+
+    std::atomic<bool> stop(false);
+    std::atomic<int> failures(0);
+    std::vector<std::set<int>> owned(2);
+    std::vector<std::thread> threads;
+    for (int w = 0; w < 2; ++w)
+    {
+        threads.emplace_back([&, w]()
+                             {
+                                 std::mt19937 rng(100 + w);
+                                 std::uniform_int_distribution<int> dist(0, limit / 4 - 1);
+                                 for (int round = 0; round < 30000; ++round)
+                                 {
+                                     int x = 4 * dist(rng) + 2 * w + 1;
+                                     if (rng() % 2 == 0)
+                                     {
+                                         tree.insert(x);
+                                         owned[w].insert(x);
+                                     }
+                                     else
+                                     {
+                                         tree.remove(x);
+                                         owned[w].erase(x);
+                                     }
+                                 } });
+    }
+    for (int r = 0; r < 3; ++r)
+    {
+        threads.emplace_back([&, r]()
+                             {
+                                 std::mt19937 rng(200 + r);
+                                 std::uniform_int_distribution<int> dist(0, limit / 2 - 1);
+                                 while (!stop.load())
+                                 {
+                                     if (!tree.hasValue(2 * dist(rng)) || tree.hasValue(-1 - dist(rng)))
+                                         failures.fetch_add(1);
+                                     int lo = 2 * dist(rng);
+                                     std::vector<int> keys = tree.range(lo, lo + 40);
+                                     size_t evens = 0;
+                                     for (size_t i = 0; i < keys.size(); ++i)
+                                     {
+                                         if (keys[i] % 2 == 0)
+                                             ++evens;
+                                         if (i > 0 && keys[i - 1] >= keys[i])
+                                             failures.fetch_add(1);
+                                     }
+                                     if (evens != static_cast<size_t>(std::min(lo + 40, limit - 2) - lo) / 2 + 1)
+                                         failures.fetch_add(1);
+                                     if (tree.getMin() != 0 || tree.getMax() < limit - 2)
+                                         failures.fetch_add(1);
+                                 } });
+    }
+    threads[0].join();
+    threads[1].join();
+    stop.store(true);
+    for (size_t i = 2; i < threads.size(); ++i)
+        threads[i].join();
+
+    EXPECT_EQ(failures.load(), 0);
+    std::set<int> expected(owned[0].begin(), owned[0].end());
+    expected.insert(owned[1].begin(), owned[1].end());
+    for (int x = 0; x < limit; x += 2)
+        expected.insert(x);
+    EXPECT_EQ(tree.range(-1, limit), std::vector<int>(expected.begin(), expected.end()));
+    EXPECT_EQ(tree.size(), expected.size());
+    EXPECT_LE(tree.getHeight(), 1.45 * std::log2(expected.size() + 2));
+}
+
+TEST(ConcurrentAVLTree, ReadersRaceClearAndRefill)
+{
+    // Every clear retires the whole tree while readers are inside it; the key 0 is
+    // back after each refill, and nothing a reader returns is ever outside the keys
+    ConcurrentAVLTree<int> tree;
+    std::atomic<bool> stop(false);
+    std::atomic<int> failures(0);
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r)
+    {
+        readers.emplace_back([&, r]()
+                             {
+                                 std::mt19937 rng(400 + r);
+                                 std::uniform_int_distribution<int> dist(0, 999);
+                                 while (!stop.load())
+                                 {
+                                     tree.hasValue(dist(rng));
+                                     for (int x : tree.range(0, 50))
+                                         if (x < 0 || x > 50)
+                                             failures.fetch_add(1);
+                                 } });
+    }
+    for (int round = 0; round < 200; ++round)
+    {
+        for (int x = 0; x < 1000; ++x)
+            tree.insert((x * 7919) % 1000);
+        if (!tree.hasValue(0) || tree.size() != 1000)
+            failures.fetch_add(1);
+        tree.clear();
+    }
+    stop.store(true);
+    for (std::thread &reader : readers)
+        reader.join();
+
+    EXPECT_EQ(failures.load(), 0);
+    EXPECT_TRUE(tree.isEmpty());
+}
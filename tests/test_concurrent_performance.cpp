@@ -0,0 +1,181 @@
+#include "../inc/AVLTree.hpp"
+#include "../inc/concurrentAVLTree.hpp"
+#include "benchmarkUtils.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// AVLTree behind one mutex, as the service uses it today
+struct MutexTree
+{
+    AVLTree<int> tree;
+    std::mutex mutex;
+
+    bool hasValue(int x)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return tree.hasValue(x);
+    }
+    void insert(int x)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tree.insert(x);
+    }
+    void remove(int x)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tree.remove(x);
+    }
+};
+
+// AVLTree behind a reader/writer lock: readers share it but wait for writers
+struct SharedMutexTree
+{
+    AVLTree<int> tree;
+    std::shared_timed_mutex mutex;
+
+    bool hasValue(int x)
+    {
+        std::shared_lock<std::shared_timed_mutex> lock(mutex);
+        return tree.hasValue(x);
+    }
+    void insert(int x)
+    {
+        std::unique_lock<std::shared_timed_mutex> lock(mutex);
+        tree.insert(x);
+    }
+    void remove(int x)
+    {
+        std::unique_lock<std::shared_timed_mutex> lock(mutex);
+        tree.remove(x);
+    }
+};
+
+struct ConcurrentTree
+{
+    ConcurrentAVLTree<int> tree;
+
+    bool hasValue(int x) { return tree.hasValue(x); }
+    void insert(int x) { tree.insert(x); }
+    void remove(int x) { tree.remove(x); }
+};
+
+// Keeps the lookups from being optimized away
+static std::atomic<unsigned long long> lookup_hits(0);
+
+// Operations per second of `threads` threads doing a random mix for `seconds`: a
+// lookup with probability read_percent / 100, otherwise an insert or a remove. Keys
+// are drawn from [0, keys) and half of them are in the tree at the start.
+template <typename Tree>
+static double measure_throughput(unsigned threads, int read_percent, int keys, double seconds)
+{
+    Tree tree;
+    std::mt19937 fill(42);
+    std::uniform_int_distribution<int> key(0, keys - 1);
+    for (int i = 0; i < keys / 2; ++i)
+        tree.insert(key(fill));
+
+    std::atomic<bool> start(false), stop(false);
+    std::vector<unsigned long long> ops(threads, 0);
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; ++t)
+    {
+        workers.emplace_back([&, t]()
+                             {
+                                 std::mt19937 rng(1000 + t);
+                                 std::uniform_int_distribution<int> local_key(0, keys - 1);
+                                 std::uniform_int_distribution<int> percent(0, 99);
+                                 unsigned long long done = 0, hits = 0;
+                                 while (!start.load())
+                                     std::this_thread::yield();
+                                 while (!stop.load(std::memory_order_relaxed))
+                                 {
+                                     int x = local_key(rng);
+                                     int roll = percent(rng);
+                                     if (roll < read_percent)
+                                         hits += tree.hasValue(x) ? 1 : 0;
+                                     else if (roll % 2 == 0)
+                                         tree.insert(x);
+                                     else
+                                         tree.remove(x);
+                                     ++done;
+                                 }
+                                 ops[t] = done;
+                                 lookup_hits.fetch_add(hits); });
+    }
+
+    auto t1 = std::chrono::high_resolution_clock::now();
+    start.store(true);
+    std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+    stop.store(true);
+    for (std::thread &worker : workers)
+        worker.join();
+    auto t2 = std::chrono::high_resolution_clock::now();
+
+    unsigned long long total = 0;
+    for (unsigned long long n : ops)
+        total += n;
+    return total / std::chrono::duration<double>(t2 - t1).count();
+}
+
+// Throughput of the three trees for every thread count and read share
+static void concurrent_performance_test(const std::string &filename, const std::vector<int> &thread_counts,
+                                        const std::vector<int> &read_percents, int keys, double seconds)
+{
+    std::ofstream ofs;
+    if (!open_results_file(ofs, filename))
+        return;
+
+    ofs << "threads,read_percent,keys,mutex_ops,shared_mutex_ops,concurrent_ops\n";
+    for (int read_percent : read_percents)
+    {
+        for (int threads : thread_counts)
+        {
+            double locked = measure_throughput<MutexTree>(threads, read_percent, keys, seconds);
+            double shared = measure_throughput<SharedMutexTree>(threads, read_percent, keys, seconds);
+            double concurrent = measure_throughput<ConcurrentTree>(threads, read_percent, keys, seconds);
+
+            ofs << threads << "," << read_percent << "," << keys << "," << std::fixed << std::setprecision(0)
+                << locked << "," << shared << "," << concurrent << "\n";
+            std::cout << "Threads: " << threads << ", reads: " << read_percent << "%"
+                      << ", mutex: " << locked << " ops/s"
+                      << ", shared_mutex: " << shared << " ops/s"
+                      << ", concurrent: " << concurrent << " ops/s" << std::endl;
+        }
+    }
+    ofs.close();
+    std::cout << "Data successfully written to: tests/" << filename << std::endl;
+}
+
+// Usage: test_concurrent_performance [threads=1,2,4,8] [reads=50,90,99,100]
+//                                    [keys=1000000] [seconds=1]
+int main(int argc, char **argv)
+{
+    std::vector<int> thread_counts = {1, 2, 4, 8};
+    std::vector<int> read_percents = {50, 90, 99, 100};
+    int keys = 1000000;
+    double seconds = 1.0;
+    bool parsed = parse_arguments(argc, argv,
+                                  {{"threads", [&](const std::string &value)
+                                    { thread_counts = parse_list(value); }},
+                                   {"reads", [&](const std::string &value)
+                                    { read_percents = parse_list(value); }},
+                                   {"keys", [&](const std::string &value)
+                                    { keys = std::atoi(value.c_str()); }},
+                                   {"seconds", [&](const std::string &value)
+                                    { seconds = std::atof(value.c_str()); }}});
+    if (!parsed)
+        return 1;
+
+    concurrent_performance_test("concurrent_performance.csv", thread_counts, read_percents, keys, seconds);
+    return 0;
+}
@@ -0,0 +1,98 @@
+#include "../inc/AVLTree.hpp"
+#include <chrono>
+#include <fstream>
+#include <vector>
+#include <random>
+#include <iostream>
+#include <iomanip>
+#include <memory>
+
+// Seconds per call of op, repeated `rounds` times
+template <typename Op>
+static double time_per_call(size_t rounds, Op op)
+{
+    auto t1 = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < rounds; ++i)
+        op();
+    auto t2 = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double>(t2 - t1).count() / rounds;
+}
+
+// Cost of handing a whole tree over: copy vs move construction and assignment, and
+// putting a returned tree on the heap. Move times include the move back.
+static void copy_performance_test(const std::string &filename, const std::vector<size_t> &sizes)
+{
+    std::ofstream ofs("../tests/" + filename);
+    if (!ofs.is_open())
+    {
+        std::cerr << "Failed to open file: tests/" << filename << std::endl;
+        return;
+    }
+    std::cout << "File opened successfully: tests/" << filename << std::endl;
+
+    ofs << "size,copy,move,copy_assign,move_assign,heap_copy,heap_move\n";
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> dist(1, 2e9);
+
+    for (size_t n : sizes)
+    {
+        AVLTree<int> tree;
+        for (size_t i = 0; i < n; ++i)
+            tree.insert(dist(rng));
+        size_t copies = std::max<size_t>(1, std::min<size_t>(1000, 2000000 / n));
+        size_t moves = 1000000;
+        size_t kept = 0;
+
+        double copy = time_per_call(copies, [&]()
+                                    {
+                                        AVLTree<int> other(tree);
+                                        kept += other.isEmpty() ? 0 : 1; });
+        double move = time_per_call(moves, [&]()
+                                    {
+                                        AVLTree<int> other(std::move(tree));
+                                        tree = std::move(other);
+                                        kept += tree.isEmpty() ? 0 : 1; });
+
+        AVLTree<int> target;
+        double copy_assign = time_per_call(copies, [&]()
+                                           {
+                                               target = tree;
+                                               kept += target.isEmpty() ? 0 : 1; });
+        double move_assign = time_per_call(moves, [&]()
+                                           {
+                                               target = std::move(tree);
+                                               tree = std::move(target);
+                                               kept += tree.isEmpty() ? 0 : 1; });
+
+        // A tree returned by value, e.g. from where(), put on the heap as the wasm
+        // bindings do
+        BinaryTree<int> result(tree);
+        double heap_copy = time_per_call(copies, [&]()
+                                         {
+                                             std::unique_ptr<BinaryTree<int>> heap(new BinaryTree<int>(result));
+                                             kept += heap->isEmpty() ? 0 : 1; });
+        double heap_move = time_per_call(moves, [&]()
+                                         {
+                                             std::unique_ptr<BinaryTree<int>> heap(new BinaryTree<int>(std::move(result)));
+                                             result = std::move(*heap);
+                                             kept += result.isEmpty() ? 0 : 1; });
+        if (kept != 3 * copies + 3 * moves)
+            std::cerr << "A tree lost its nodes" << std::endl;
+
+        ofs << n << "," << std::scientific << std::setprecision(6)
+            << copy << "," << move << "," << copy_assign << "," << move_assign << ","
+            << heap_copy << "," << heap_move << "\n";
+        std::cout << "Size: " << n
+                  << ", copy/move: " << copy << "s / " << move << "s"
+                  << ", assign copy/move: " << copy_assign << "s / " << move_assign << "s"
+                  << ", to heap copy/move: " << heap_copy << "s / " << heap_move << "s" << std::endl;
+    }
+    ofs.close();
+    std::cout << "Data successfully written to: tests/" << filename << std::endl;
+}
+
+int main()
+{
+    copy_performance_test("copy_performance.csv", {1000, 10000, 100000, 1000000});
+    return 0;
+}
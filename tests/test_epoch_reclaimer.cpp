@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+#include "../inc/epochReclaimer.hpp"
+#include "../inc/AVLTree.hpp"
+#include <atomic>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+struct TrackedNode
+{
+    int value;
+    std::atomic<bool> alive;
+
+    explicit TrackedNode(int value) : value(value), alive(true) {}
+};
+
+// Marks nodes dead instead of freeing them, so a reader that still sees a node after
+// its free is caught even without a sanitizer; the graveyard is freed at the end
+struct Graveyard
+{
+    std::vector<TrackedNode *> *buried;
+
+    void operator()(TrackedNode *node) const
+    {
+        node->alive.store(false, std::memory_order_relaxed);
+        buried->push_back(node);
+    }
+};
+
+static void emptyGraveyard(std::vector<TrackedNode *> &buried)
+{
+    for (TrackedNode *node : buried)
+        delete node;
+    buried.clear();
+}
+
+TEST(EpochReclaimer, FreesOnlyAfterEarlierReadersLeave)
+{
+    std::vector<TrackedNode *> buried;
+    {
+        EpochReclaimer<TrackedNode, Graveyard> reclaimer(1000, Graveyard{&buried});
+        TrackedNode *node = new TrackedNode(1);
+        {
+            EpochReclaimer<TrackedNode, Graveyard>::Guard guard(reclaimer);
+            reclaimer.retire(node);
+            EXPECT_TRUE(reclaimer.collect());
+            EXPECT_FALSE(reclaimer.collect());
+            EXPECT_FALSE(reclaimer.collect());
+            EXPECT_TRUE(node->alive.load());
+            EXPECT_EQ(reclaimer.pending(), 1u);
+        }
+        EXPECT_TRUE(reclaimer.collect());
+        EXPECT_FALSE(node->alive.load());
+        EXPECT_EQ(reclaimer.pending(), 0u);
+        EXPECT_EQ(reclaimer.epoch(), 2u);
+
+        // Whatever is still pending goes with the reclaimer
+        reclaimer.retire(new TrackedNode(2));
+        EXPECT_EQ(buried.size(), 1u);
+    }
+    EXPECT_EQ(buried.size(), 2u);
+    emptyGraveyard(buried);
+}
+
+TEST(EpochReclaimer, OverlappingReadersDoNotHoldFreesBack)
+{
+    // There is never a moment without a reader, yet each batch is freed once the
+    // readers that entered before it was retired have left
+    std::vector<TrackedNode *> buried;
+    EpochReclaimer<TrackedNode, Graveyard> reclaimer(1000, Graveyard{&buried});
+    std::unique_ptr<EpochReclaimer<TrackedNode, Graveyard>::Guard> older(
+        new EpochReclaimer<TrackedNode, Graveyard>::Guard(reclaimer));
+    for (int round = 0; round < 10; ++round)
+    {
+        reclaimer.retire(new TrackedNode(round));
+        EXPECT_TRUE(reclaimer.collect());
+        std::unique_ptr<EpochReclaimer<TrackedNode, Graveyard>::Guard> newer(
+            new EpochReclaimer<TrackedNode, Graveyard>::Guard(reclaimer));
+        older = std::move(newer);
+        EXPECT_EQ(buried.size(), static_cast<size_t>(round));
+    }
+    older.reset();
+    EXPECT_TRUE(reclaimer.collect());
+    EXPECT_EQ(buried.size(), 10u);
+    emptyGraveyard(buried);
+}
+
+TEST(EpochReclaimer, RetireCollectsInBatches)
+{
+    std::vector<TrackedNode *> buried;
+    {
+        EpochReclaimer<TrackedNode, Graveyard> reclaimer(8, Graveyard{&buried});
+        for (int i = 0; i < 64; ++i)
+            reclaimer.retire(new TrackedNode(i));
+        // Every eighth retire collects the batch before the last one
+        EXPECT_EQ(buried.size(), 56u);
+        EXPECT_EQ(reclaimer.pending(), 8u);
+    }
+    emptyGraveyard(buried);
+}
+
+TEST(EpochReclaimer, ReadersNeverSeeFreedNodes)
+{
+    // A writer keeps replacing the published nodes and retiring the old ones while
+    // readers dereference whatever they find under a guard
+    const int slots = 8;
+    std::vector<TrackedNode *> buried;
+    {
+        EpochReclaimer<TrackedNode, Graveyard> reclaimer(16, Graveyard{&buried});
+        std::vector<std::atomic<TrackedNode *>> published(slots);
+        for (int i = 0; i < slots; ++i)
+            published[i].store(new TrackedNode(i));
+
+        std::atomic<bool> stop(false);
+        std::atomic<int> failures(0);
+        std::vector<std::thread> readers;
+        for (int r = 0; r < 4; ++r)
+        {
+            readers.emplace_back([&, r]()
+                                 {
+                                     std::mt19937 rng(300 + r);
+                                     while (!stop.load())
+                                     {
+                                         EpochReclaimer<TrackedNode, Graveyard>::Guard guard(reclaimer);
+                                         for (int step = 0; step < 16; ++step)
+                                         {
+                                             int i = rng() % slots;
+                                             TrackedNode *node = published[i].load(std::memory_order_acquire);
+                                             if (!node->alive.load(std::memory_order_relaxed) || node->value % slots != i)
+                                                 failures.fetch_add(1);
+                                         }
+                                     } });
+        }
+
+        for (int round = 0; round < 200000; ++round)
+        {
+            int i = round % slots;
+            TrackedNode *old = published[i].exchange(new TrackedNode(round + slots), std::memory_order_acq_rel);
+            reclaimer.retire(old);
+        }
+        stop.store(true);
+        for (std::thread &reader : readers)
+            reader.join();
+
+        EXPECT_EQ(failures.load(), 0);
+        // Frees happen on the way, not only when the reclaimer goes
+        EXPECT_GT(buried.size(), 0u);
+        for (int i = 0; i < slots; ++i)
+            delete published[i].load();
+    }
+    EXPECT_EQ(buried.size(), 200000u);
+    emptyGraveyard(buried);
+}
+
+TEST(EpochReclaimer, TreeRemoveRetiresThroughTheAllocator)
+{
+    AVLTree<int, EpochNodeAllocator<int>> tree;
+    for (int i = 0; i < 100; ++i)
+        tree.insert(i);
+    EpochNodeAllocator<int>::Reclaimer &reclaimer = tree.getAllocator().reclaimer();
+    {
+        EpochNodeAllocator<int>::Reclaimer::Guard guard(reclaimer);
+        // A leaf is unlinked itself, so a reader holding it keeps a valid node
+        const TreeNode<int> *leaf = tree.getRoot();
+        while (leaf->getLeft() || leaf->getRight())
+            leaf = leaf->getLeft() ? leaf->getLeft() : leaf->getRight();
+        int key = leaf->getData();
+        tree.remove(key);
+        EXPECT_FALSE(tree.hasValue(key));
+        EXPECT_EQ(leaf->getData(), key);
+        for (int i = 0; i < 100; i += 2)
+            tree.remove(i);
+        EXPECT_GE(reclaimer.pending(), 50u);
+    }
+    EXPECT_TRUE(reclaimer.collect());
+    EXPECT_TRUE(reclaimer.collect());
+    EXPECT_EQ(reclaimer.pending(), 0u);
+
+    AVLTree<int, EpochNodeAllocator<int>> moved(std::move(tree));
+    moved.remove(1);
+    EXPECT_EQ(moved.getRoot()->getSize(), 49u);
+}
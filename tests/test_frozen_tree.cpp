@@ -0,0 +1,234 @@
+#include <gtest/gtest.h>
+#include "../inc/binaryTree.hpp"
+#include "../inc/AVLTree.hpp"
+#include "../types/person.hpp"
+#include "testUtils.hpp"
+#include <vector>
+#include <set>
+#include <random>
+#include <string>
+#include <limits>
+#include <cmath>
+
+TEST(FrozenTree, EmptySnapshot)
+{
+    AVLTree<int> tree;
+    FrozenTree<int> frozen = tree.freeze();
+    EXPECT_TRUE(frozen.isEmpty());
+    EXPECT_FALSE(frozen.hasValue(1));
+    EXPECT_TRUE(frozen.cbegin() == frozen.cend());
+    EXPECT_TRUE(frozen.lowerBound(1) == frozen.cend());
+}
+
+TEST(FrozenTree, MatchesSourceTree)
+{
+    // Every size up to a few full levels, so that partial last levels are covered
+    for (int n = 1; n <= 70; ++n)
+    {
+        AVLTree<int> tree;
+        std::set<int> reference;
+        for (int i = 0; i < n; ++i)
+        {
+            tree.insert(i * 3);
+            reference.insert(i * 3);
+        }
+        FrozenTree<int> frozen = tree.freeze();
+        ASSERT_EQ(frozen.size(), static_cast<size_t>(n));
+        EXPECT_EQ(valuesOf(frozen), std::vector<int>(reference.begin(), reference.end()));
+
+        for (int x = -1; x <= n * 3; ++x)
+        {
+            EXPECT_EQ(frozen.hasValue(x), reference.count(x) == 1);
+            auto lower = frozen.lowerBound(x);
+            auto upper = frozen.upperBound(x);
+            if (reference.lower_bound(x) == reference.end())
+                EXPECT_TRUE(lower == frozen.cend());
+            else
+                EXPECT_EQ(*lower, *reference.lower_bound(x));
+            if (reference.upper_bound(x) == reference.end())
+                EXPECT_TRUE(upper == frozen.cend());
+            else
+                EXPECT_EQ(*upper, *reference.upper_bound(x));
+        }
+    }
+}
+
+TEST(FrozenTree, SnapshotIsIndependent)
+{
+    AVLTree<int> tree;
+    for (int i = 0; i < 100; ++i)
+        tree.insert(i);
+    FrozenTree<int> frozen = tree.freeze();
+    tree.clear();
+    EXPECT_TRUE(frozen.hasValue(42));
+    EXPECT_EQ(*frozen.cbegin(), 0);
+
+    // Copies lay out their own aligned storage
+    FrozenTree<int> copy = frozen;
+    FrozenTree<int> assigned;
+    assigned = copy;
+    EXPECT_EQ(valuesOf(copy), valuesOf(frozen));
+    EXPECT_EQ(valuesOf(assigned), valuesOf(frozen));
+    EXPECT_TRUE(assigned.hasValue(99));
+    EXPECT_FALSE(assigned.hasValue(100));
+}
+
+TEST(FrozenTree, MovedFromSnapshotIsEmpty)
+{
+    AVLTree<int> tree;
+    for (int i = 0; i < 100; ++i)
+        tree.insert(i);
+    FrozenTree<int> frozen = tree.freeze();
+    FrozenTree<int> moved(std::move(frozen));
+    EXPECT_EQ(moved.size(), 100u);
+    EXPECT_TRUE(moved.hasValue(42));
+
+    EXPECT_TRUE(frozen.isEmpty());
+    EXPECT_EQ(frozen.size(), 0u);
+    EXPECT_FALSE(frozen.hasValue(42));
+    EXPECT_TRUE(frozen.cbegin() == frozen.cend());
+    EXPECT_TRUE(frozen.lowerBound(0) == frozen.cend());
+
+    FrozenTree<int> assigned;
+    assigned = std::move(moved);
+    EXPECT_EQ(valuesOf(assigned).size(), 100u);
+    EXPECT_TRUE(moved.isEmpty());
+    EXPECT_FALSE(moved.hasValue(0));
+    EXPECT_TRUE(moved.upperBound(0) == moved.cend());
+
+    // A moved-from snapshot can be assigned again
+    moved = assigned;
+    EXPECT_TRUE(moved.hasValue(99));
+}
+
+TEST(FrozenTree, UnorderedTreeAndDuplicates)
+{
+    BinaryTree<int> tree;
+    tree.insert(5);
+    for (int x : {9, 1, 5, 7, 3})
+        tree.insert(x, tree.getRoot());
+    FrozenTree<int> frozen = tree.freeze();
+    EXPECT_EQ(valuesOf(frozen), std::vector<int>({1, 3, 5, 5, 7, 9}));
+    EXPECT_EQ(*frozen.upperBound(5), 7);
+    EXPECT_FALSE(frozen.hasValue(4));
+}
+
+TEST(FrozenTree, EquivalentPersons)
+{
+    BinaryTree<Person> tree;
+    tree.insert(Person("Bob", 30));
+    tree.insert(Person("Alice", 25));
+    tree.insert(Person("Carol", 30));
+    FrozenTree<Person> frozen = tree.freeze();
+    EXPECT_TRUE(frozen.hasValue(Person("Carol", 30)));
+    EXPECT_TRUE(frozen.hasValue(Person("Bob", 30)));
+    EXPECT_FALSE(frozen.hasValue(Person("Dave", 30)));
+    EXPECT_EQ((*frozen.lowerBound(Person("", 26))).getAge(), 30);
+}
+
+// SIMD static search tree
+template <typename T>
+static void checkAllLevels(const std::vector<T> &keys, const std::vector<T> &probes)
+{
+    std::set<T> reference(keys.begin(), keys.end());
+    for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2, SimdLevel::Auto})
+    {
+        StaticSearchTree<T> tree(keys, level);
+        EXPECT_LE(tree.simdLevel(), StaticSearchTree<T>::supportedSimdLevel());
+        std::vector<bool> batch = tree.hasValues(probes);
+        ASSERT_EQ(batch.size(), probes.size());
+        for (size_t i = 0; i < probes.size(); ++i)
+        {
+            bool expected = reference.count(probes[i]) == 1;
+            EXPECT_EQ(tree.hasValue(probes[i]), expected) << probes[i];
+            EXPECT_EQ(batch[i], expected) << probes[i];
+        }
+    }
+}
+
+TEST(StaticSearchTree, IntMatchesSet)
+{
+    std::mt19937 rng(1);
+    std::uniform_int_distribution<int> dist(-100000, 100000);
+    for (size_t n : {0u, 1u, 15u, 16u, 17u, 300u, 5000u})
+    {
+        std::vector<int> keys, probes;
+        for (size_t i = 0; i < n; ++i)
+            keys.push_back(dist(rng));
+        for (int i = 0; i < 500; ++i)
+            probes.push_back(i % 2 && !keys.empty() ? keys[i % keys.size()] : dist(rng));
+        checkAllLevels(keys, probes);
+    }
+}
+
+TEST(StaticSearchTree, NumericLimits)
+{
+    std::vector<int> probes = {std::numeric_limits<int>::min(), std::numeric_limits<int>::max(), 0, 7};
+    checkAllLevels(std::vector<int>({1, 2, 3}), probes);
+    checkAllLevels(std::vector<int>({std::numeric_limits<int>::min(), 7, std::numeric_limits<int>::max()}), probes);
+}
+
+TEST(StaticSearchTree, DoubleAndOtherTypes)
+{
+    std::vector<double> keys, probes;
+    for (int i = 0; i < 1000; ++i)
+    {
+        keys.push_back(i * 0.5);
+        probes.push_back(i * 0.25);
+    }
+    checkAllLevels(keys, probes);
+
+    // Infinities are ordinary keys; the padding must still sort after +inf
+    const double inf = std::numeric_limits<double>::infinity();
+    const double max = std::numeric_limits<double>::max();
+    std::vector<double> withInf = {inf, -inf, 1.5, max, -2.0};
+    for (int i = 0; i < 40; ++i)
+        withInf.push_back(i * 3.0);
+    std::vector<double> infProbes = {inf, -inf, max, -max, 1.5, 2.0, 0.0, 117.0, 118.0};
+    checkAllLevels(withInf, infProbes);
+    checkAllLevels(std::vector<double>({1.0, 2.0, 3.0}), infProbes);
+    checkAllLevels(std::vector<double>({-inf}), infProbes);
+    checkAllLevels(std::vector<double>({1.0, max}), infProbes);
+    EXPECT_THROW(StaticSearchTree<double>(std::vector<double>({1.0, std::nan(""), 2.0})), std::invalid_argument);
+
+    std::vector<long long> wide = {1LL << 40, -5, 99};
+    checkAllLevels(wide, std::vector<long long>({1LL << 40, 98, 99}));
+    EXPECT_EQ(StaticSearchTree<long long>::supportedSimdLevel(), SimdLevel::Scalar);
+}
+
+TEST(StaticSearchTree, FreezeFromAVLTree)
+{
+    AVLTree<int> tree;
+    for (int i = 0; i < 2000; ++i)
+        tree.insert(i * 7);
+    StaticSearchTree<int> frozen = tree.freezeSimd();
+    StaticSearchTree<int> copy = frozen;
+    EXPECT_EQ(copy.size(), 2000u);
+    for (int i = 0; i < 14000; ++i)
+        EXPECT_EQ(copy.hasValue(i), i % 7 == 0);
+}
+
+TEST(StaticSearchTree, MovedFromTreeIsEmpty)
+{
+    std::vector<int> keys;
+    for (int i = 0; i < 1000; ++i)
+        keys.push_back(i * 3);
+    StaticSearchTree<int> tree(keys);
+    StaticSearchTree<int> moved(std::move(tree));
+    EXPECT_EQ(moved.size(), 1000u);
+    EXPECT_TRUE(moved.hasValue(300));
+
+    EXPECT_TRUE(tree.isEmpty());
+    EXPECT_FALSE(tree.hasValue(300));
+    EXPECT_EQ(tree.hasValues(std::vector<int>({0, 3, 300})), std::vector<bool>(3, false));
+
+    StaticSearchTree<int> assigned;
+    assigned = std::move(moved);
+    EXPECT_TRUE(assigned.hasValue(2997));
+    EXPECT_TRUE(moved.isEmpty());
+    EXPECT_FALSE(moved.hasValue(2997));
+
+    moved = assigned;
+    EXPECT_TRUE(moved.hasValue(0));
+    EXPECT_TRUE(assigned.hasValue(0));
+}
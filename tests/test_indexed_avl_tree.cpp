@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include "../inc/indexedAVLTree.hpp"
+#include "../inc/AVLTree.hpp"
+#include "../types/complex.hpp"
+#include "testUtils.hpp"
+#include <vector>
+#include <set>
+#include <random>
+#include <cmath>
+#include <sstream>
+
+TEST(IndexedAVLTree, EmptyTree)
+{
+    IndexedAVLTree<int> tree;
+    EXPECT_TRUE(tree.isEmpty());
+    EXPECT_EQ(tree.size(), 0u);
+    EXPECT_FALSE(tree.hasValue(1));
+    EXPECT_TRUE(tree.cbegin() == tree.cend());
+    EXPECT_THROW(tree.getMin(), std::runtime_error);
+    EXPECT_THROW(tree.getHeight(), std::runtime_error);
+    tree.remove(1);
+    EXPECT_TRUE(tree.isEmpty());
+}
+
+TEST(IndexedAVLTree, MatchesStdSetAndPointerTree)
+{
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> dist(0, 3000);
+    IndexedAVLTree<int> tree;
+    AVLTree<int> pointerTree;
+    std::set<int> reference;
+
+    for (int round = 0; round < 20000; ++round)
+    {
+        int x = dist(rng);
+        if (rng() % 3 == 0)
+        {
+            tree.remove(x);
+            pointerTree.remove(x);
+            reference.erase(x);
+        }
+        else
+        {
+            tree.insert(x);
+            pointerTree.insert(x);
+            reference.insert(x);
+        }
+    }
+
+    ASSERT_EQ(tree.size(), reference.size());
+    EXPECT_EQ(valuesOf(tree), std::vector<int>(reference.begin(), reference.end()));
+    EXPECT_EQ(tree.getHeight(), pointerTree.getRoot()->getHeight());
+    EXPECT_LE(tree.getHeight(), 1.45 * std::log2(reference.size() + 2));
+    EXPECT_EQ(tree.getMin(), *reference.begin());
+    EXPECT_EQ(tree.getMax(), *reference.rbegin());
+    for (int x = -1; x <= 3001; ++x)
+        EXPECT_EQ(tree.hasValue(x), reference.count(x) == 1);
+
+    for (int x : std::vector<int>(reference.begin(), reference.end()))
+        tree.remove(x);
+    EXPECT_TRUE(tree.isEmpty());
+    EXPECT_EQ(tree.size(), 0u);
+}
+
+TEST(IndexedAVLTree, BuildFromRangeAndCopy)
+{
+    std::vector<int> values = {5, 3, 9, 3, 1, 7, 5};
+    IndexedAVLTree<int> tree(values.begin(), values.end());
+    EXPECT_EQ(valuesOf(tree), std::vector<int>({1, 3, 5, 7, 9}));
+
+    IndexedAVLTree<int> copy = tree;
+    copy.remove(5);
+    copy.insert(4);
+    EXPECT_TRUE(tree.hasValue(5));
+    EXPECT_FALSE(tree.hasValue(4));
+    EXPECT_EQ(valuesOf(copy), std::vector<int>({1, 3, 4, 7, 9}));
+
+    std::ostringstream os;
+    copy.inorderTraversal(os);
+    EXPECT_EQ(os.str(), "1 3 4 7 9 ");
+}
+
+TEST(IndexedAVLTree, EquivalentComplexKeys)
+{
+    // Complex orders by magnitude, so 3+4i and 5 are equivalent but not equal
+    IndexedAVLTree<Complex> tree;
+    tree.insert(Complex(3, 4));
+    tree.insert(Complex(5, 0));
+    tree.insert(Complex(1, 0));
+    EXPECT_EQ(tree.size(), 2u);
+    EXPECT_TRUE(tree.hasValue(Complex(3, 4)));
+    EXPECT_FALSE(tree.hasValue(Complex(5, 0)));
+    EXPECT_EQ(tree.search(Complex(5, 0)), nullptr);
+    tree.remove(Complex(0, 5));
+    EXPECT_EQ(tree.size(), 1u);
+    EXPECT_TRUE(tree.hasValue(Complex(1, 0)));
+}
@@ -0,0 +1,50 @@
+#include "../inc/AVLTree.hpp"
+#include "../inc/indexedAVLTree.hpp"
+#include "benchmarkUtils.hpp"
+#include <fstream>
+#include <vector>
+#include <random>
+#include <iostream>
+#include <iomanip>
+
+// Pointer AVLTree against the struct-of-arrays IndexedAVLTree on random int keys
+static void indexed_performance_test(const std::string &filename, size_t max_size, size_t step, size_t queries)
+{
+    std::ofstream ofs;
+    if (!open_results_file(ofs, filename))
+        return;
+
+    ofs << "size,pointer_insert,indexed_insert,pointer_search,indexed_search,pointer_iterate,indexed_iterate,"
+           "pointer_copy,indexed_copy,pointer_remove,indexed_remove\n";
+    std::mt19937 rng(42);
+
+    for (size_t n = step; n <= max_size; n += step)
+    {
+        std::vector<int> data, probes;
+        random_workload(rng, n, queries, data, probes);
+
+        BackendTimes pointer = measure_backend<AVLTree<int>>(data, probes);
+        BackendTimes indexed = measure_backend<IndexedAVLTree<int>>(data, probes);
+
+        ofs << n << "," << std::fixed << std::setprecision(6)
+            << pointer.insert << "," << indexed.insert << ","
+            << pointer.search << "," << indexed.search << ","
+            << pointer.iterate << "," << indexed.iterate << ","
+            << pointer.copy << "," << indexed.copy << ","
+            << pointer.remove << "," << indexed.remove << "\n";
+        std::cout << "Size: " << n
+                  << ", insert: " << pointer.insert << "s / " << indexed.insert << "s"
+                  << ", search: " << pointer.search << "s / " << indexed.search << "s"
+                  << ", iterate: " << pointer.iterate << "s / " << indexed.iterate << "s"
+                  << ", copy: " << pointer.copy << "s / " << indexed.copy << "s"
+                  << ", remove: " << pointer.remove << "s / " << indexed.remove << "s" << std::endl;
+    }
+    ofs.close();
+    std::cout << "Data successfully written to: tests/" << filename << std::endl;
+}
+
+int main()
+{
+    indexed_performance_test("indexed_avl_performance.csv", 5000000, 1000000, 2000000);
+    return 0;
+}
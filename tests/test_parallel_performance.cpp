@@ -0,0 +1,142 @@
+#include "../inc/AVLTree.hpp"
+#include "../types/complex.hpp"
+#include <chrono>
+#include <fstream>
+#include <vector>
+#include <random>
+#include <iostream>
+#include <iomanip>
+#include <thread>
+
+// Union, intersection and in-place merge of two random AVL trees of n keys each,
+// timed for 1..max_threads worker threads
+static void parallel_set_ops_test(const std::string &filename, size_t n, unsigned max_threads)
+{
+    std::ofstream ofs("../tests/" + filename);
+    if (!ofs.is_open())
+    {
+        std::cerr << "Failed to open file: tests/" << filename << std::endl;
+        return;
+    }
+    std::cout << "File opened successfully: tests/" << filename << std::endl;
+
+    ofs << "threads,size,union,intersect,merge\n";
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> dist(1, 2 * static_cast<int>(n));
+    std::vector<int> a(n), b(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        a[i] = dist(rng);
+        b[i] = dist(rng);
+    }
+    AVLTree<int> left(a.begin(), a.end());
+    AVLTree<int> right(b.begin(), b.end());
+
+    for (unsigned threads = 1; threads <= max_threads; ++threads)
+    {
+        auto t1 = std::chrono::high_resolution_clock::now();
+        AVLTree<int> joined = left.unionWith(right, threads);
+        auto t2 = std::chrono::high_resolution_clock::now();
+        double union_time = std::chrono::duration<double>(t2 - t1).count();
+
+        t1 = std::chrono::high_resolution_clock::now();
+        AVLTree<int> common = left.intersect(right, threads);
+        t2 = std::chrono::high_resolution_clock::now();
+        double intersect_time = std::chrono::duration<double>(t2 - t1).count();
+
+        AVLTree<int> target(left);
+        t1 = std::chrono::high_resolution_clock::now();
+        target.merge(right, threads);
+        t2 = std::chrono::high_resolution_clock::now();
+        double merge_time = std::chrono::duration<double>(t2 - t1).count();
+
+        ofs << threads << "," << n << "," << std::fixed << std::setprecision(6)
+            << union_time << "," << intersect_time << "," << merge_time << "\n";
+        std::cout << "Threads: " << threads
+                  << ", union: " << union_time << "s"
+                  << ", intersect: " << intersect_time << "s"
+                  << ", merge: " << merge_time << "s" << std::endl;
+    }
+    ofs.close();
+    std::cout << "Data successfully written to: tests/" << filename << std::endl;
+}
+
+// Stands in for a costly user lambda: a few hundred steps of z = z * z / |z| + c
+static Complex expensive(const Complex &c)
+{
+    Complex z = c;
+    for (int i = 0; i < 200; ++i)
+    {
+        double m = z.magnitude();
+        z = (m > 0 ? z * Complex(1.0 / m, 0) * z : z) + c;
+    }
+    return z;
+}
+
+// apply, where and reduce over a random tree of n Complex values with an expensive
+// lambda, timed for 1..max_threads threads. apply_by_insert is the old apply, which
+// inserted the mapped values one by one in preorder.
+static void parallel_functional_test(const std::string &filename, size_t n, unsigned max_threads)
+{
+    std::ofstream ofs("../tests/" + filename);
+    if (!ofs.is_open())
+    {
+        std::cerr << "Failed to open file: tests/" << filename << std::endl;
+        return;
+    }
+    std::cout << "File opened successfully: tests/" << filename << std::endl;
+
+    ofs << "threads,size,apply_by_insert,apply,where,reduce\n";
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> dist(-1000.0, 1000.0);
+    BinaryTree<Complex> tree;
+    for (size_t i = 0; i < n; ++i)
+        tree.insert(Complex(dist(rng), dist(rng)));
+
+    auto t1 = std::chrono::high_resolution_clock::now();
+    BinaryTree<Complex> inserted;
+    for (auto it = tree.cbegin("preorder"); it != tree.cend("preorder"); ++it)
+        inserted.insert(expensive(*it));
+    auto t2 = std::chrono::high_resolution_clock::now();
+    double insert_time = std::chrono::duration<double>(t2 - t1).count();
+
+    for (unsigned threads = 1; threads <= max_threads; ++threads)
+    {
+        t1 = std::chrono::high_resolution_clock::now();
+        BinaryTree<Complex> mapped = tree.apply(expensive, threads);
+        t2 = std::chrono::high_resolution_clock::now();
+        double apply_time = std::chrono::duration<double>(t2 - t1).count();
+
+        t1 = std::chrono::high_resolution_clock::now();
+        BinaryTree<Complex> kept = tree.where([](Complex c)
+                                              { return expensive(c).getReal() > 0; }, threads);
+        t2 = std::chrono::high_resolution_clock::now();
+        double where_time = std::chrono::duration<double>(t2 - t1).count();
+
+        t1 = std::chrono::high_resolution_clock::now();
+        Complex total = tree.reduce([](Complex a, Complex b)
+                                    { return a + b; }, Complex(), threads);
+        t2 = std::chrono::high_resolution_clock::now();
+        double reduce_time = std::chrono::duration<double>(t2 - t1).count();
+        if (mapped.isEmpty() || kept.isEmpty() || std::isnan(total.getReal()))
+            std::cerr << "Unexpected result" << std::endl;
+
+        ofs << threads << "," << n << "," << std::fixed << std::setprecision(6)
+            << insert_time << "," << apply_time << "," << where_time << "," << reduce_time << "\n";
+        std::cout << "Threads: " << threads
+                  << ", apply by insert: " << insert_time << "s"
+                  << ", apply: " << apply_time << "s"
+                  << ", where: " << where_time << "s"
+                  << ", reduce: " << reduce_time << "s" << std::endl;
+    }
+    ofs.close();
+    std::cout << "Data successfully written to: tests/" << filename << std::endl;
+}
+
+int main()
+{
+    unsigned max_threads = std::max(8u, std::thread::hardware_concurrency());
+    parallel_set_ops_test("parallel_set_ops_performance.csv", 10000000, max_threads);
+    parallel_functional_test("parallel_functional_performance.csv", 1000000, max_threads);
+    return 0;
+}
@@ -7,6 +7,26 @@
 #include <iostream>
 #include <unistd.h>
 #include <limits.h>
+#include <malloc.h>
+
+template <typename Tree>
+static double time_inserts(Tree &tree, const std::vector<int> &data)
+{
+    auto t1 = std::chrono::high_resolution_clock::now();
+    for (int x : data)
+        tree.insert(x);
+    auto t2 = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double>(t2 - t1).count();
+}
+
+template <typename Tree>
+static double time_clear(Tree &tree)
+{
+    auto t1 = std::chrono::high_resolution_clock::now();
+    tree.clear();
+    auto t2 = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double>(t2 - t1).count();
+}
 
 static void performance_test_big(const std::string &filename, size_t max_size, size_t step)
 {
@@ -28,7 +48,8 @@ static void performance_test_big(const std::string &filename, size_t max_size, s
     }
     std::cout << "File opened successfully: tests/" << filename << std::endl;
 
-    ofs << "size,binarytree_insert,avltree_insert\n";
+    ofs << "size,binarytree_insert,avltree_insert,binarytree_pool_insert,avltree_pool_insert,"
+           "avltree_clear,avltree_pool_clear\n";
     std::mt19937 rng(42);
     std::uniform_int_distribution<int> dist(1, 1e9);
 
@@ -40,28 +61,97 @@ static void performance_test_big(const std::string &filename, size_t max_size, s
 
         BinaryTree<int> bt;
         AVLTree<int> avl;
+        BinaryTree<int, PoolNodeAllocator<int>> bt_pool;
+        AVLTree<int, PoolNodeAllocator<int>> avl_pool;
+
+        double bt_time = time_inserts(bt, data);
+        bt.clear();
+        double avl_time = time_inserts(avl, data);
+        double avl_clear = time_clear(avl);
+
+        double bt_pool_time = time_inserts(bt_pool, data);
+        bt_pool.clear();
+        double avl_pool_time = time_inserts(avl_pool, data);
+        double avl_pool_clear = time_clear(avl_pool);
+
+        ofs << n << "," << bt_time << "," << avl_time << "," << bt_pool_time << "," << avl_pool_time << ","
+            << avl_clear << "," << avl_pool_clear << "\n";
+        std::cout << "Processed size: " << n << " (AVL insert " << avl_time << "s, pool " << avl_pool_time
+                  << "s; clear " << avl_clear << "s, pool " << avl_pool_clear << "s)" << std::endl;
+    }
+    ofs.close();
+    std::cout << "Data successfully written to: tests/" << filename << std::endl;
+}
+
+// Heap bytes currently handed out; glibc only, 0 elsewhere
+static size_t heap_in_use()
+{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+#else
+    return 0;
+#endif
+}
+
+// TreeNode as it was laid out before the thread flags moved into the link bits
+template <typename T>
+struct PreviousTreeNode
+{
+    T data;
+    TreeNode<T> *left;
+    TreeNode<T> *right;
+    bool isLeftThread;
+    bool isRightThread;
+    int height;
+    size_t size;
+};
 
-        auto t1 = std::chrono::high_resolution_clock::now();
-        for (int x : data)
-            bt.insert(x);
-        auto t2 = std::chrono::high_resolution_clock::now();
-        double bt_time = std::chrono::duration<double>(t2 - t1).count();
+template <typename Tree, typename T>
+static void memory_footprint_row(std::ofstream &ofs, const std::string &name, const std::vector<T> &data)
+{
+    size_t before = heap_in_use();
+    double per_node;
+    {
+        Tree tree(data.begin(), data.end());
+        per_node = static_cast<double>(heap_in_use() - before) / data.size();
+    }
+    ofs << name << "," << sizeof(TreeNode<T>) << "," << sizeof(PreviousTreeNode<T>) << "," << per_node << "\n";
+    std::cout << name << ": node " << sizeof(TreeNode<T>) << " bytes (was " << sizeof(PreviousTreeNode<T>)
+              << "), " << per_node << " heap bytes per node" << std::endl;
+}
 
-        t1 = std::chrono::high_resolution_clock::now();
-        for (int x : data)
-            avl.insert(x);
-        t2 = std::chrono::high_resolution_clock::now();
-        double avl_time = std::chrono::duration<double>(t2 - t1).count();
+// Size of one node and the heap actually used per node of an n-key AVL tree, with
+// the default heap allocator (which adds malloc's own header) and with the pool
+static void memory_footprint_report(const std::string &filename, size_t n)
+{
+    std::ofstream ofs("../tests/" + filename);
+    if (!ofs.is_open())
+    {
+        std::cerr << "Failed to open file: tests/" << filename << std::endl;
+        return;
+    }
+    std::cout << "File opened successfully: tests/" << filename << std::endl;
 
-        ofs << n << "," << bt_time << "," << avl_time << "\n";
-        std::cout << "Processed size: " << n << std::endl;
+    ofs << "tree,node_bytes,previous_node_bytes,heap_bytes_per_node\n";
+    std::vector<int> ints(n);
+    std::vector<double> doubles(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        ints[i] = static_cast<int>(i);
+        doubles[i] = static_cast<double>(i);
     }
+    memory_footprint_row<AVLTree<int>>(ofs, "avltree_int_heap", ints);
+    memory_footprint_row<AVLTree<int, PoolNodeAllocator<int>>>(ofs, "avltree_int_pool", ints);
+    memory_footprint_row<AVLTree<double>>(ofs, "avltree_double_heap", doubles);
+    memory_footprint_row<AVLTree<double, PoolNodeAllocator<double>>>(ofs, "avltree_double_pool", doubles);
     ofs.close();
     std::cout << "Data successfully written to: tests/" << filename << std::endl;
 }
 
 int main()
 {
+    memory_footprint_report("memory_footprint.csv", 1000000);
     performance_test_big("performance_very_large.csv", 10000000, 1000000);
     return 0;
 }
@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+#include "../inc/persistentAVLTree.hpp"
+#include "../inc/AVLTree.hpp"
+#include "../types/complex.hpp"
+#include "testUtils.hpp"
+#include <atomic>
+#include <cmath>
+#include <random>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+TEST(PersistentAVLTree, EmptyTree)
+{
+    PersistentAVLTree<int> tree;
+    EXPECT_TRUE(tree.isEmpty());
+    EXPECT_EQ(tree.size(), 0u);
+    EXPECT_FALSE(tree.hasValue(1));
+    EXPECT_TRUE(tree.cbegin() == tree.cend());
+    EXPECT_THROW(tree.getMin(), std::runtime_error);
+    EXPECT_THROW(tree.getHeight(), std::runtime_error);
+    EXPECT_TRUE(tree.remove(1).sharesRootWith(tree));
+}
+
+TEST(PersistentAVLTree, EveryVersionKeepsItsKeys)
+{
+    // Each step derives a new version; all earlier versions must still match the set
+    // they were made from
+    std::mt19937 rng(17);
+    std::uniform_int_distribution<int> dist(0, 500);
+    std::vector<PersistentAVLTree<int>> versions(1);
+    std::vector<std::set<int>> references(1);
+
+    for (int round = 0; round < 3000; ++round)
+    {
+        int x = dist(rng);
+        std::set<int> reference = references.back();
+        if (rng() % 3 == 0)
+        {
+            versions.push_back(versions.back().remove(x));
+            reference.erase(x);
+        }
+        else
+        {
+            versions.push_back(versions.back().insert(x));
+            reference.insert(x);
+        }
+        references.push_back(reference);
+    }
+
+    for (size_t i = 0; i < versions.size(); i += 97)
+    {
+        ASSERT_EQ(versions[i].size(), references[i].size());
+        EXPECT_EQ(valuesOf(versions[i]), std::vector<int>(references[i].begin(), references[i].end()));
+    }
+    const PersistentAVLTree<int> &last = versions.back();
+    const std::set<int> &reference = references.back();
+    EXPECT_LE(last.getHeight(), 1.45 * std::log2(reference.size() + 2));
+    EXPECT_EQ(last.getMin(), *reference.begin());
+    EXPECT_EQ(last.getMax(), *reference.rbegin());
+    for (int x = -1; x <= 501; ++x)
+        EXPECT_EQ(last.hasValue(x), reference.count(x) == 1);
+}
+
+TEST(PersistentAVLTree, HeightMatchesPointerTree)
+{
+    std::mt19937 rng(23);
+    std::uniform_int_distribution<int> dist(0, 3000);
+    PersistentAVLTree<int> tree;
+    AVLTree<int> pointerTree;
+
+    EXPECT_EQ(tree.insert(1).getHeight(), 0);
+    for (int round = 0; round < 20000; ++round)
+    {
+        int x = dist(rng);
+        if (rng() % 3 == 0)
+        {
+            tree = tree.remove(x);
+            pointerTree.remove(x);
+        }
+        else
+        {
+            tree = tree.insert(x);
+            pointerTree.insert(x);
+        }
+    }
+
+    ASSERT_FALSE(tree.isEmpty());
+    EXPECT_EQ(tree.getHeight(), pointerTree.getRoot()->getHeight());
+}
+
+TEST(PersistentAVLTree, UnchangedVersionsShareTheirRoot)
+{
+    std::vector<int> values = {5, 3, 9, 3, 1, 7, 5};
+    PersistentAVLTree<int> tree(values.begin(), values.end());
+    EXPECT_EQ(valuesOf(tree), std::vector<int>({1, 3, 5, 7, 9}));
+
+    PersistentAVLTree<int> copy = tree;
+    EXPECT_TRUE(copy.sharesRootWith(tree));
+    EXPECT_TRUE(tree.insert(7).sharesRootWith(tree));
+    EXPECT_TRUE(tree.remove(4).sharesRootWith(tree));
+
+    PersistentAVLTree<int> changed = tree.remove(5).insert(4);
+    EXPECT_FALSE(changed.sharesRootWith(tree));
+    EXPECT_EQ(valuesOf(tree), std::vector<int>({1, 3, 5, 7, 9}));
+    EXPECT_EQ(valuesOf(changed), std::vector<int>({1, 3, 4, 7, 9}));
+
+    std::ostringstream os;
+    changed.inorderTraversal(os);
+    EXPECT_EQ(os.str(), "1 3 4 7 9 ");
+}
+
+TEST(PersistentAVLTree, IteratorOutlivesItsTree)
+{
+    PersistentAVLTree<int>::ConstIterator it = PersistentAVLTree<int>().cend();
+    {
+        PersistentAVLTree<int> tree;
+        for (int x = 0; x < 100; ++x)
+            tree = tree.insert(x);
+        it = tree.cbegin();
+    }
+    int expected = 0;
+    for (int i = 0; i < 100; ++i, ++it)
+        EXPECT_EQ(*it, expected++);
+}
+
+TEST(PersistentAVLTree, EquivalentComplexKeys)
+{
+    // Complex orders by magnitude, so 3+4i and 5 are equivalent but not equal
+    PersistentAVLTree<Complex> tree = PersistentAVLTree<Complex>().insert(Complex(3, 4)).insert(Complex(5, 0)).insert(Complex(1, 0));
+    EXPECT_EQ(tree.size(), 2u);
+    EXPECT_TRUE(tree.hasValue(Complex(3, 4)));
+    EXPECT_FALSE(tree.hasValue(Complex(5, 0)));
+    EXPECT_EQ(tree.search(Complex(5, 0)), nullptr);
+    PersistentAVLTree<Complex> smaller = tree.remove(Complex(0, 5));
+    EXPECT_EQ(smaller.size(), 1u);
+    EXPECT_EQ(tree.size(), 2u);
+}
+
+TEST(PersistentAVLTree, ReadersUseSnapshotsWhileWriterPublishes)
+{
+    // The writer publishes versions that always hold 0..limit-1 plus a churning key
+    // above them; readers take snapshots and check them without any lock
+    const int limit = 1000;
+    PersistentAVLTree<int> initial;
+    for (int x = 0; x < limit; ++x)
+        initial = initial.insert(x);
+    PersistentAVLTree<int> current = initial;
+
+    std::atomic<bool> stop(false);
+    std::atomic<int> failures(0);
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r)
+    {
+        readers.emplace_back([&]()
+                             {
+                                 while (!stop.load())
+                                 {
+                                     PersistentAVLTree<int> snapshot = PersistentAVLTree<int>::atomicLoad(&current);
+                                     size_t size = snapshot.size();
+                                     if ((size != static_cast<size_t>(limit) && size != static_cast<size_t>(limit) + 1) ||
+                                         !snapshot.hasValue(limit / 2) || snapshot.getMin() != 0)
+                                         failures.fetch_add(1);
+                                     size_t walked = 0;
+                                     for (auto it = snapshot.cbegin(); it != snapshot.cend(); ++it)
+                                         ++walked;
+                                     if (walked != size)
+                                         failures.fetch_add(1);
+                                 } });
+    }
+
+    PersistentAVLTree<int> version = initial;
+    for (int round = 0; round < 20000; ++round)
+    {
+        int extra = limit + round % 50;
+        version = version.insert(extra);
+        PersistentAVLTree<int>::atomicStore(&current, version);
+        version = version.remove(extra);
+        PersistentAVLTree<int>::atomicStore(&current, version);
+    }
+    stop.store(true);
+    for (std::thread &reader : readers)
+        reader.join();
+
+    EXPECT_EQ(failures.load(), 0);
+    EXPECT_EQ(valuesOf(current), valuesOf(initial));
+}
@@ -0,0 +1,84 @@
+#include "../inc/AVLTree.hpp"
+#include "../inc/persistentAVLTree.hpp"
+#include <chrono>
+#include <fstream>
+#include <vector>
+#include <random>
+#include <iostream>
+#include <iomanip>
+
+// Building an n-key tree by repeated insert, then `updates` immutable updates that
+// each keep the old tree: a copy plus an insert for AVLTree, an insert returning a new
+// version for PersistentAVLTree. Update times are per update.
+static void persistent_performance_test(const std::string &filename, const std::vector<size_t> &sizes, size_t updates)
+{
+    std::ofstream ofs("../tests/" + filename);
+    if (!ofs.is_open())
+    {
+        std::cerr << "Failed to open file: tests/" << filename << std::endl;
+        return;
+    }
+    std::cout << "File opened successfully: tests/" << filename << std::endl;
+
+    ofs << "size,avltree_build,persistent_build,avltree_update,persistent_update\n";
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> dist(1, 2e9);
+
+    for (size_t n : sizes)
+    {
+        std::vector<int> data(n);
+        for (size_t i = 0; i < n; ++i)
+            data[i] = dist(rng);
+
+        auto t1 = std::chrono::high_resolution_clock::now();
+        AVLTree<int> avl;
+        for (int x : data)
+            avl.insert(x);
+        auto t2 = std::chrono::high_resolution_clock::now();
+        double avl_build = std::chrono::duration<double>(t2 - t1).count();
+
+        t1 = std::chrono::high_resolution_clock::now();
+        PersistentAVLTree<int> persistent;
+        for (int x : data)
+            persistent = persistent.insert(x);
+        t2 = std::chrono::high_resolution_clock::now();
+        double persistent_build = std::chrono::duration<double>(t2 - t1).count();
+
+        size_t avl_updates = std::max<size_t>(1, std::min(updates, 20000000 / n));
+        size_t kept = 0;
+        t1 = std::chrono::high_resolution_clock::now();
+        for (size_t i = 0; i < avl_updates; ++i)
+        {
+            AVLTree<int> next(avl);
+            next.insert(-static_cast<int>(i) - 1);
+            kept += next.hasValue(-static_cast<int>(i) - 1) ? 1 : 0;
+        }
+        t2 = std::chrono::high_resolution_clock::now();
+        double avl_update = std::chrono::duration<double>(t2 - t1).count() / avl_updates;
+
+        t1 = std::chrono::high_resolution_clock::now();
+        for (size_t i = 0; i < updates; ++i)
+        {
+            PersistentAVLTree<int> next = persistent.insert(-static_cast<int>(i) - 1);
+            kept += next.hasValue(-static_cast<int>(i) - 1) ? 1 : 0;
+        }
+        t2 = std::chrono::high_resolution_clock::now();
+        double persistent_update = std::chrono::duration<double>(t2 - t1).count() / updates;
+        if (kept != avl_updates + updates)
+            std::cerr << "Update lost a key" << std::endl;
+
+        ofs << n << "," << std::scientific << std::setprecision(6)
+            << avl_build << "," << persistent_build << "," << avl_update << "," << persistent_update << "\n";
+        std::cout << "Size: " << n
+                  << ", build: " << avl_build << "s / " << persistent_build << "s"
+                  << ", update: " << avl_update << "s / " << persistent_update << "s" << std::endl;
+    }
+    ofs.close();
+    std::cout << "Data successfully written to: tests/" << filename << std::endl;
+}
+
+int main()
+{
+    persistent_performance_test("persistent_performance.csv", {1000, 10000, 100000, 1000000}, 10000);
+    return 0;
+}
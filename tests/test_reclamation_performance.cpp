@@ -0,0 +1,206 @@
+#include "../inc/epochReclaimer.hpp"
+#include "benchmarkUtils.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct Node
+{
+    int value;
+
+    explicit Node(int value) : value(value) {}
+};
+
+// Read side as ConcurrentAVLTree had it before: one counter all readers share, with
+// frees only at a moment when it is zero
+struct SharedCounter
+{
+    std::atomic<size_t> readers;
+    std::vector<Node *> retired;
+
+    SharedCounter() : readers(0) {}
+    ~SharedCounter()
+    {
+        for (Node *node : retired)
+            delete node;
+    }
+
+    struct Guard
+    {
+        SharedCounter &owner;
+
+        explicit Guard(SharedCounter &owner) : owner(owner)
+        {
+            owner.readers.fetch_add(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+        ~Guard() { owner.readers.fetch_sub(1, std::memory_order_release); }
+    };
+
+    void retire(Node *node)
+    {
+        retired.push_back(node);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (readers.load(std::memory_order_acquire) != 0)
+            return;
+        for (Node *old : retired)
+            delete old;
+        retired.clear();
+    }
+    size_t pending() const { return retired.size(); }
+};
+
+struct Epoch
+{
+    EpochReclaimer<Node> reclaimer;
+
+    struct Guard
+    {
+        EpochReclaimer<Node>::Guard guard;
+
+        explicit Guard(Epoch &owner) : guard(owner.reclaimer) {}
+    };
+
+    void retire(Node *node) { reclaimer.retire(node); }
+    size_t pending() const { return reclaimer.pending(); }
+};
+
+// Unprotected reads, to show what a guard adds; nothing is retired in this mode
+struct NoGuard
+{
+    struct Guard
+    {
+        explicit Guard(NoGuard &) {}
+    };
+
+    void retire(Node *node) { delete node; }
+    size_t pending() const { return 0; }
+};
+
+struct Result
+{
+    double readNs;   // per guarded read, over all reader threads
+    double retireNs; // per retire, frees included
+    size_t maxPending;
+};
+
+// `readers` threads read a published node under a guard while one writer replaces it
+// and retires the old one `retires` times. A guard covers `reads_per_guard` reads.
+template <typename Scheme>
+static Result measure(unsigned readers, size_t retires, int reads_per_guard, bool write)
+{
+    Scheme scheme;
+    std::atomic<Node *> published(new Node(0));
+    std::atomic<bool> start(false), stop(false);
+    std::vector<unsigned long long> reads(readers, 0);
+    std::atomic<long long> sink(0);
+    std::vector<std::thread> threads;
+    for (unsigned r = 0; r < readers; ++r)
+    {
+        threads.emplace_back([&, r]()
+                             {
+                                 unsigned long long done = 0;
+                                 long long sum = 0;
+                                 while (!start.load())
+                                     std::this_thread::yield();
+                                 while (!stop.load(std::memory_order_relaxed))
+                                 {
+                                     typename Scheme::Guard guard(scheme);
+                                     for (int i = 0; i < reads_per_guard; ++i)
+                                         sum += published.load(std::memory_order_acquire)->value;
+                                     done += reads_per_guard;
+                                 }
+                                 reads[r] = done;
+                                 sink.fetch_add(sum); });
+    }
+
+    size_t maxPending = 0;
+    auto t1 = std::chrono::high_resolution_clock::now();
+    start.store(true);
+    if (write)
+    {
+        for (size_t i = 0; i < retires; ++i)
+        {
+            Node *old = published.exchange(new Node(static_cast<int>(i)), std::memory_order_acq_rel);
+            scheme.retire(old);
+            maxPending = std::max(maxPending, scheme.pending());
+        }
+    }
+    else
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    }
+    auto t2 = std::chrono::high_resolution_clock::now();
+    stop.store(true);
+    for (std::thread &thread : threads)
+        thread.join();
+    delete published.load();
+
+    double elapsed = std::chrono::duration<double>(t2 - t1).count();
+    unsigned long long total = 0;
+    for (unsigned long long n : reads)
+        total += n;
+    Result result;
+    result.readNs = total ? elapsed * 1e9 * readers / total : 0;
+    result.retireNs = write ? elapsed * 1e9 / retires : 0;
+    result.maxPending = maxPending;
+    return result;
+}
+
+// Read-side cost of each scheme with no writer, then the writer's cost per retire and
+// the most nodes waiting to be freed while readers keep overlapping
+static void reclamation_performance_test(const std::string &filename, const std::vector<int> &thread_counts, size_t retires)
+{
+    std::ofstream ofs;
+    if (!open_results_file(ofs, filename))
+        return;
+
+    ofs << "threads,plain_read_ns,counter_read_ns,epoch_read_ns,"
+           "delete_retire_ns,counter_retire_ns,epoch_retire_ns,counter_max_pending,epoch_max_pending\n";
+    for (int threads : thread_counts)
+    {
+        Result plain = measure<NoGuard>(threads, retires, 1, false);
+        Result counter = measure<SharedCounter>(threads, retires, 1, false);
+        Result epoch = measure<Epoch>(threads, retires, 1, false);
+        // Unprotected frees with no readers, as the floor for the writer
+        Result deleted = measure<NoGuard>(0, retires, 1, true);
+        Result counterWrite = measure<SharedCounter>(threads, retires, 16, true);
+        Result epochWrite = measure<Epoch>(threads, retires, 16, true);
+
+        ofs << threads << "," << std::fixed << std::setprecision(2)
+            << plain.readNs << "," << counter.readNs << "," << epoch.readNs << ","
+            << deleted.retireNs << "," << counterWrite.retireNs << "," << epochWrite.retireNs << ","
+            << counterWrite.maxPending << "," << epochWrite.maxPending << "\n";
+        std::cout << "Readers: " << threads
+                  << ", read ns plain/counter/epoch: " << plain.readNs << " / " << counter.readNs << " / " << epoch.readNs
+                  << ", retire ns delete/counter/epoch: " << deleted.retireNs << " / " << counterWrite.retireNs
+                  << " / " << epochWrite.retireNs
+                  << ", max pending counter/epoch: " << counterWrite.maxPending << " / " << epochWrite.maxPending << std::endl;
+    }
+    ofs.close();
+    std::cout << "Data successfully written to: tests/" << filename << std::endl;
+}
+
+// Usage: test_reclamation_performance [threads=1,2,4,8] [retires=1000000]
+int main(int argc, char **argv)
+{
+    std::vector<int> thread_counts = {1, 2, 4, 8};
+    size_t retires = 1000000;
+    bool parsed = parse_arguments(argc, argv,
+                                  {{"threads", [&](const std::string &value)
+                                    { thread_counts = parse_list(value); }},
+                                   {"retires", [&](const std::string &value)
+                                    { retires = std::strtoull(value.c_str(), nullptr, 10); }}});
+    if (!parsed)
+        return 1;
+
+    reclamation_performance_test("reclamation_performance.csv", thread_counts, retires);
+    return 0;
+}
@@ -0,0 +1,237 @@
+#include <gtest/gtest.h>
+#include "../inc/redBlackTree.hpp"
+#include "../inc/WAVLTree.hpp"
+#include "../inc/AVLTree.hpp"
+#include "../types/complex.hpp"
+#include "testUtils.hpp"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <set>
+#include <sstream>
+#include <vector>
+
+// Rank of a WAVL subtree recovered from the parity bits, or -100 when the children
+// disagree about it (which also rejects a rank difference of 0 or 3 and 2,2 leaves)
+static int wavlRank(const TreeNode<int> *node)
+{
+    if (!node)
+        return -1;
+    int left = wavlRank(node->getLeft());
+    int right = wavlRank(node->getRight());
+    if (left == -100 || right == -100)
+        return -100;
+    auto parity = [](const TreeNode<int> *n)
+    { return !n || n->getBalanceBit(); };
+    int fromLeft = left + (parity(node->getLeft()) != node->getBalanceBit() ? 1 : 2);
+    int fromRight = right + (parity(node->getRight()) != node->getBalanceBit() ? 1 : 2);
+    return fromLeft == fromRight ? fromLeft : -100;
+}
+
+template <typename Tree>
+static void checkSize(const Tree &tree, size_t expected)
+{
+    ASSERT_EQ(tree.getRoot() ? tree.getRoot()->getSize() : 0, expected);
+}
+
+TEST(RedBlackTree, MatchesStdSetUnderRandomUpdates)
+{
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<int> dist(0, 2000);
+    RedBlackTree<int> tree;
+    std::set<int> reference;
+    for (int round = 0; round < 20000; ++round)
+    {
+        int x = dist(rng);
+        if (rng() % 3 == 0)
+        {
+            tree.remove(x);
+            reference.erase(x);
+        }
+        else
+        {
+            tree.insert(x);
+            reference.insert(x);
+        }
+        if (round % 500 == 0)
+        {
+            ASSERT_TRUE(tree.isBalanced()) << "after round " << round;
+            ASSERT_NE(checkedHeight(tree.getRoot()), -100) << "after round " << round;
+        }
+    }
+    EXPECT_TRUE(tree.isBalanced());
+    EXPECT_EQ(valuesOf(tree), std::vector<int>(reference.begin(), reference.end()));
+    checkSize(tree, reference.size());
+    EXPECT_LE(tree.getHeight(), 2 * std::log2(reference.size() + 1));
+
+    for (int x : std::vector<int>(reference.begin(), reference.end()))
+    {
+        tree.remove(x);
+        ASSERT_TRUE(tree.isBalanced());
+    }
+    EXPECT_TRUE(tree.isEmpty());
+}
+
+TEST(RedBlackTree, SortedInsertsStayShallow)
+{
+    RedBlackTree<int, PoolNodeAllocator<int>> ascending;
+    RedBlackTree<int> descending;
+    for (int i = 0; i < 4096; ++i)
+    {
+        ascending.insert(i);
+        descending.insert(4095 - i);
+    }
+    EXPECT_TRUE(ascending.isBalanced());
+    EXPECT_TRUE(descending.isBalanced());
+    EXPECT_LE(ascending.getHeight(), 2 * 12);
+    EXPECT_LE(descending.getHeight(), 2 * 12);
+    checkSize(ascending, 4096);
+    ascending.insert(17);
+    checkSize(ascending, 4096);
+}
+
+TEST(RedBlackTree, CopyBalanceAndMergeKeepColours)
+{
+    RedBlackTree<int> tree;
+    for (int i = 0; i < 100; i += 2)
+        tree.insert(i);
+    RedBlackTree<int> copy(tree);
+    EXPECT_TRUE(copy.isBalanced());
+    copy.remove(10);
+    EXPECT_TRUE(tree.hasValue(10));
+    EXPECT_TRUE(copy.isBalanced());
+
+    tree.balance();
+    EXPECT_TRUE(tree.isBalanced());
+    RedBlackTree<int> odd;
+    for (int i = 1; i < 60; i += 2)
+        odd.insert(i);
+    tree.merge(odd);
+    EXPECT_TRUE(tree.isBalanced());
+    checkSize(tree, 80);
+    tree.insert(1000);
+    tree.remove(50);
+    EXPECT_TRUE(tree.isBalanced());
+}
+
+TEST(RedBlackTree, MoveKeepsColours)
+{
+    RedBlackTree<int> tree;
+    for (int i = 0; i < 100; ++i)
+        tree.insert(i);
+    RedBlackTree<int> moved(std::move(tree));
+    EXPECT_TRUE(tree.isEmpty());
+    moved.remove(10);
+    moved.insert(1000);
+    EXPECT_TRUE(moved.isBalanced());
+
+    RedBlackTree<int> assigned;
+    assigned = std::move(moved);
+    assigned.remove(20);
+    EXPECT_TRUE(assigned.isBalanced());
+    checkSize(assigned, 99);
+}
+
+TEST(RedBlackTree, EquivalentComplexKeys)
+{
+    RedBlackTree<Complex> tree;
+    tree.insert(Complex(3, 4));
+    tree.insert(Complex(5, 0));
+    tree.insert(Complex(1, 0));
+    checkSize(tree, 2);
+    EXPECT_TRUE(tree.hasValue(Complex(3, 4)));
+    tree.remove(Complex(0, 5));
+    EXPECT_FALSE(tree.hasValue(Complex(3, 4)));
+    EXPECT_TRUE(tree.isBalanced());
+}
+
+TEST(WAVLTree, InsertOnlyMatchesAVLShape)
+{
+    std::mt19937 rng(8);
+    WAVLTree<int> tree;
+    AVLTree<int> avl;
+    for (int i = 0; i < 5000; ++i)
+    {
+        int x = static_cast<int>(rng() % 100000);
+        tree.insert(x);
+        avl.insert(x);
+    }
+    std::ostringstream wavlOrder, avlOrder;
+    tree.preorderTraversal(wavlOrder);
+    avl.preorderTraversal(avlOrder);
+    EXPECT_EQ(wavlOrder.str(), avlOrder.str());
+    EXPECT_EQ(wavlRank(tree.getRoot()), tree.getHeight());
+    EXPECT_TRUE(tree.isBalanced());
+
+    // A leaf whose parity says rank 1 breaks the leaf rule
+    TreeNode<int> *leaf = tree.getRoot();
+    while (leaf->getLeft() || leaf->getRight())
+        leaf = leaf->getLeft() ? leaf->getLeft() : leaf->getRight();
+    leaf->setBalanceBit(!leaf->getBalanceBit());
+    EXPECT_FALSE(tree.isBalanced());
+    leaf->setBalanceBit(!leaf->getBalanceBit());
+    EXPECT_TRUE(tree.isBalanced());
+}
+
+TEST(WAVLTree, MatchesStdSetUnderRandomUpdates)
+{
+    std::mt19937 rng(9);
+    std::uniform_int_distribution<int> dist(0, 2000);
+    WAVLTree<int, PoolNodeAllocator<int>> tree;
+    std::set<int> reference;
+    for (int round = 0; round < 20000; ++round)
+    {
+        int x = dist(rng);
+        if (rng() % 3 == 0)
+        {
+            tree.remove(x);
+            reference.erase(x);
+        }
+        else
+        {
+            tree.insert(x);
+            reference.insert(x);
+        }
+        if (round % 500 == 0)
+        {
+            ASSERT_TRUE(tree.isBalanced()) << "after round " << round;
+            ASSERT_NE(wavlRank(tree.getRoot()), -100) << "after round " << round;
+            ASSERT_NE(checkedHeight(tree.getRoot()), -100) << "after round " << round;
+        }
+    }
+    EXPECT_TRUE(tree.isBalanced());
+    EXPECT_NE(wavlRank(tree.getRoot()), -100);
+    EXPECT_EQ(valuesOf(tree), std::vector<int>(reference.begin(), reference.end()));
+    checkSize(tree, reference.size());
+    EXPECT_LE(tree.getHeight(), 2 * std::log2(reference.size() + 1));
+
+    for (int x : std::vector<int>(reference.begin(), reference.end()))
+    {
+        tree.remove(x);
+        ASSERT_TRUE(tree.isBalanced());
+        ASSERT_NE(wavlRank(tree.getRoot()), -100);
+    }
+    EXPECT_TRUE(tree.isEmpty());
+}
+
+TEST(WAVLTree, BalanceAndMergeRestoreRanks)
+{
+    WAVLTree<int> tree;
+    for (int i = 0; i < 200; ++i)
+        tree.insert(i);
+    for (int i = 0; i < 200; i += 3)
+        tree.remove(i);
+    tree.balance();
+    EXPECT_EQ(wavlRank(tree.getRoot()), tree.getHeight());
+
+    WAVLTree<int> other;
+    for (int i = 500; i < 600; ++i)
+        other.insert(i);
+    tree.merge(other);
+    EXPECT_NE(wavlRank(tree.getRoot()), -100);
+    tree.remove(550);
+    tree.insert(1000);
+    EXPECT_NE(wavlRank(tree.getRoot()), -100);
+    EXPECT_TRUE(tree.isBalanced());
+    checkSize(tree, 133 + 100);
+}
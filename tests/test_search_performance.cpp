@@ -0,0 +1,242 @@
+#include "../inc/binaryTree.hpp"
+#include "../inc/AVLTree.hpp"
+#include <chrono>
+#include <fstream>
+#include <vector>
+#include <random>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+
+// Time spent answering `queries` hasValue calls, half of them hits and half misses
+template <typename Tree>
+static double measure_lookups(const Tree &tree, const std::vector<int> &keys, size_t queries, std::mt19937 &rng)
+{
+    std::uniform_int_distribution<size_t> pick(0, keys.size() - 1);
+    std::vector<int> probes(queries);
+    for (size_t i = 0; i < queries; ++i)
+        probes[i] = (i % 2 == 0) ? keys[pick(rng)] : -static_cast<int>(i) - 1;
+
+    size_t found = 0;
+    auto t1 = std::chrono::high_resolution_clock::now();
+    for (int x : probes)
+        found += tree.hasValue(x) ? 1 : 0;
+    auto t2 = std::chrono::high_resolution_clock::now();
+
+    if (found < queries / 2)
+    {
+        std::cerr << "Lookup mismatch: " << found << " hits of " << queries / 2 << std::endl;
+    }
+    return std::chrono::duration<double>(t2 - t1).count();
+}
+
+static void search_performance_test(const std::string &filename, bool sorted, size_t max_size, size_t step,
+                                    size_t queries, size_t binarytree_limit)
+{
+    std::ofstream ofs("../tests/" + filename);
+    if (!ofs.is_open())
+    {
+        std::cerr << "Failed to open file: tests/" << filename << std::endl;
+        return;
+    }
+    std::cout << "File opened successfully: tests/" << filename << std::endl;
+
+    ofs << "size,binarytree_search,avltree_search\n";
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> dist(1, 1e9);
+
+    for (size_t n = step; n <= max_size; n += step)
+    {
+        std::vector<int> data(n);
+        for (size_t i = 0; i < n; ++i)
+            data[i] = sorted ? static_cast<int>(i) : dist(rng);
+
+        AVLTree<int> avl;
+        for (int x : data)
+            avl.insert(x);
+        double avl_time = measure_lookups(avl, data, queries, rng);
+
+        // A sorted BinaryTree degenerates into a list, keep it to sizes that finish
+        double bt_time = -1;
+        if (n <= binarytree_limit)
+        {
+            BinaryTree<int> bt;
+            for (int x : data)
+                bt.insert(x);
+            bt_time = measure_lookups(bt, data, queries, rng);
+        }
+
+        ofs << n << "," << std::fixed << std::setprecision(6) << bt_time << "," << avl_time << "\n";
+        std::cout << "Size: " << n
+                  << ", BT search: " << (bt_time > 0 ? std::to_string(bt_time) + "s" : "skipped")
+                  << ", AVL search: " << avl_time << "s" << std::endl;
+    }
+    ofs.close();
+    std::cout << "Data successfully written to: tests/" << filename << std::endl;
+}
+
+// AVLTree lookups against its frozen (Eytzinger array) snapshot for large random key sets
+static void frozen_search_performance_test(const std::string &filename, const std::vector<size_t> &sizes,
+                                           size_t queries)
+{
+    std::ofstream ofs("../tests/" + filename);
+    if (!ofs.is_open())
+    {
+        std::cerr << "Failed to open file: tests/" << filename << std::endl;
+        return;
+    }
+    std::cout << "File opened successfully: tests/" << filename << std::endl;
+
+    ofs << "size,avltree_search,frozen_search\n";
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> dist(1, 2e9);
+
+    for (size_t n : sizes)
+    {
+        std::vector<int> data(n);
+        for (size_t i = 0; i < n; ++i)
+            data[i] = dist(rng);
+
+        double avl_time, frozen_time;
+        {
+            AVLTree<int> avl(data.begin(), data.end());
+            avl_time = measure_lookups(avl, data, queries, rng);
+            FrozenTree<int> frozen = avl.freeze();
+            frozen_time = measure_lookups(frozen, data, queries, rng);
+        }
+
+        ofs << n << "," << std::fixed << std::setprecision(6) << avl_time << "," << frozen_time << "\n";
+        std::cout << "Size: " << n << ", AVL search: " << avl_time << "s"
+                  << ", frozen search: " << frozen_time << "s" << std::endl;
+    }
+    ofs.close();
+    std::cout << "Data successfully written to: tests/" << filename << std::endl;
+}
+
+// Pointer AVL tree against the static SIMD search tree at each instruction set level,
+// one lookup at a time and as one batch
+static void simd_search_performance_test(const std::string &filename, const std::vector<size_t> &sizes,
+                                         size_t queries)
+{
+    std::ofstream ofs("../tests/" + filename);
+    if (!ofs.is_open())
+    {
+        std::cerr << "Failed to open file: tests/" << filename << std::endl;
+        return;
+    }
+    std::cout << "File opened successfully: tests/" << filename << std::endl;
+
+    ofs << "size,avltree_search,stree_scalar,stree_sse2,stree_avx2,stree_batch\n";
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> dist(1, 2e9);
+
+    for (size_t n : sizes)
+    {
+        std::vector<int> data(n);
+        for (size_t i = 0; i < n; ++i)
+            data[i] = dist(rng);
+
+        double avl_time;
+        StaticSearchTree<int> scalar, sse2, avx2;
+        {
+            AVLTree<int> avl(data.begin(), data.end());
+            avl_time = measure_lookups(avl, data, queries, rng);
+            scalar = avl.freezeSimd(SimdLevel::Scalar);
+            sse2 = avl.freezeSimd(SimdLevel::SSE2);
+            avx2 = avl.freezeSimd(SimdLevel::AVX2);
+        }
+        double scalar_time = measure_lookups(scalar, data, queries, rng);
+        double sse2_time = measure_lookups(sse2, data, queries, rng);
+        double avx2_time = measure_lookups(avx2, data, queries, rng);
+
+        std::uniform_int_distribution<size_t> pick(0, n - 1);
+        std::vector<int> probes(queries);
+        for (size_t i = 0; i < queries; ++i)
+            probes[i] = (i % 2 == 0) ? data[pick(rng)] : -static_cast<int>(i) - 1;
+        auto t1 = std::chrono::high_resolution_clock::now();
+        std::vector<bool> found = avx2.hasValues(probes);
+        auto t2 = std::chrono::high_resolution_clock::now();
+        double batch_time = std::chrono::duration<double>(t2 - t1).count();
+        if (std::count(found.begin(), found.end(), true) < static_cast<long>(queries / 2))
+            std::cerr << "Batch lookup mismatch" << std::endl;
+
+        ofs << n << "," << std::fixed << std::setprecision(6) << avl_time << "," << scalar_time << ","
+            << sse2_time << "," << avx2_time << "," << batch_time << "\n";
+        std::cout << "Size: " << n << ", AVL: " << avl_time << "s"
+                  << ", S-tree scalar: " << scalar_time << "s"
+                  << ", SSE2: " << sse2_time << "s"
+                  << ", AVX2: " << avx2_time << "s"
+                  << ", batch: " << batch_time << "s" << std::endl;
+    }
+    ofs.close();
+    std::cout << "Data successfully written to: tests/" << filename << std::endl;
+}
+
+// Lookup throughput of one AVLTree in millions of keys per second, answering the
+// queries one hasValue call at a time and as hasValues calls of each batch size
+static void batch_search_performance_test(const std::string &filename, size_t n, size_t queries)
+{
+    std::ofstream ofs("../tests/" + filename);
+    if (!ofs.is_open())
+    {
+        std::cerr << "Failed to open file: tests/" << filename << std::endl;
+        return;
+    }
+    std::cout << "File opened successfully: tests/" << filename << std::endl;
+
+    ofs << "batch_size,single_mlookups_per_s,batched_mlookups_per_s\n";
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> dist(1, 2e9);
+    std::vector<int> data(n);
+    for (size_t i = 0; i < n; ++i)
+        data[i] = dist(rng);
+    AVLTree<int> avl(data.begin(), data.end());
+
+    std::uniform_int_distribution<size_t> pick(0, n - 1);
+    std::vector<int> probes(queries);
+    for (size_t i = 0; i < queries; ++i)
+        probes[i] = (i % 2 == 0) ? data[pick(rng)] : -static_cast<int>(i) - 1;
+
+    for (size_t batch : {1, 4, 16, 64, 256, 1024, 4096, 16384})
+    {
+        size_t single_found = 0, batched_found = 0;
+        auto t1 = std::chrono::high_resolution_clock::now();
+        for (int x : probes)
+            single_found += avl.hasValue(x) ? 1 : 0;
+        auto t2 = std::chrono::high_resolution_clock::now();
+        for (size_t start = 0; start < queries; start += batch)
+        {
+            std::vector<int> chunk(probes.begin() + start, probes.begin() + std::min(start + batch, queries));
+            std::vector<bool> found = avl.hasValues(chunk);
+            batched_found += std::count(found.begin(), found.end(), true);
+        }
+        auto t3 = std::chrono::high_resolution_clock::now();
+        if (single_found != batched_found)
+            std::cerr << "Batch lookup mismatch: " << batched_found << " of " << single_found << std::endl;
+
+        double single_rate = queries / std::chrono::duration<double>(t2 - t1).count() / 1e6;
+        double batched_rate = queries / std::chrono::duration<double>(t3 - t2).count() / 1e6;
+        ofs << batch << "," << std::fixed << std::setprecision(3) << single_rate << "," << batched_rate << "\n";
+        std::cout << "Batch: " << batch << ", single: " << single_rate << " M/s"
+                  << ", batched: " << batched_rate << " M/s" << std::endl;
+    }
+    ofs.close();
+    std::cout << "Data successfully written to: tests/" << filename << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+    search_performance_test("performance_search.csv", false, 1000000, 100000, 100000, 1000000);
+    search_performance_test("performance_sorted_search.csv", true, 100000, 10000, 10000, 30000);
+
+    // 100M AVL nodes need about 6 GB; pass a smaller limit on smaller machines
+    size_t frozen_limit = argc > 1 ? std::stoull(argv[1]) : 100000000;
+    std::vector<size_t> sizes;
+    for (size_t n : {1000000, 3000000, 10000000, 30000000, 100000000})
+        if (n <= frozen_limit)
+            sizes.push_back(n);
+    frozen_search_performance_test("frozen_search_performance.csv", sizes, 2000000);
+    simd_search_performance_test("simd_search_performance.csv", sizes, 2000000);
+    batch_search_performance_test("batch_search_performance.csv", std::min<size_t>(10000000, frozen_limit), 2000000);
+    return 0;
+}
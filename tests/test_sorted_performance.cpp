@@ -1,7 +1,11 @@
 #include <gtest/gtest.h>
 #include "../inc/binaryTree.hpp"
 #include "../inc/AVLTree.hpp"
+#include "../inc/redBlackTree.hpp"
+#include "../inc/WAVLTree.hpp"
+#include <algorithm>
 #include <chrono>
+#include <random>
 #include <fstream>
 #include <vector>
 #include <iomanip>
@@ -18,7 +22,7 @@ void sorted_performance_test(const std::string &filename, size_t max_size, size_
     }
     std::cout << "File opened successfully: tests/" << filename << std::endl;
 
-    ofs << "size,avltree_insert,binarytree_insert,ratio\n";
+    ofs << "size,avltree_insert,binarytree_insert,ratio,avltree_pool_insert\n";
 
     for (size_t n = step; n <= max_size; n += step)
     {
@@ -37,6 +41,14 @@ void sorted_performance_test(const std::string &filename, size_t max_size, size_
         auto t2 = std::chrono::high_resolution_clock::now();
         double avl_time = std::chrono::duration<double>(t2 - t1).count();
 
+        // То же самое с узлами из пула
+        AVLTree<int, PoolNodeAllocator<int>> avl_pool;
+        t1 = std::chrono::high_resolution_clock::now();
+        for (int x : data)
+            avl_pool.insert(x);
+        t2 = std::chrono::high_resolution_clock::now();
+        double avl_pool_time = std::chrono::duration<double>(t2 - t1).count();
+
         // Для больших размеров ограничиваем тестирование обычного дерева
         double bt_time = 0.0;
         double ratio = 0.0;
@@ -61,10 +73,11 @@ void sorted_performance_test(const std::string &filename, size_t max_size, size_
         }
 
         ofs << n << "," << std::fixed << std::setprecision(6)
-            << avl_time << "," << bt_time << "," << ratio << "\n";
+            << avl_time << "," << bt_time << "," << ratio << "," << avl_pool_time << "\n";
 
         std::cout << "Size: " << n
                   << ", AVL time: " << avl_time << "s"
+                  << ", AVL pool time: " << avl_pool_time << "s"
                   << ", BT time: " << (bt_time > 0 ? std::to_string(bt_time) + "s" : "skipped")
                   << ", Ratio: " << (ratio > 0 ? std::to_string(ratio) + "x" : "N/A")
                   << std::endl;
@@ -85,7 +98,7 @@ void reverse_sorted_performance_test(const std::string &filename, size_t max_siz
     }
     std::cout << "File opened successfully: tests/" << filename << std::endl;
 
-    ofs << "size,avltree_insert,binarytree_insert,ratio\n";
+    ofs << "size,avltree_insert,binarytree_insert,ratio,avltree_pool_insert\n";
 
     for (size_t n = step; n <= max_size; n += step)
     {
@@ -104,6 +117,14 @@ void reverse_sorted_performance_test(const std::string &filename, size_t max_siz
         auto t2 = std::chrono::high_resolution_clock::now();
         double avl_time = std::chrono::duration<double>(t2 - t1).count();
 
+        // То же самое с узлами из пула
+        AVLTree<int, PoolNodeAllocator<int>> avl_pool;
+        t1 = std::chrono::high_resolution_clock::now();
+        for (int x : data)
+            avl_pool.insert(x);
+        t2 = std::chrono::high_resolution_clock::now();
+        double avl_pool_time = std::chrono::duration<double>(t2 - t1).count();
+
         // Для больших размеров ограничиваем тестирование обычного дерева
         double bt_time = 0.0;
         double ratio = 0.0;
@@ -126,10 +147,11 @@ void reverse_sorted_performance_test(const std::string &filename, size_t max_siz
         }
 
         ofs << n << "," << std::fixed << std::setprecision(6)
-            << avl_time << "," << bt_time << "," << ratio << "\n";
+            << avl_time << "," << bt_time << "," << ratio << "," << avl_pool_time << "\n";
 
         std::cout << "Size: " << n
                   << ", AVL time: " << avl_time << "s"
+                  << ", AVL pool time: " << avl_pool_time << "s"
                   << ", BT time: " << (bt_time > 0 ? std::to_string(bt_time) + "s" : "skipped")
                   << ", Ratio: " << (ratio > 0 ? std::to_string(ratio) + "x" : "N/A")
                   << std::endl;
@@ -139,6 +161,80 @@ void reverse_sorted_performance_test(const std::string &filename, size_t max_siz
     std::cout << "Data successfully written to: tests/" << filename << std::endl;
 }
 
+struct BackendTimes
+{
+    double insert, remove;
+    int height;
+};
+
+// Вставка всех ключей, затем удаление в том же порядке
+template <typename Tree>
+BackendTimes time_backend(const std::vector<int> &data)
+{
+    BackendTimes times;
+    Tree tree;
+    auto t1 = std::chrono::high_resolution_clock::now();
+    for (int x : data)
+        tree.insert(x);
+    auto t2 = std::chrono::high_resolution_clock::now();
+    times.insert = std::chrono::duration<double>(t2 - t1).count();
+    times.height = tree.getRoot()->getHeight();
+
+    t1 = std::chrono::high_resolution_clock::now();
+    for (int x : data)
+        tree.remove(x);
+    t2 = std::chrono::high_resolution_clock::now();
+    times.remove = std::chrono::duration<double>(t2 - t1).count();
+    return times;
+}
+
+// AVL, красно-черное и WAVL-дерево на возрастающих, убывающих и случайных ключах
+void balanced_backends_performance_test(const std::string &filename, size_t max_size, size_t step)
+{
+    std::ofstream ofs("../tests/" + filename);
+    if (!ofs.is_open())
+    {
+        std::cerr << "Failed to open file: tests/" << filename << std::endl;
+        return;
+    }
+    std::cout << "File opened successfully: tests/" << filename << std::endl;
+
+    ofs << "size,order,avl_insert,rb_insert,wavl_insert,avl_remove,rb_remove,wavl_remove,"
+           "avl_height,rb_height,wavl_height\n";
+    std::mt19937 rng(42);
+
+    for (size_t n = step; n <= max_size; n += step)
+    {
+        std::vector<int> ascending(n);
+        for (size_t i = 0; i < n; ++i)
+            ascending[i] = i;
+        std::vector<int> descending(ascending.rbegin(), ascending.rend());
+        std::vector<int> shuffled = ascending;
+        std::shuffle(shuffled.begin(), shuffled.end(), rng);
+
+        const std::pair<const char *, const std::vector<int> *> orders[] = {
+            {"sorted", &ascending}, {"reverse", &descending}, {"random", &shuffled}};
+        for (const auto &order : orders)
+        {
+            BackendTimes avl = time_backend<AVLTree<int>>(*order.second);
+            BackendTimes rb = time_backend<RedBlackTree<int>>(*order.second);
+            BackendTimes wavl = time_backend<WAVLTree<int>>(*order.second);
+
+            ofs << n << "," << order.first << "," << std::fixed << std::setprecision(6)
+                << avl.insert << "," << rb.insert << "," << wavl.insert << ","
+                << avl.remove << "," << rb.remove << "," << wavl.remove << ","
+                << avl.height << "," << rb.height << "," << wavl.height << "\n";
+            std::cout << "Size: " << n << " (" << order.first << ")"
+                      << ", insert AVL/RB/WAVL: " << avl.insert << "s / " << rb.insert << "s / " << wavl.insert << "s"
+                      << ", remove: " << avl.remove << "s / " << rb.remove << "s / " << wavl.remove << "s"
+                      << ", height: " << avl.height << " / " << rb.height << " / " << wavl.height << std::endl;
+        }
+    }
+
+    ofs.close();
+    std::cout << "Data successfully written to: tests/" << filename << std::endl;
+}
+
 // Тест для больших отсортированных данных
 TEST(SortedPerformanceTest, LargeAscending)
 {
@@ -171,6 +267,13 @@ TEST(SortedPerformanceTest, SmallComparison)
     SUCCEED();
 }
 
+// Сравнение сбалансированных деревьев на разных порядках ключей
+TEST(SortedPerformanceTest, BalancedBackends)
+{
+    balanced_backends_performance_test("balanced_backends_performance.csv", 1000000, 200000);
+    SUCCEED();
+}
+
 int main(int argc, char **argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
@@ -2,6 +2,7 @@
 #include "../inc/binaryTree.hpp"
 #include <vector>
 #include <algorithm>
+#include <chrono>
 
 // Specific tests for threaded tree functionality
 TEST(ThreadedTree, InorderThreading)
@@ -142,6 +143,27 @@ TEST(ThreadedTree, ComplexStructure)
     EXPECT_EQ(result, expected);
 }
 
+TEST(ThreadedTree, ThreadBitsInLinks)
+{
+    // The thread flags live in the low bit of the links and must not leak into them
+    EXPECT_LE(sizeof(TreeNode<int>), 4 * sizeof(void *));
+    TreeNode<int> a(1), b(2), c(3);
+    b.setLeft(&a);
+    b.setRightThread(&c);
+    EXPECT_EQ(b.getLeft(), &a);
+    EXPECT_FALSE(b.hasLeftThread());
+    EXPECT_TRUE(b.hasRightThread());
+    EXPECT_EQ(b.getRight(), &c);
+    EXPECT_EQ(b.getRightThread(), &c);
+    EXPECT_EQ(b.getMax(), &b);
+
+    b.clearThreads();
+    EXPECT_FALSE(b.hasRightThread());
+    EXPECT_EQ(b.getRight(), &c);
+    b.detach();
+    EXPECT_TRUE(b.isLeaf());
+}
+
 TEST(ThreadedTree, ThreadingPerformance)
 {
     const int N = 1000;
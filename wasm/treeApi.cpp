@@ -1,6 +1,7 @@
 #include <emscripten/bind.h>
 #include <emscripten/val.h>
 #include "../inc/AVLTree.hpp"
+#include "../inc/BTree.hpp"
 #include "../inc/binaryTree.hpp"
 #include "../types/complex.hpp"
 #include "../types/person.hpp"
@@ -19,6 +20,23 @@ EMSCRIPTEN_BINDINGS(tree_types)
         .field("age", &Person::getAge, &Person::setAge);
 }
 
+// Range queries return plain JS values: the key at a bound (undefined at the end)
+// or an array with the keys of a range
+template <typename T>
+val bound_value(const BinaryTree<T> &t, typename BinaryTree<T>::ConstIterator it)
+{
+    return it != t.cend() ? val(*it) : val::undefined();
+}
+
+template <typename T>
+val range_values(const BinaryTree<T> &t, const T &lo, const T &hi)
+{
+    val out = val::array();
+    t.forEachInRange(lo, hi, [&](const T &x)
+                     { out.call<void>("push", val(x)); });
+    return out;
+}
+
 // --- INT ---
 
 // AVLTree<int>
@@ -37,6 +55,10 @@ void avl_make_threaded_int(AVLTree<int> &t, std::string order) { t.makeThreaded(
 BinaryTree<int>* avl_subtree_int(AVLTree<int> &t, int v) { return t.subtree(v); }
 bool avl_contains_subtree_int(AVLTree<int> &t, AVLTree<int> &other) { return t.containsSubtree(other); }
 BinaryTree<int>* avl_find_by_path_int(AVLTree<int> &t, std::string path) { return t.findByPath(path); }
+val avl_lower_bound_int(AVLTree<int> &t, int v) { return bound_value<int>(t, t.lowerBound(v)); }
+val avl_upper_bound_int(AVLTree<int> &t, int v) { return bound_value<int>(t, t.upperBound(v)); }
+val avl_range_int(AVLTree<int> &t, int lo, int hi) { return range_values<int>(t, lo, hi); }
+val avl_equal_range_int(AVLTree<int> &t, int v) { return range_values<int>(t, v, v); }
 AVLTree<int> *make_avl_int() { return new AVLTree<int>(); }
 
 // BinaryTree<int>
@@ -58,6 +80,7 @@ bool bin_contains_subtree_int(BinaryTree<int> &t, BinaryTree<int> &other) { retu
 BinaryTree<int>* bin_find_by_path_int(BinaryTree<int> &t, std::string path) { return t.findByPath(path); }
 
 // Functional operations for Int
+// apply and where return a temporary tree, so the heap tree takes over its nodes
 int bin_reduce_int(BinaryTree<int> &t, emscripten::val reducer, int initial) {
     return t.reduce([&](int a, int b) -> int {
         return reducer(a, b).as<int>();
@@ -78,6 +101,20 @@ BinaryTree<int>* bin_where_int(BinaryTree<int> &t, emscripten::val predicate) {
 
 BinaryTree<int> *make_bin_int() { return new BinaryTree<int>(); }
 
+// BTree<int>
+void btree_insert_int(BTree<int> &t, int v) { t.insert(v); }
+void btree_remove_int(BTree<int> &t, int v) { t.remove(v); }
+bool btree_find_int(BTree<int> &t, int v) { return t.search(v) != nullptr; }
+bool btree_has_value_int(BTree<int> &t, int v) { return t.hasValue(v); }
+std::string btree_serialize_int(BTree<int> &t, std::string order) { return t.serialize(order); }
+void btree_clear_int(BTree<int> &t) { t.clear(); }
+bool btree_empty_int(BTree<int> &t) { return t.isEmpty(); }
+int btree_height_int(BTree<int> &t) { return t.getHeight(); }
+int btree_size_int(BTree<int> &t) { return static_cast<int>(t.size()); }
+int btree_min_int(BTree<int> &t) { return t.getMin(); }
+int btree_max_int(BTree<int> &t) { return t.getMax(); }
+BTree<int> *make_btree_int() { return new BTree<int>(); }
+
 // --- COMPLEX ---
 
 void avl_insert_complex(AVLTree<Complex> &t, Complex v) { t.insert(v); }
@@ -92,6 +129,10 @@ Complex avl_min_complex(AVLTree<Complex> &t) { return t.getMin(); }
 Complex avl_max_complex(AVLTree<Complex> &t) { return t.getMax(); }
 AVLTree<Complex> *make_avl_complex() { return new AVLTree<Complex>(); }
 BinaryTree<Complex>* avl_find_by_path_complex(AVLTree<Complex> &t, std::string path) { return t.findByPath(path); }
+val avl_lower_bound_complex(AVLTree<Complex> &t, Complex v) { return bound_value<Complex>(t, t.lowerBound(v)); }
+val avl_upper_bound_complex(AVLTree<Complex> &t, Complex v) { return bound_value<Complex>(t, t.upperBound(v)); }
+val avl_range_complex(AVLTree<Complex> &t, Complex lo, Complex hi) { return range_values<Complex>(t, lo, hi); }
+val avl_equal_range_complex(AVLTree<Complex> &t, Complex v) { return range_values<Complex>(t, v, v); }
 
 void bin_insert_complex(BinaryTree<Complex> &t, Complex v) { t.insert(v, t.getRoot()); }
 void bin_remove_complex(BinaryTree<Complex> &t, Complex v) { t.remove(v); }
@@ -139,6 +180,10 @@ bool avl_isBalanced_person(AVLTree<Person> &t) { return t.isBalanced(); }
 Person avl_min_person(AVLTree<Person> &t) { return t.getMin(); }
 Person avl_max_person(AVLTree<Person> &t) { return t.getMax(); }
 BinaryTree<Person>* avl_find_by_path_person(AVLTree<Person> &t, std::string path) { return t.findByPath(path); }
+val avl_lower_bound_person(AVLTree<Person> &t, Person v) { return bound_value<Person>(t, t.lowerBound(v)); }
+val avl_upper_bound_person(AVLTree<Person> &t, Person v) { return bound_value<Person>(t, t.upperBound(v)); }
+val avl_range_person(AVLTree<Person> &t, Person lo, Person hi) { return range_values<Person>(t, lo, hi); }
+val avl_equal_range_person(AVLTree<Person> &t, Person v) { return range_values<Person>(t, v, v); }
 AVLTree<Person> *make_avl_person() { return new AVLTree<Person>(); }
 
 void bin_insert_person(BinaryTree<Person> &t, Person v) { t.insert(v, t.getRoot()); }
@@ -242,7 +287,11 @@ EMSCRIPTEN_BINDINGS(tree_module)
         .function("getMax", &avl_max_int)
         .function("makeThreaded", &avl_make_threaded_int)
         .function("containsSubtree", &avl_contains_subtree_int)
-        .function("findByPath", &avl_find_by_path_int, allow_raw_pointers());
+        .function("findByPath", &avl_find_by_path_int, allow_raw_pointers())
+        .function("lowerBound", &avl_lower_bound_int)
+        .function("upperBound", &avl_upper_bound_int)
+        .function("range", &avl_range_int)
+        .function("equalRange", &avl_equal_range_int);
     function("make_avl_int", &make_avl_int, allow_raw_pointers());
     function("subtree_avl_int", &avl_subtree_int, allow_raw_pointers());
 
@@ -268,6 +317,22 @@ EMSCRIPTEN_BINDINGS(tree_module)
         .function("apply", &bin_apply_int, allow_raw_pointers())
         .function("where", &bin_where_int, allow_raw_pointers());
     function("make_bin_int", &make_bin_int, allow_raw_pointers());
+
+    // BTree<int>
+    class_<BTree<int>>("BTreeInt")
+        .constructor<>()
+        .function("insert", &btree_insert_int)
+        .function("remove", &btree_remove_int)
+        .function("find", &btree_find_int)
+        .function("hasValue", &btree_has_value_int)
+        .function("serialize", &btree_serialize_int)
+        .function("clear", &btree_clear_int)
+        .function("empty", &btree_empty_int)
+        .function("height", &btree_height_int)
+        .function("size", &btree_size_int)
+        .function("getMin", &btree_min_int)
+        .function("getMax", &btree_max_int);
+    function("make_btree_int", &make_btree_int, allow_raw_pointers());
     function("subtree_int", &bin_subtree_int, allow_raw_pointers());
 
     // AVLTree<Complex>
@@ -283,7 +348,11 @@ EMSCRIPTEN_BINDINGS(tree_module)
         .function("isBalanced", &avl_isBalanced_complex)
         .function("getMin", &avl_min_complex)
         .function("getMax", &avl_max_complex)
-        .function("findByPath", &avl_find_by_path_complex, allow_raw_pointers());
+        .function("findByPath", &avl_find_by_path_complex, allow_raw_pointers())
+        .function("lowerBound", &avl_lower_bound_complex)
+        .function("upperBound", &avl_upper_bound_complex)
+        .function("range", &avl_range_complex)
+        .function("equalRange", &avl_equal_range_complex);
     function("make_avl_complex", &make_avl_complex, allow_raw_pointers());
 
     // BinaryTree<Complex>
@@ -317,7 +386,11 @@ EMSCRIPTEN_BINDINGS(tree_module)
         .function("isBalanced", &avl_isBalanced_person)
         .function("getMin", &avl_min_person)
         .function("getMax", &avl_max_person)
-        .function("findByPath", &avl_find_by_path_person, allow_raw_pointers());
+        .function("findByPath", &avl_find_by_path_person, allow_raw_pointers())
+        .function("lowerBound", &avl_lower_bound_person)
+        .function("upperBound", &avl_upper_bound_person)
+        .function("range", &avl_range_person)
+        .function("equalRange", &avl_equal_range_person);
     function("make_avl_person", &make_avl_person, allow_raw_pointers());
 
     // BinaryTree<Person>